@@ -0,0 +1,138 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "animation.h"
+
+const uint8_t palette_off[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+const uint8_t palette_white[8] = {0, 1, 1, 1, 1, 1, 1, 1};
+
+// cells outside the inner 2x2 / 4x4 square
+#define OUTSIDE_INNER (ALL_CELLS_MASK & ~(0x3ull << 14) & ~(0x3ull << 20))
+#define OUTSIDE_MIDDLE (ALL_CELLS_MASK & ~(0xFull << 7) & ~(0xFull << 13) & ~(0xFull << 19) & ~(0xFull << 25))
+
+// dark, then the board grows from the centre and is held
+const Keyframe finish_sweep[] = {
+    {150, ALL_CELLS_MASK, palette_off},
+    {150, OUTSIDE_INNER, palette_off},
+    {150, OUTSIDE_MIDDLE, palette_off},
+    {400, 0, palette_off},
+};
+const size_t finish_sweep_len = sizeof(finish_sweep) / sizeof(finish_sweep[0]);
+
+// all dots white, so the new brightness is judged on one colour
+const Keyframe brightness_preview[] = {
+    {300, ALL_CELLS_MASK, palette_white},
+};
+const size_t brightness_preview_len = sizeof(brightness_preview) / sizeof(brightness_preview[0]);
+
+Animator::Animator()
+{
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++)
+    {
+        this->tracks[layer] = {nullptr, 0, 0, false, 0};
+    }
+}
+
+void Animator::start(AnimationLayer layer, const Keyframe *keyframes, size_t count, bool loop, uint32_t now_ms)
+{
+    this->tracks[layer] = {keyframes, count, 0, loop, now_ms};
+}
+
+void Animator::stop(AnimationLayer layer)
+{
+    this->tracks[layer].keyframes = nullptr;
+}
+
+bool Animator::active(AnimationLayer layer)
+{
+    return this->tracks[layer].keyframes != nullptr;
+}
+
+bool Animator::tick(uint32_t now_ms)
+{
+    bool changed = false;
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++)
+    {
+        Track &track = this->tracks[layer];
+        // catch up on every keyframe that ended since the last tick
+        while ((track.keyframes != nullptr) &&
+               (now_ms - track.frame_start_ms >= track.keyframes[track.index].duration_ms))
+        {
+            track.frame_start_ms += track.keyframes[track.index].duration_ms;
+            track.index++;
+            if (track.index == track.count)
+            {
+                track.index = 0;
+                if (track.loop == false)
+                {
+                    track.keyframes = nullptr;
+                }
+            }
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+bool Animator::next_change(uint32_t now_ms, uint32_t &change_ms)
+{
+    bool active = false;
+    uint32_t earliest = 0;
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++)
+    {
+        const Track &track = this->tracks[layer];
+        if (track.keyframes == nullptr)
+        {
+            continue;
+        }
+        // compared as distances from now, the clock wraps around
+        uint32_t change = track.frame_start_ms + track.keyframes[track.index].duration_ms;
+        if ((active == false) || (change - now_ms < earliest - now_ms))
+        {
+            earliest = change;
+        }
+        active = true;
+    }
+    change_ms = earliest;
+    return active;
+}
+
+void Animator::compose(const Board base, Board frame)
+{
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        frame[i / 6][i % 6] = base[i / 6][i % 6];
+    }
+    for (uint8_t layer = 0; layer < NUM_LAYERS; layer++)
+    {
+        const Track &track = this->tracks[layer];
+        if (track.keyframes == nullptr)
+        {
+            continue;
+        }
+        const Keyframe &keyframe = track.keyframes[track.index];
+        for (uint8_t i = 0; i < 36; i++)
+        {
+            if ((keyframe.mask >> i) & 1)
+            {
+                frame[i / 6][i % 6] = keyframe.palette[frame[i / 6][i % 6]];
+            }
+        }
+    }
+}
@@ -0,0 +1,86 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "board.h"
+
+// Step of an effect: for duration_ms the cells in mask show palette[colour]
+// instead of what the layers below show.
+struct Keyframe
+{
+  uint16_t duration_ms;
+  uint64_t mask;
+  const uint8_t *palette;
+};
+
+// palettes for Keyframe, indexed by board colour
+extern const uint8_t palette_off[8];
+extern const uint8_t palette_white[8];
+
+// effect tables
+extern const Keyframe finish_sweep[];
+extern const size_t finish_sweep_len;
+extern const Keyframe brightness_preview[];
+extern const size_t brightness_preview_len;
+
+// Overlay layers, later ones are composited on top of earlier ones
+enum AnimationLayer
+{
+  LAYER_FINISH,
+  LAYER_HINT,
+  LAYER_BRIGHTNESS,
+  NUM_LAYERS
+};
+
+// Plays keyframe tables on overlay layers over the board. Time is passed in
+// by the caller, so the animator never blocks and runs against a virtual
+// clock on the host.
+class Animator
+{
+public:
+  Animator();
+  void start(AnimationLayer layer, const Keyframe *keyframes, size_t count, bool loop, uint32_t now_ms);
+  void stop(AnimationLayer layer);
+  bool active(AnimationLayer layer);
+  // advances all layers to now_ms, true if the composited frame changed
+  bool tick(uint32_t now_ms);
+  // false if no layer is active, else the time of the next keyframe change,
+  // valid after tick(now_ms)
+  bool next_change(uint32_t now_ms, uint32_t &change_ms);
+  // board colours with the current keyframe of every active layer applied
+  void compose(const Board base, Board frame);
+
+private:
+  struct Track
+  {
+    const Keyframe *keyframes;
+    size_t count;
+    size_t index;
+    bool loop;
+    uint32_t frame_start_ms;
+  };
+  Track tracks[NUM_LAYERS];
+};
+
+#endif // ANIMATION_H
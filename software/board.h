@@ -0,0 +1,77 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <cstdint>
+
+typedef uint8_t Board[6][6];
+
+// cell masks, one bit per board cell at 6 * row + col
+#define ROW_MASK(row) (0x3Full << (6 * (row)))
+#define COL_MASK(col) (0x041041041ull << (col))
+#define ALL_CELLS_MASK 0xFFFFFFFFFull
+
+// 3 bits per cell, rows 0..2 in lo and rows 3..5 in hi
+struct PackedBoard
+{
+  uint64_t lo;
+  uint64_t hi;
+
+  bool operator==(const PackedBoard &other) const
+  {
+    return (lo == other.lo) && (hi == other.hi);
+  }
+};
+
+inline PackedBoard pack_board(const Board maze)
+{
+  PackedBoard packed = {0, 0};
+  for (uint8_t i = 0; i < 18; i++)
+  {
+    packed.lo |= (uint64_t)maze[i / 6][i % 6] << (3 * i);
+    packed.hi |= (uint64_t)maze[3 + i / 6][i % 6] << (3 * i);
+  }
+  return packed;
+}
+
+inline void unpack_board(const PackedBoard &packed, Board maze)
+{
+  for (uint8_t i = 0; i < 18; i++)
+  {
+    maze[i / 6][i % 6] = (packed.lo >> (3 * i)) & 0x7;
+    maze[3 + i / 6][i % 6] = (packed.hi >> (3 * i)) & 0x7;
+  }
+}
+
+// 64 bit mix of both halves (murmur3 finalizer), seed selects an independent hash function
+inline uint64_t hash_board(const PackedBoard &packed, uint64_t seed)
+{
+  uint64_t h = packed.lo ^ (seed * 0x9E3779B97F4A7C15ull);
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDull;
+  h ^= packed.hi + (h >> 29);
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+#endif // BOARD_H
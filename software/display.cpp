@@ -19,6 +19,8 @@
 
 #include "display.h"
 
+#include "hardware/clocks.h"
+
 struct RGB {
     uint8_t r, g, b;
 };
@@ -77,7 +79,7 @@ Display::Display(uint8_t brightness)
 }
 
 void Display::update_brightness(uint8_t brightness){
-    this->ColorMap[0] = 0;
+    this->renderer.set_palette(0, 0);
     
     HSV hsv;
     hsv.v = float(brightness)/255.0;
@@ -85,23 +87,23 @@ void Display::update_brightness(uint8_t brightness){
     hsv.h = 0; // red
     hsv.s = 0;
     RGB rgb = hsv2rgb(hsv);
-    this->ColorMap[1] = urgb_u32(rgb.r, rgb.g, rgb.b);    // white
+    this->renderer.set_palette(1, urgb_u32(rgb.r, rgb.g, rgb.b));    // white
 
     hsv.s = 1;
     rgb = hsv2rgb(hsv);
-    this->ColorMap[2] = urgb_u32(rgb.r, rgb.g, rgb.b); 
+    this->renderer.set_palette(2, urgb_u32(rgb.r, rgb.g, rgb.b)); 
 
     hsv.h = 120;  // green
     rgb = hsv2rgb(hsv);
-    this->ColorMap[3] = urgb_u32(rgb.r, rgb.g, rgb.b);  
+    this->renderer.set_palette(3, urgb_u32(rgb.r, rgb.g, rgb.b));  
 
     hsv.h = 60;  // yellow
     rgb = hsv2rgb(hsv);
-    this->ColorMap[4] = urgb_u32(rgb.r, rgb.g, rgb.b);
+    this->renderer.set_palette(4, urgb_u32(rgb.r, rgb.g, rgb.b));
 
     hsv.h = 240;  // blue
     rgb = hsv2rgb(hsv);
-    this->ColorMap[5] = urgb_u32(rgb.r, rgb.g, rgb.b);
+    this->renderer.set_palette(5, urgb_u32(rgb.r, rgb.g, rgb.b));
 }
 
 
@@ -116,130 +118,52 @@ void Display::off()
     {
         put_pixel(0);
     }
+    this->renderer.invalidate();
 }
 
-void Display::push_leds()
+void Display::drain()
 {
-    for (uint8_t i = 0; i < NUM_PIXELS; i++)
+    // the state machine stalls on an empty FIFO once the last bit is out
+    uint32_t stall = 1u << (PIO_FDEBUG_TXSTALL_LSB + 0);
+    pio0->fdebug = stall;
+    while ((pio0->fdebug & stall) == 0)
     {
-        put_pixel(this->ColorMap[this->pix_array[i]]);
+        tight_loop_contents();
     }
 }
 
-uint32_t Display::urgb_u32(uint8_t r, uint8_t g, uint8_t b)
+void Display::retime()
 {
-    return ((uint32_t)(r) << 8) |
-           ((uint32_t)(g) << 16) |
-           (uint32_t)(b);
+    int cycles_per_bit = ws2812_T1 + ws2812_T2 + ws2812_T3;
+    pio_sm_set_clkdiv(pio0, 0, clock_get_hz(clk_sys) / (float(WS2812_FREQ) * cycles_per_bit));
 }
 
-void Display::serialize_maze(uint8_t maze[6][6], uint8_t maze_mask[6][6])
+void Display::push_leds()
 {
-    uint8_t mask[6][6] = {
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1}};
-    if (maze_mask != nullptr)
-    {
-        for (uint8_t i = 0; i < 6; ++i)
-        {
-            for (uint8_t j = 0; j < 6; ++j)
-            {
-                mask[i][j] = maze_mask[i][j];
-            }
-        }
-    }
-    for (uint8_t i = 0; i < 4; i++)
+    if (this->renderer.dirty() == false)
     {
-        this->pix_array[i] = maze[0][i + 1] * mask[0][i + 1];
+        return;
     }
-    for (uint8_t i = 0; i < 6; i++)
-    {
-        this->pix_array[i + 4] = maze[1][5 - i] * mask[1][5 - i];
-    }
-    for (uint8_t i = 0; i < 6; i++)
-    {
-        this->pix_array[i + 10] = maze[2][i] * mask[2][i];
-    }
-    for (uint8_t i = 0; i < 6; i++)
-    {
-        this->pix_array[i + 16] = maze[3][5 - i] * mask[3][5 - i];
-    }
-    for (uint8_t i = 0; i < 6; i++)
-    {
-        this->pix_array[i + 22] = maze[4][i] * mask[4][i];
-    }
-    for (uint8_t i = 0; i < 4; i++)
+    const uint32_t *words = this->renderer.take_words();
+    for (uint8_t i = 0; i < NUM_PIXELS; i++)
     {
-        this->pix_array[i + 28] = maze[5][4 - i] * mask[5][4 - i];
+        put_pixel(words[i]);
     }
 }
 
-void Display::serialize_maze_inner(uint8_t maze[6][6])
+uint32_t Display::urgb_u32(uint8_t r, uint8_t g, uint8_t b)
 {
-    uint8_t maze_mask[6][6] = {0};
-
-    for (uint8_t i = 2; i < 4; ++i)
-    {
-        for (uint8_t j = 2; j < 4; ++j)
-        {
-            maze_mask[i][j] = 1;
-        }
-    }
-
-    this->serialize_maze(maze, maze_mask);
+    return ((uint32_t)(r) << 8) |
+           ((uint32_t)(g) << 16) |
+           (uint32_t)(b);
 }
 
-void Display::serialize_maze_middle(uint8_t maze[6][6])
+void Display::serialize_maze(const Board maze, uint64_t maze_mask)
 {
-    uint8_t maze_mask[6][6] = {0};
-
-    for (uint8_t i = 1; i < 5; ++i)
-    {
-        for (uint8_t j = 1; j < 5; ++j)
-        {
-            maze_mask[i][j] = 1;
-        }
-    }
-
-    this->serialize_maze(maze, maze_mask);
+    this->renderer.render(maze, maze_mask);
 }
 
-void Display::serialize_maze_hide_row(uint8_t maze[6][6], uint8_t row)
+uint32_t Display::diff(const Board maze, uint64_t maze_mask)
 {
-    uint8_t maze_mask[6][6] = {
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1}};
-
-    for (uint8_t i = 0; i < 6; ++i)
-    {
-        maze_mask[row][i] = 0;
-    }
-
-    this->serialize_maze(maze, maze_mask);
+    return this->renderer.diff(maze, maze_mask);
 }
-
-void Display::serialize_maze_hide_col(uint8_t maze[6][6], uint8_t col)
-{
-    uint8_t maze_mask[6][6] = {
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1}};
-
-    for (uint8_t i = 0; i < 6; ++i)
-    {
-        maze_mask[i][col] = 0;
-    }
-
-    this->serialize_maze(maze, maze_mask);
-}
\ No newline at end of file
@@ -21,31 +21,35 @@
 #define DISPLAY_H
 
 #define IS_RGBW false
-#define NUM_PIXELS 32
 #define WS2812_PIN 26
+#define WS2812_FREQ 800000
 
 #include "pico/stdlib.h"
-#include <map>
 #include "include/ws2812.h"
 
+#include "board.h"
+#include "renderer.h"
+
 class Display
 {
 public:
   Display(uint8_t brightness);
   void off();
+  // sends the chain only if a pixel changed since the last push
   void push_leds();
-  void serialize_maze(uint8_t maze[6][6], uint8_t maze_mask[6][6] = nullptr);
-  void serialize_maze_inner(uint8_t maze[6][6]);
-  void serialize_maze_middle(uint8_t maze[6][6]);
-  void serialize_maze_hide_col(uint8_t maze[6][6], uint8_t col);
-  void serialize_maze_hide_row(uint8_t maze[6][6], uint8_t row);
+  void serialize_maze(const Board maze, uint64_t maze_mask = ALL_CELLS_MASK);
+  // pixels serialize_maze would change, bit i for pixel i
+  uint32_t diff(const Board maze, uint64_t maze_mask = ALL_CELLS_MASK);
   void update_brightness(uint8_t brightness);
-  uint8_t pix_array[32];
+  // waits until the chain is sent, call around clk_sys changes
+  void drain();
+  // adapts the PIO clock divider to the current clk_sys
+  void retime();
 
 private:
-  std::map<uint8_t, uint32_t> ColorMap;
+  Renderer renderer;
   void put_pixel(uint32_t pixel_grb);
   uint32_t urgb_u32(uint8_t r, uint8_t g, uint8_t b);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -18,39 +18,58 @@
  */
 
 #include "game.h"
-#include "GpioMap.h"
 
-#include "pico/stdlib.h"
 #include <stdlib.h>
 #include <cstdint>
 
-Game::Game()
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+BasicGame<Rows, Cols, Colors>::BasicGame()
 {
     this->init();
 }
 
-void Game::init()
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::init()
 {
-    for (uint8_t i = 0; i < 6; i++)
+    for (uint8_t i = 0; i < HEIGHT; i++)
     {
-        for (uint8_t j = 0; j < 6; j++)
+        for (uint8_t j = 0; j < WIDTH; j++)
         {
-            this->maze[i][j] = this->solution[i][j];
+            this->maze[i][j] = tables.solution[i][j];
         }
     }
-    for (uint8_t i = 0; i < 8; i++) {
+    for (uint8_t i = 0; i < NUM_SWITCHES; i++) {
         this->switches[i] = 0;
     }
 }
 
-bool Game::check_finish()
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::load(const uint8_t maze[HEIGHT][WIDTH])
+{
+    for (uint8_t i = 0; i < HEIGHT; i++)
+    {
+        for (uint8_t j = 0; j < WIDTH; j++)
+        {
+            this->maze[i][j] = maze[i][j];
+        }
+    }
+    // the switch position follows from the empty border cell of its row / column,
+    // the first cell of its line
+    for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
+    {
+        this->switches[sw] = ((&this->maze[0][0])[tables.line_start[sw]] == 0);
+    }
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+bool BasicGame<Rows, Cols, Colors>::check_finish()
 {
     bool finish = true;
-    for (uint8_t i = 0; i < 6; i++)
+    for (uint8_t i = 0; i < HEIGHT; i++)
     {
-        for (uint8_t j = 0; j < 6; j++)
+        for (uint8_t j = 0; j < WIDTH; j++)
         {
-            if (this->maze[i][j] != this->solution[i][j])
+            if (this->maze[i][j] != tables.solution[i][j])
             {
                 finish = false;
             }
@@ -59,48 +78,125 @@ bool Game::check_finish()
     return finish;
 }
 
-void Game::shiftRowRight(uint8_t row)
+template <uint8_t Rows>
+uint8_t line_cover_bound(uint16_t forced, uint16_t switched, const uint8_t (&cells)[Rows])
 {
-    for (uint8_t i = 5; i > 0; i--)
+    // switched lines move anyway, the cells on them and on forced lines are covered
+    uint16_t moving = forced | switched;
+    uint8_t uncovered[Rows];
+    for (uint8_t row = 0; row < Rows; row++)
+    {
+        uncovered[row] = ((moving >> row) & 1) ? 0 : cells[row] & ~(moving >> Rows);
+    }
+    // the other cells need a minimum vertex cover of rows and columns: some
+    // of the rows, and the columns of the cells in all others
+    uint8_t cover = Rows;
+    for (uint16_t rows = 0; rows < (1 << Rows); rows++)
+    {
+        uint8_t cols = 0;
+        for (uint8_t row = 0; row < Rows; row++)
+        {
+            if (((rows >> row) & 1) == 0)
+            {
+                cols |= uncovered[row];
+            }
+        }
+        uint8_t count = __builtin_popcount(rows) + __builtin_popcount(cols);
+        cover = count < cover ? count : cover;
+    }
+    return __builtin_popcount(switched) + 2 * __builtin_popcount(forced & ~switched) + 2 * cover;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+uint8_t BasicGame<Rows, Cols, Colors>::moves_lower_bound()
+{
+    uint16_t forced = 0;
+    uint16_t switched = 0;
+    uint8_t cells[Rows] = {};
+    for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
+    {
+        switched |= this->switches[sw] << sw;
+    }
+    for (uint8_t i = 0; i < HEIGHT; i++)
+    {
+        for (uint8_t j = 0; j < WIDTH; j++)
+        {
+            if (this->maze[i][j] == tables.solution[i][j])
+            {
+                continue;
+            }
+            bool border_row = (i == 0) || (i == HEIGHT - 1);
+            bool border_col = (j == 0) || (j == WIDTH - 1);
+            if (border_row && border_col)
+            {
+                continue; // corners never move
+            }
+            if (border_row == true)
+            {
+                forced |= 1 << (Rows + j - 1);
+            }
+            else if (border_col == true)
+            {
+                forced |= 1 << (i - 1);
+            }
+            else
+            {
+                cells[i - 1] |= 1 << (j - 1);
+            }
+        }
+    }
+    return line_cover_bound(forced, switched, cells);
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::shiftRowRight(uint8_t row)
+{
+    for (uint8_t i = WIDTH - 1; i > 0; i--)
     {
         this->maze[row][i] = this->maze[row][i - 1];
     }
     this->maze[row][0] = 0;
 }
 
-void Game::shiftRowLeft(uint8_t row)
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::shiftRowLeft(uint8_t row)
 {
-    for (uint8_t i = 0; i < 5; i++)
+    for (uint8_t i = 0; i < WIDTH - 1; i++)
     {
         this->maze[row][i] = this->maze[row][i + 1];
     }
-    this->maze[row][5] = 0;
+    this->maze[row][WIDTH - 1] = 0;
 }
 
-void Game::shiftColDown(uint8_t col)
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::shiftColDown(uint8_t col)
 {
-    for (uint8_t i = 5; i > 0; i--)
+    for (uint8_t i = HEIGHT - 1; i > 0; i--)
     {
         this->maze[i][col] = this->maze[i - 1][col];
     }
     this->maze[0][col] = 0;
 }
 
-void Game::shiftColUp(uint8_t col)
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::shiftColUp(uint8_t col)
 {
-    for (uint8_t i = 0; i < 5; i++)
+    for (uint8_t i = 0; i < HEIGHT - 1; i++)
     {
         this->maze[i][col] = this->maze[i + 1][col];
     }
-    this->maze[5][col] = 0;
+    this->maze[HEIGHT - 1][col] = 0;
 }
 
-void Game::toggle_switch(uint8_t sw)
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::toggle_switch(uint8_t sw)
 {
-    if (sw < 4)
+    // row lines start in column 0, column lines in row 0
+    uint8_t start = tables.line_start[sw];
+    uint8_t status = this->switches[sw];
+    if (sw < Rows)
     { // row
-        uint8_t row = 1 + sw;
-        uint8_t status = this->switches[sw];
+        uint8_t row = start / WIDTH;
         if (status == 0)
         { // shift right
             this->shiftRowRight(row);
@@ -109,12 +205,10 @@ void Game::toggle_switch(uint8_t sw)
         { // shift left
             this->shiftRowLeft(row);
         }
-        this->switches[sw] ^= 1;
     }
     else
     { // column
-        uint8_t col = sw - 3;
-        uint8_t status = this->switches[sw];
+        uint8_t col = start;
         if (status == 0)
         { // shift down
             this->shiftColDown(col);
@@ -123,11 +217,12 @@ void Game::toggle_switch(uint8_t sw)
         { // shift up
             this->shiftColUp(col);
         }
-        this->switches[sw] ^= 1;
     }
+    this->switches[sw] ^= 1;
 }
 
-void Game::shuffle_dots(uint8_t level, uint32_t seed)
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+void BasicGame<Rows, Cols, Colors>::shuffle_dots(uint8_t level, uint32_t seed, const uint8_t switch_state[NUM_SWITCHES])
 {
     uint16_t level2steps[8] = {3, 6, 10, 15, 25, 50, 100, 500};
     uint16_t steps = level2steps[level];
@@ -145,7 +240,7 @@ void Game::shuffle_dots(uint8_t level, uint32_t seed)
 
         while (steps > 0)
         {
-            sw = rand() % 8;
+            sw = rand() % NUM_SWITCHES;
             if (sw != last_sw)
             {
                 this->toggle_switch(sw);
@@ -155,18 +250,13 @@ void Game::shuffle_dots(uint8_t level, uint32_t seed)
         }
 
         // correct switch position
-        for (int8_t gpio = 18; gpio < 22; gpio++)
+        this->scramble_moves = level2steps[level];
+        for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
         {
-            if (this->switches[GpioMap[gpio]] != gpio_get(gpio))
+            if (this->switches[sw] != switch_state[sw])
             {
-                this->toggle_switch(GpioMap[gpio]);
-            }
-        }
-        for (uint8_t gpio = 22; gpio < 26; gpio++)
-        {
-            if (this->switches[GpioMap[gpio]] == gpio_get(gpio))
-            {
-                this->toggle_switch(GpioMap[gpio]);
+                this->toggle_switch(sw);
+                this->scramble_moves++;
             }
         }
         if (this->check_finish() != true)
@@ -175,3 +265,10 @@ void Game::shuffle_dots(uint8_t level, uint32_t seed)
         }
     }
 }
+
+// the device board and the larger variants of the host tools
+template class BasicGame<3, 3, 6>;
+template class BasicGame<4, 4, 6>;
+template class BasicGame<5, 5, 6>;
+template class BasicGame<6, 6, 6>;
+template uint8_t line_cover_bound<4>(uint16_t forced, uint16_t switched, const uint8_t (&cells)[4]);
@@ -22,30 +22,132 @@
 
 #include <cstdint>
 
-class Game
+// Lower bound of the moves that fix a board with a Rows x N playfield. The
+// lines a move shifts are rows 1..Rows in bits 0..Rows-1 and columns 1..N
+// from bit Rows on. Every misplaced cell needs a move of its row or column; a
+// misplaced border cell only moves with one line, which is forced. A switched
+// line moves an odd number of times, any other line that moves does so at
+// least twice to return its switch. cells[r] holds the misplaced inner cells
+// of row 1 + r, columns 1..N in bits 0..N-1.
+template <uint8_t Rows>
+uint8_t line_cover_bound(uint16_t forced, uint16_t switched, const uint8_t (&cells)[Rows]);
+
+// Tables of a board with a Rows x Cols playfield inside a one cell border,
+// generated at compile time by make_game_tables().
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+struct GameTables
+{
+  // dots of colour 1 on the top and left border, the playfield split into
+  // blocks of colours 2..Colors-1, the bottom and right border empty
+  uint8_t solution[Rows + 2][Cols + 2];
+  // first cell ((Cols + 2) * row + col) of the line a switch shifts, switches
+  // 0..Rows-1 shift rows 1..Rows, the others columns 1..Cols
+  uint8_t line_start[Rows + Cols];
+  // board cell of every pixel, the chain runs in a serpentine from the top
+  // border over the rows to the bottom border
+  uint8_t pixel_cell[2 * Cols + Rows * (Cols + 2)];
+};
+
+// rows of the block grid, the largest divisor of blocks up to its square root
+constexpr uint8_t solution_block_rows(uint8_t blocks)
+{
+  uint8_t rows = 1;
+  for (uint8_t d = 2; d * d <= blocks; d++)
+  {
+    if (blocks % d == 0)
+    {
+      rows = d;
+    }
+  }
+  return rows;
+}
+
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+constexpr GameTables<Rows, Cols, Colors> make_game_tables()
+{
+  GameTables<Rows, Cols, Colors> tables = {};
+  const uint8_t width = Cols + 2;
+  const uint8_t block_rows = solution_block_rows(Colors - 2);
+  const uint8_t block_cols = (Colors - 2) / block_rows;
+  for (uint8_t i = 1; i <= Rows; i++)
+  {
+    tables.solution[i][0] = 1;
+    for (uint8_t j = 1; j <= Cols; j++)
+    {
+      tables.solution[i][j] = 2 + ((i - 1) * block_rows / Rows) * block_cols + (j - 1) * block_cols / Cols;
+    }
+  }
+  for (uint8_t j = 1; j <= Cols; j++)
+  {
+    tables.solution[0][j] = 1;
+  }
+
+  for (uint8_t sw = 0; sw < Rows; sw++)
+  {
+    tables.line_start[sw] = width * (1 + sw);
+  }
+  for (uint8_t sw = Rows; sw < Rows + Cols; sw++)
+  {
+    tables.line_start[sw] = 1 + sw - Rows;
+  }
+
+  // odd rows run right to left, the border rows skip their corners
+  uint8_t pixel = 0;
+  for (uint8_t i = 0; i < Rows + 2; i++)
+  {
+    bool border = (i == 0) || (i == Rows + 1);
+    uint8_t first = border ? 1 : 0;
+    uint8_t count = border ? Cols : width;
+    for (uint8_t k = 0; k < count; k++)
+    {
+      uint8_t j = (i & 1) ? first + count - 1 - k : first + k;
+      tables.pixel_cell[pixel++] = width * i + j;
+    }
+  }
+  return tables;
+}
+
+// Game on a Rows x Cols playfield with dots of Colors - 2 colours, the cell
+// values 0 (empty) and 1 (border dot) included in Colors. Every size uses the
+// same code with its own compile-time tables, game.cpp instantiates the
+// variants in use. Game is the 4 x 4 board of the device.
+template <uint8_t Rows, uint8_t Cols, uint8_t Colors>
+class BasicGame
 {
 public:
-  Game();
+  static_assert((Rows >= 2) && (Rows <= 8) && (Cols >= 2) && (Cols <= 8), "cells and lines are bit masks");
+  static_assert((Colors >= 3) && (Colors <= 8), "boards pack 3 bits per cell");
+
+  static constexpr uint8_t HEIGHT = Rows + 2;
+  static constexpr uint8_t WIDTH = Cols + 2;
+  static constexpr uint8_t NUM_SWITCHES = Rows + Cols;
+  static constexpr GameTables<Rows, Cols, Colors> tables = make_game_tables<Rows, Cols, Colors>();
+
+  BasicGame();
   void init();
   void toggle_switch(uint8_t sw);
   bool check_finish();
-  void shuffle_dots(uint8_t level, uint32_t seed);
-  uint8_t switches[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t maze[6][6];
+  // fewest moves that can solve the board, see line_cover_bound()
+  uint8_t moves_lower_bound();
+  void load(const uint8_t maze[HEIGHT][WIDTH]);
+  void shuffle_dots(uint8_t level, uint32_t seed, const uint8_t switch_state[NUM_SWITCHES]);
+  uint8_t switches[NUM_SWITCHES] = {};
+  // random moves of the last shuffle, an upper bound of the optimal solution
+  uint16_t scramble_moves = 0;
+  uint8_t maze[HEIGHT][WIDTH];
 
 private:
-  uint8_t solution[6][6] = {
-      {0, 1, 1, 1, 1, 0},
-      {1, 2, 2, 3, 3, 0},
-      {1, 2, 2, 3, 3, 0},
-      {1, 4, 4, 5, 5, 0},
-      {1, 4, 4, 5, 5, 0},
-      {0, 0, 0, 0, 0, 0}};
-
   void shiftRowRight(uint8_t row);
   void shiftRowLeft(uint8_t row);
   void shiftColDown(uint8_t col);
   void shiftColUp(uint8_t col);
 };
 
+extern template class BasicGame<3, 3, 6>;
+extern template class BasicGame<4, 4, 6>;
+extern template class BasicGame<5, 5, 6>;
+extern template class BasicGame<6, 6, 6>;
+
+typedef BasicGame<4, 4, 6> Game;
+
 #endif // GAME_H
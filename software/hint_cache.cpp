@@ -0,0 +1,116 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "hint_cache.h"
+#include "game.h"
+#include "symmetry.h"
+
+int32_t hint_cache_index(const HintCacheTable &table, const PackedBoard &packed)
+{
+    uint32_t offset = 0;
+
+    for (uint8_t level = 0; level < table.levels; level++)
+    {
+        uint32_t words = table.level_words[level];
+        if (words == 0)
+        {
+            continue;
+        }
+        uint32_t pos = (uint32_t)hash_board(packed, level) % (words * 32);
+        uint32_t word = offset + pos / 32;
+        uint32_t bit = pos % 32;
+
+        if ((table.bits[word] >> bit) & 1)
+        {
+            // rank of the bit within all levels is the slot
+            uint32_t block = word / HINT_CACHE_BLOCK_WORDS;
+            uint32_t slot = table.rank[block];
+            for (uint32_t i = block * HINT_CACHE_BLOCK_WORDS; i < word; i++)
+            {
+                slot += __builtin_popcount(table.bits[i]);
+            }
+            slot += __builtin_popcount(table.bits[word] & ((1u << bit) - 1));
+            return slot;
+        }
+        offset += words;
+    }
+    return -1;
+}
+
+HintCache::HintCache(const HintCacheTable &table) : table(table)
+{
+}
+
+uint8_t HintCache::depth()
+{
+    return this->table.depth;
+}
+
+int8_t HintCache::lookup(const Board maze)
+{
+    int8_t hint_switch = -1;
+    this->follow(maze, hint_switch);
+    return hint_switch;
+}
+
+int8_t HintCache::distance(const Board maze)
+{
+    int8_t hint_switch = -1;
+    return this->follow(maze, hint_switch);
+}
+
+int8_t HintCache::follow(const Board maze, int8_t &first_switch)
+{
+    Game game = Game();
+    game.load(maze);
+
+    // Boards further away hash to arbitrary slots. Following the stored moves
+    // reaches the solution within `depth` steps only for boards in the table,
+    // so a hit is never a false positive. Every stored move is optimal, so the
+    // steps taken are the distance.
+    int8_t hint_switch = -1;
+    for (uint8_t steps = 0; steps <= this->table.depth; steps++)
+    {
+        if (game.check_finish() == true)
+        {
+            first_switch = hint_switch;
+            return steps;
+        }
+
+        CanonicalBoard canonical = canonicalize(game.maze);
+        int32_t slot = hint_cache_index(this->table, canonical.packed);
+        if (slot < 0)
+        {
+            return -1;
+        }
+        uint8_t entry = hint_cache_entry(this->table, slot);
+        if ((entry & ~HINT_CACHE_SWITCH_MASK) != hint_cache_fingerprint(canonical.packed))
+        {
+            return -1;
+        }
+
+        uint8_t sw = switch_from_canonical(canonical.transform, entry & HINT_CACHE_SWITCH_MASK);
+        if (hint_switch < 0)
+        {
+            hint_switch = sw;
+        }
+        game.toggle_switch(sw);
+    }
+    return -1;
+}
@@ -0,0 +1,83 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HINT_CACHE_H
+#define HINT_CACHE_H
+
+#include <cstdint>
+
+#include "board.h"
+
+#define HINT_CACHE_BLOCK_WORDS 16
+// an entry is a nibble: switch in bits 0..2, one fingerprint bit in bit 3
+#define HINT_CACHE_ENTRY_BITS 4
+#define HINT_CACHE_SWITCH_MASK 0x07
+#define HINT_CACHE_FINGERPRINT_SHIFT 3
+
+// Optimal moves for every board within `depth` moves of the solution, indexed
+// by a minimal perfect hash (cascade of collision-free bit arrays, one hash
+// function per level). Boards and moves are stored in their canonical form
+// (see symmetry.h). Generated by tools/hintgen and linked into flash.
+struct HintCacheTable
+{
+  uint8_t depth;
+  uint8_t levels;
+  uint32_t size;               // number of boards
+  const uint32_t *level_words; // size of every level bit array in 32 bit words
+  const uint32_t *bits;        // all level bit arrays back to back
+  const uint32_t *rank;        // set bits before every block of HINT_CACHE_BLOCK_WORDS words
+  const uint8_t *entries;      // one entry per board, two per byte, the even slot in the low nibble
+};
+
+extern const HintCacheTable hint_cache_table;
+
+// slot of a board in the table, -1 if no level claims it
+int32_t hint_cache_index(const HintCacheTable &table, const PackedBoard &packed);
+
+// Fingerprint stored next to the switch of a board. Following the moves
+// already rejects boards outside the table, the bit only ends half of those
+// walks at their first step.
+inline uint8_t hint_cache_fingerprint(const PackedBoard &packed)
+{
+  return (hash_board(packed, 0) >> 63) << HINT_CACHE_FINGERPRINT_SHIFT;
+}
+
+inline uint8_t hint_cache_entry(const HintCacheTable &table, uint32_t slot)
+{
+  return (table.entries[slot / 2] >> ((slot % 2) * HINT_CACHE_ENTRY_BITS)) & ((1 << HINT_CACHE_ENTRY_BITS) - 1);
+}
+
+class HintCache
+{
+public:
+  HintCache(const HintCacheTable &table);
+  // exactly optimal switch for a board close to the solution, -1 on a miss
+  int8_t lookup(const Board maze);
+  // exact moves to the solution for a board close to it, -1 for boards more
+  // than depth() moves away
+  int8_t distance(const Board maze);
+  uint8_t depth();
+
+private:
+  const HintCacheTable &table;
+
+  int8_t follow(const Board maze, int8_t &first_switch);
+};
+
+#endif // HINT_CACHE_H
@@ -0,0 +1,555 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "inference.h"
+
+#include <cstdio>
+#include <new>
+
+#include "tensorflow/lite/micro/micro_time.h"
+#include "tensorflow/lite/micro/system_setup.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+static OpResolver resolver;
+static bool resolver_ready = false;
+
+bool register_ops(OpResolver &resolver)
+{
+#ifdef MODEL_WEIGHTS_INT4
+    // tools/int4pack packs every filter, so the kernels without the int8 paths suffice
+    TfLiteStatus resolve_status = resolver.AddFullyConnected(tflite::Register_FULLY_CONNECTED_INT4());
+#else
+    TfLiteStatus resolve_status = resolver.AddFullyConnected();
+#endif
+    resolve_status = resolver.AddReshape();
+    resolve_status = resolver.AddGatherNd();
+    resolve_status = resolver.AddSub();
+    resolve_status = resolver.AddSlice();
+#ifdef MODEL_WEIGHTS_INT4
+    resolve_status = resolver.AddConv2D(tflite::Register_CONV_2D_INT4());
+#else
+    resolve_status = resolver.AddConv2D();
+#endif
+    resolve_status = resolver.AddTranspose();
+    resolve_status = resolver.AddPad();
+    resolve_status = resolver.AddConcatenation();
+    resolve_status = resolver.AddMaxPool2D();
+    resolve_status = resolver.AddAdd();
+
+    if (resolve_status != kTfLiteOk)
+    {
+        printf("Op resolution failed \n");
+        return false;
+    }
+    return true;
+}
+
+bool model_valid(const unsigned char *model_data, size_t len)
+{
+    flatbuffers::Verifier verifier(model_data, len);
+    if (tflite::VerifyModelBuffer(verifier) == false)
+    {
+        return false;
+    }
+    return tflite::GetModel(model_data)->version() == TFLITE_SCHEMA_VERSION;
+}
+
+uint8_t select_hint(const int8_t scores[NUM_SWITCHES], int8_t excluded_switch)
+{
+    uint8_t hint_switch = 0;
+    int8_t max_score = -128;
+    for (uint8_t i = 0; i < NUM_SWITCHES; i++)
+    {
+        if ((scores[i] > max_score) && (i != excluded_switch))
+        {
+            max_score = scores[i];
+            hint_switch = i;
+        }
+    }
+    return hint_switch;
+}
+
+int16_t hint_margin(const int8_t scores[NUM_SWITCHES], int8_t excluded_switch)
+{
+    int16_t best = -128;
+    int16_t second = -128;
+    for (uint8_t i = 0; i < NUM_SWITCHES; i++)
+    {
+        if (i == excluded_switch)
+        {
+            continue;
+        }
+        if (scores[i] > best)
+        {
+            second = best;
+            best = scores[i];
+        }
+        else if (scores[i] > second)
+        {
+            second = scores[i];
+        }
+    }
+    return best - second;
+}
+
+static bool setup_resolver()
+{
+    if (resolver_ready == false)
+    {
+        resolver_ready = register_ops(resolver);
+    }
+    return resolver_ready;
+}
+
+Inference::Inference(const unsigned char *model_data, uint8_t *tensor_arena, size_t tensor_arena_size)
+{
+    this->model_data = model_data;
+    this->tensor_arena = tensor_arena;
+    this->tensor_arena_size = tensor_arena_size;
+    this->batch = 1;
+}
+
+void Inference::set_worker_pool(tflite::MicroWorkerPool *pool)
+{
+    this->worker_pool = pool;
+}
+
+void Inference::set_incremental(bool enabled)
+{
+    this->incremental = enabled;
+}
+
+void Inference::set_op_costs(tflite::MicroOpCost *costs, size_t count)
+{
+    this->op_costs = costs;
+    this->op_costs_count = count;
+}
+
+void Inference::set_model(const unsigned char *model_data)
+{
+    this->release();
+    this->model_data = model_data;
+}
+
+bool Inference::init()
+{
+    tflite::InitializeTarget();
+
+    // Map the model into a usable data structure. This doesn't involve any
+    // copying or parsing, it's a very lightweight operation.
+    this->model = tflite::GetModel(this->model_data);
+
+    if (this->model->version() != TFLITE_SCHEMA_VERSION)
+    {
+        printf(
+            "Model provided is schema version %d not equal "
+            "to supported version %d. \n",
+            this->model->version(), TFLITE_SCHEMA_VERSION);
+        return false;
+    }
+
+    if (setup_resolver() == false)
+    {
+        return false;
+    }
+
+    // Build an interpreter to run the model with.
+    this->interpreter = new (this->interpreter_buffer) tflite::MicroInterpreter(
+        this->model, resolver, this->tensor_arena, this->tensor_arena_size);
+
+    this->interpreter->SetCancellationToken(this->cancellation_token);
+    if (this->worker_pool != nullptr)
+    {
+        this->interpreter->SetWorkerPool(this->worker_pool);
+    }
+    this->interpreter->SetIncrementalInvoke(this->incremental);
+    if (this->op_costs != nullptr)
+    {
+        this->interpreter->SetOpCosts(this->op_costs, this->op_costs_count);
+        this->op_costs_reported = 0;
+    }
+
+    // Allocate memory from the tensor_arena for the model's tensors.
+    TfLiteStatus allocate_status = this->interpreter->AllocateTensors();
+    if (allocate_status != kTfLiteOk)
+    {
+        printf("AllocateTensors() failed \n");
+        // begin() and score_boards() take a missing interpreter for no model
+        this->release();
+        return false;
+    }
+    this->stats = {};
+    this->stats.size = this->tensor_arena_size;
+    this->update_arena_stats();
+
+    // Obtain pointers to the model's input and output tensors.
+    this->input = this->interpreter->input(0);
+    this->output = this->interpreter->output(0);
+
+    // an auxiliary early-exit head is exported as second output, find the operator producing it
+    this->provisional_output = nullptr;
+    this->provisional_node = -1;
+    if (this->interpreter->outputs_size() > 1)
+    {
+        int32_t tensor_idx = this->interpreter->outputs().Get(1);
+        auto *operators = this->model->subgraphs()->Get(0)->operators();
+        for (uint32_t i = 0; i < operators->size(); i++)
+        {
+            auto *outputs = operators->Get(i)->outputs();
+            for (uint32_t j = 0; j < outputs->size(); j++)
+            {
+                if (outputs->Get(j) == tensor_idx)
+                {
+                    this->provisional_node = i;
+                }
+            }
+        }
+        if (this->provisional_node >= 0)
+        {
+            // every hint takes the stepped path with a provisional stop
+            this->provisional_output = this->interpreter->output(1);
+        }
+    }
+
+    // a batched export carries the number of boards per Invoke() in its leading dimension
+    this->batch = 1;
+    if ((this->input->dims->size > 1) && (this->input->dims->data[0] > 1))
+    {
+        this->batch = (size_t)this->input->dims->data[0];
+    }
+    return true;
+}
+
+void Inference::release()
+{
+    if (this->interpreter == nullptr)
+    {
+        return;
+    }
+    this->interpreter->~MicroInterpreter();
+    this->interpreter = nullptr;
+    this->input = nullptr;
+    this->output = nullptr;
+    this->provisional_output = nullptr;
+    this->provisional_node = -1;
+    this->provisional_pending = false;
+    this->running = false;
+}
+
+size_t Inference::batch_size()
+{
+    return this->batch;
+}
+
+void Inference::set_input(const Board *boards, size_t count)
+{
+    // unused batch rows keep their previous content
+    for (size_t b = 0; b < count; b++)
+    {
+        int32_t *row = &this->input->data.i32[b * 36];
+        for (uint8_t i = 0; i < 36; i++)
+        {
+            row[i] = boards[b][i / 6][i % 6];
+        }
+    }
+}
+
+void Inference::get_output(const TfLiteTensor *tensor, size_t count, int8_t (*scores)[NUM_SWITCHES])
+{
+    for (size_t b = 0; b < count; b++)
+    {
+        const int8_t *row = &tensor->data.int8[b * NUM_SWITCHES];
+        for (uint8_t i = 0; i < NUM_SWITCHES; i++)
+        {
+            scores[b][i] = row[i];
+        }
+    }
+}
+
+bool Inference::invoke_batch(const Board *boards, size_t count, int8_t (*scores)[NUM_SWITCHES])
+{
+    this->set_input(boards, count);
+
+    if (this->interpreter->Invoke() != kTfLiteOk)
+    {
+        return false;
+    }
+    this->update_arena_stats();
+
+    this->get_output(this->output, count, scores);
+    return true;
+}
+
+bool Inference::score_boards(const Board *boards, size_t count, int8_t (*scores)[NUM_SWITCHES])
+{
+    if (this->interpreter == nullptr)
+    {
+        return false;
+    }
+
+    while (count > 0)
+    {
+        size_t n = count < this->batch ? count : this->batch;
+        if (this->invoke_batch(boards, n, scores) == false)
+        {
+            return false;
+        }
+        boards += n;
+        scores += n;
+        count -= n;
+    }
+    return true;
+}
+
+bool Inference::score_board(const Board board, int8_t scores[NUM_SWITCHES])
+{
+    return this->score_boards((const Board *)board, 1, (int8_t(*)[NUM_SWITCHES])scores);
+}
+
+bool Inference::has_provisional_head()
+{
+    return this->provisional_output != nullptr;
+}
+
+bool Inference::begin(const Board board)
+{
+    if (this->interpreter == nullptr)
+    {
+        return false;
+    }
+    this->set_input((const Board *)board, 1);
+
+    // drop a stale run that was not refined to the end
+    this->clear_cancellation();
+    this->interpreter->Cancel();
+    this->provisional_pending = this->has_provisional_head();
+    this->running = this->interpreter->InvokeUntil(1) == kTfLiteOk;
+    if (this->running == true)
+    {
+        this->update_arena_stats();
+    }
+    return this->running;
+}
+
+InferenceState Inference::refine(int8_t scores[NUM_SWITCHES], uint32_t budget_us)
+{
+    if (this->running == false)
+    {
+        return INFERENCE_ERROR;
+    }
+
+    // one operator at a time, so the slice ends right after the early-exit
+    // head; the interpreter ticks are microseconds (micro_time.cpp)
+    uint32_t start = tflite::GetCurrentTimeTicks();
+    while (this->interpreter->invoke_in_progress() == true)
+    {
+        if ((this->provisional_pending == true) &&
+            (this->interpreter->next_operator_index() > (uint32_t)this->provisional_node))
+        {
+            break;
+        }
+        TfLiteStatus status = this->interpreter->InvokeUntil(this->interpreter->next_operator_index() + 1);
+        if (status != kTfLiteOk)
+        {
+            // the run is gone, the caller starts over
+            this->running = false;
+            this->was_cancelled = status == kTfLiteCancelled;
+            return this->was_cancelled ? INFERENCE_CANCELLED : INFERENCE_ERROR;
+        }
+        if (tflite::GetCurrentTimeTicks() - start >= budget_us)
+        {
+            break;
+        }
+    }
+    this->update_arena_stats();
+
+    bool finished = this->interpreter->invoke_in_progress() == false;
+    if ((this->provisional_pending == true) &&
+        ((finished == true) || (this->interpreter->next_operator_index() > (uint32_t)this->provisional_node)))
+    {
+        this->provisional_pending = false;
+        this->get_output(this->provisional_output, 1, (int8_t(*)[NUM_SWITCHES])scores);
+        return INFERENCE_PROVISIONAL;
+    }
+    if (finished == false)
+    {
+        return INFERENCE_RUNNING;
+    }
+    this->running = false;
+    this->get_output(this->output, 1, (int8_t(*)[NUM_SWITCHES])scores);
+    return INFERENCE_DONE;
+}
+
+void Inference::set_cancellation_token(volatile bool *token)
+{
+    this->cancellation_token = token;
+    if (this->interpreter != nullptr)
+    {
+        this->interpreter->SetCancellationToken(token);
+    }
+}
+
+bool Inference::cancelled()
+{
+    return this->was_cancelled;
+}
+
+void Inference::clear_cancellation()
+{
+    this->was_cancelled = false;
+    if (this->cancellation_token != nullptr)
+    {
+        *this->cancellation_token = false;
+    }
+}
+
+size_t Inference::arena_used_bytes()
+{
+    if (this->interpreter == nullptr)
+    {
+        return 0;
+    }
+    return this->interpreter->arena_used_bytes();
+}
+
+const ArenaStats &Inference::arena_stats()
+{
+    return this->stats;
+}
+
+void Inference::update_arena_stats()
+{
+    size_t persistent = this->interpreter->arena_persistent_used_bytes();
+    size_t non_persistent = this->interpreter->arena_non_persistent_used_bytes();
+
+    this->stats.used = this->interpreter->arena_used_bytes();
+    if (persistent > this->stats.persistent_high_water)
+    {
+        this->stats.persistent_high_water = persistent;
+        this->stats_changed = true;
+    }
+    if (non_persistent > this->stats.non_persistent_high_water)
+    {
+        this->stats.non_persistent_high_water = non_persistent;
+        this->stats_changed = true;
+    }
+}
+
+bool Inference::report_arena_stats()
+{
+    if (this->stats_changed == false)
+    {
+        return false;
+    }
+    this->stats_changed = false;
+
+    printf("arena: %u of %u bytes used, high-water persistent %u, non-persistent %u\n",
+           (unsigned)this->stats.used, (unsigned)this->stats.size,
+           (unsigned)this->stats.persistent_high_water, (unsigned)this->stats.non_persistent_high_water);
+    return true;
+}
+
+bool Inference::report_op_costs(uint32_t cycles_per_us)
+{
+    // the first operator runs in every invocation, stepped ones included
+    if ((this->op_costs == nullptr) || (this->op_costs_count == 0) ||
+        (this->op_costs[0].invokes == this->op_costs_reported))
+    {
+        return false;
+    }
+    this->op_costs_reported = this->op_costs[0].invokes;
+
+    // micro_time ticks are microseconds
+    tflite::LogMicroOpCostsCsv(this->op_costs, this->op_costs_count, cycles_per_us);
+    return true;
+}
+
+ModelCascade::ModelCascade(uint8_t *tensor_arena, size_t tensor_arena_size)
+{
+    this->tensor_arena = tensor_arena;
+    this->tensor_arena_size = tensor_arena_size;
+}
+
+Inference *ModelCascade::add_stage(const unsigned char *model_data, uint8_t max_distance, int16_t min_margin)
+{
+    if (this->num_stages == CASCADE_MAX_STAGES)
+    {
+        return nullptr;
+    }
+    uint8_t stage = this->num_stages++;
+    this->stages[stage] = new (this->stage_buffer[stage])
+        Inference(model_data, this->tensor_arena, this->tensor_arena_size);
+    this->max_distance[stage] = max_distance;
+    this->min_margin[stage] = min_margin;
+    return this->stages[stage];
+}
+
+bool ModelCascade::load(uint8_t stage)
+{
+    if (this->loaded == stage)
+    {
+        return true;
+    }
+    if (this->loaded >= 0)
+    {
+        this->stages[this->loaded]->release();
+        this->loaded = -1;
+    }
+    if (this->stages[stage]->init() == false)
+    {
+        return false;
+    }
+    this->loaded = stage;
+    this->load_count++;
+    return true;
+}
+
+bool ModelCascade::score_board(const Board board, int8_t scores[NUM_SWITCHES], int8_t excluded_switch)
+{
+    this->router.load(board);
+    uint8_t distance = this->router.moves_lower_bound();
+    for (uint8_t stage = 0; stage < this->num_stages; stage++)
+    {
+        bool last = stage == this->num_stages - 1;
+        if ((last == false) && (distance > this->max_distance[stage]))
+        {
+            continue;
+        }
+        if ((this->load(stage) == false) || (this->stages[stage]->score_board(board, scores) == false))
+        {
+            return false;
+        }
+        if ((last == true) || (hint_margin(scores, excluded_switch) >= this->min_margin[stage]))
+        {
+            this->answered = stage;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint8_t ModelCascade::last_stage()
+{
+    return this->answered;
+}
+
+uint32_t ModelCascade::loads()
+{
+    return this->load_count;
+}
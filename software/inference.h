@@ -0,0 +1,191 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INFERENCE_H
+#define INFERENCE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
+
+#include "board.h"
+#include "game.h"
+
+// switches of the device's board, one logit per switch
+constexpr uint8_t NUM_SWITCHES = Game::NUM_SWITCHES;
+#define NUM_OPS 11
+// cores of the RP2040 the kernels split an operator over, the tensor arena
+// holds a scratch buffer per core
+#define INFERENCE_WORKERS 2
+// models of a ModelCascade
+#define CASCADE_MAX_STAGES 3
+
+typedef tflite::MicroMutableOpResolver<NUM_OPS> OpResolver;
+
+// registers the operators of the colordot model, shared with the host tools
+bool register_ops(OpResolver &resolver);
+
+// structural check of a .tflite blob of len bytes (flatbuffer layout and
+// schema version), whatever the operators and arena of this build
+bool model_valid(const unsigned char *model_data, size_t len);
+
+// argmax over the switch logits, skipping the switch that would undo the last hint
+uint8_t select_hint(const int8_t scores[NUM_SWITCHES], int8_t excluded_switch);
+// how far the logit of the selected hint leads the next best one
+int16_t hint_margin(const int8_t scores[NUM_SWITCHES], int8_t excluded_switch);
+
+// result of a refine() slice
+enum InferenceState
+{
+  INFERENCE_RUNNING,
+  INFERENCE_PROVISIONAL, // the early-exit head ran, scores hold its logits
+  INFERENCE_DONE,        // scores hold the final logits
+  INFERENCE_CANCELLED,   // the token dropped the run, scores untouched
+  INFERENCE_ERROR,       // an operator failed or no run was begun, scores untouched
+};
+
+// tensor arena usage in bytes, the high-water marks are taken after
+// AllocateTensors() and after every invocation
+struct ArenaStats
+{
+  size_t size;
+  size_t used;
+  size_t persistent_high_water;
+  size_t non_persistent_high_water;
+};
+
+class Inference
+{
+public:
+  Inference(const unsigned char *model_data, uint8_t *tensor_arena, size_t tensor_arena_size);
+  // kernels split large operators over the pool, set before init()
+  void set_worker_pool(tflite::MicroWorkerPool *pool);
+  // convolutions keep their last input and output in the arena and only
+  // recompute what a changed input reaches, set before init()
+  void set_incremental(bool enabled);
+  // costs[i] collects the work and kernel time of operator i, set before init()
+  void set_op_costs(tflite::MicroOpCost *costs, size_t count);
+  // Model of the next init(), read in place like the one of the constructor
+  // (a ModelStore slot needs no copy). Releases the running model, the next
+  // init() takes over the same arena.
+  void set_model(const unsigned char *model_data);
+  bool init();
+  // destroys the interpreter, the arena is free for another model until the next init()
+  void release();
+  // number of boards the model scores per Invoke() (leading dimension of the input tensor)
+  size_t batch_size();
+  // scores[i] receives the 8 switch logits of boards[i]; boards are run batch_size() at a time
+  bool score_boards(const Board *boards, size_t count, int8_t (*scores)[NUM_SWITCHES]);
+  bool score_board(const Board board, int8_t scores[NUM_SWITCHES]);
+
+  // Stepped, anytime inference: begin() sets the board and runs the first
+  // operator, every refine() then runs at least one more and up to budget_us.
+  // A model exported with an auxiliary early-exit head as second output stops
+  // once right after that head with INFERENCE_PROVISIONAL and its logits in
+  // scores; INFERENCE_DONE brings the final logits.
+  bool has_provisional_head();
+  bool begin(const Board board);
+  InferenceState refine(int8_t scores[NUM_SWITCHES], uint32_t budget_us = 0);
+  // once *token is set, refine() stops at the next operator boundary and drops
+  // the run without touching scores; begin() clears it
+  void set_cancellation_token(volatile bool *token);
+  bool cancelled();
+
+  size_t arena_used_bytes();
+  const ArenaStats &arena_stats();
+  // prints the arena usage over stdio if a high-water mark grew since the last report
+  bool report_arena_stats();
+  // prints the per-operator roofline table (CSV) over stdio if there were
+  // invocations since the last report, times in cycles at cycles_per_us
+  bool report_op_costs(uint32_t cycles_per_us);
+
+private:
+  const unsigned char *model_data;
+  uint8_t *tensor_arena;
+  size_t tensor_arena_size;
+  size_t batch;
+
+  const tflite::Model *model = nullptr;
+  tflite::MicroInterpreter *interpreter = nullptr;
+  alignas(tflite::MicroInterpreter) uint8_t interpreter_buffer[sizeof(tflite::MicroInterpreter)];
+  TfLiteTensor *input = nullptr;
+  TfLiteTensor *output = nullptr;
+  TfLiteTensor *provisional_output = nullptr;
+  int16_t provisional_node = -1;
+  bool provisional_pending = false;
+  bool running = false;
+  volatile bool *cancellation_token = nullptr;
+  tflite::MicroWorkerPool *worker_pool = nullptr;
+  bool incremental = false;
+  tflite::MicroOpCost *op_costs = nullptr;
+  size_t op_costs_count = 0;
+  uint32_t op_costs_reported = 0;
+  bool was_cancelled = false;
+  ArenaStats stats = {};
+  bool stats_changed = false;
+
+  void set_input(const Board *boards, size_t count);
+  void get_output(const TfLiteTensor *tensor, size_t count, int8_t (*scores)[NUM_SWITCHES]);
+  bool invoke_batch(const Board *boards, size_t count, int8_t (*scores)[NUM_SWITCHES]);
+  void update_arena_stats();
+  void clear_cancellation();
+};
+
+// Routes every board to the first of several models that is fit for it, so
+// shallow boards can take a small model and only the others the full one.
+// The models take turns in one tensor arena: only the stage in use is
+// initialized, and routing a board to another stage releases it and runs
+// init() of the other. Keep the stages of consecutive boards alike, a switch
+// costs a full AllocateTensors().
+class ModelCascade
+{
+public:
+  ModelCascade(uint8_t *tensor_arena, size_t tensor_arena_size);
+  // A stage takes a board whose moves_lower_bound() is at most max_distance
+  // and keeps its hint if that leads by at least min_margin, otherwise the
+  // next stage is tried. The last stage added answers every board that gets
+  // to it. Returns the stage to set up before its first use, nullptr once
+  // CASCADE_MAX_STAGES are added.
+  Inference *add_stage(const unsigned char *model_data, uint8_t max_distance = 255, int16_t min_margin = 0);
+  bool score_board(const Board board, int8_t scores[NUM_SWITCHES], int8_t excluded_switch = -1);
+  // stage that answered the last board
+  uint8_t last_stage();
+  // models initialized so far
+  uint32_t loads();
+
+private:
+  uint8_t *tensor_arena;
+  size_t tensor_arena_size;
+  alignas(Inference) uint8_t stage_buffer[CASCADE_MAX_STAGES][sizeof(Inference)];
+  Inference *stages[CASCADE_MAX_STAGES];
+  uint8_t max_distance[CASCADE_MAX_STAGES];
+  int16_t min_margin[CASCADE_MAX_STAGES];
+  uint8_t num_stages = 0;
+  int8_t loaded = -1;
+  uint8_t answered = 0;
+  uint32_t load_count = 0;
+  Game router = Game();
+
+  bool load(uint8_t stage);
+};
+
+#endif // INFERENCE_H
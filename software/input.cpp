@@ -0,0 +1,80 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "input.h"
+
+static bool scan_callback(repeating_timer_t *rt)
+{
+    InputScanner *scanner = (InputScanner *)rt->user_data;
+    scanner->scan(gpio_get_all());
+    return true; // keep repeating
+}
+
+InputScanner::InputScanner(uint32_t pin_mask, input_callback_t callback)
+{
+    this->pin_mask = pin_mask;
+    this->callback = callback;
+    this->debounced = 0;
+    this->count0 = 0;
+    this->count1 = 0;
+}
+
+bool InputScanner::start()
+{
+    // current levels are the starting point, no events for them
+    this->debounced = gpio_get_all() & this->pin_mask;
+    this->count0 = 0;
+    this->count1 = 0;
+
+    // negative period: fixed rate independent of the callback run time
+    return add_repeating_timer_us(-SCAN_PERIOD_US, scan_callback, this, &this->timer);
+}
+
+void InputScanner::stop()
+{
+    cancel_repeating_timer(&this->timer);
+}
+
+uint32_t InputScanner::state()
+{
+    return this->debounced;
+}
+
+void InputScanner::scan(uint32_t sample)
+{
+    // pins differing from the debounced level count up, the others reset
+    uint32_t delta = (sample & this->pin_mask) ^ this->debounced;
+    this->count1 = (this->count1 ^ this->count0) & delta;
+    this->count0 = ~this->count0 & delta;
+
+    // counter wrapped around after 4 differing samples
+    uint32_t changed = delta & ~(this->count0 | this->count1);
+    if (changed == 0)
+    {
+        return;
+    }
+    this->debounced ^= changed;
+
+    while (changed != 0)
+    {
+        uint gpio = __builtin_ctz(changed);
+        changed &= changed - 1;
+        this->callback(gpio, (this->debounced >> gpio) & 1 ? GPIO_IRQ_EDGE_RISE : GPIO_IRQ_EDGE_FALL);
+    }
+}
@@ -0,0 +1,53 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "pico/stdlib.h"
+
+// sampling period, a level has to be stable for 4 samples to be accepted
+#define SCAN_PERIOD_US 1000
+
+typedef void (*input_callback_t)(uint gpio, uint32_t events);
+
+// Samples all input pins as one snapshot from a single repeating timer and
+// debounces them in parallel with a 2 bit vertical counter per pin. Every
+// accepted level change is reported once as GPIO_IRQ_EDGE_RISE / _FALL from
+// the timer interrupt.
+class InputScanner
+{
+public:
+  InputScanner(uint32_t pin_mask, input_callback_t callback);
+  bool start();
+  void stop();
+  // debounced level of all pins
+  uint32_t state();
+  void scan(uint32_t sample);
+
+private:
+  uint32_t pin_mask;
+  input_callback_t callback;
+  repeating_timer_t timer;
+  volatile uint32_t debounced;
+  uint32_t count0;
+  uint32_t count1;
+};
+
+#endif // INPUT_H
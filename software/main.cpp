@@ -23,149 +23,320 @@
 #include "pico/stdlib.h"
 #include "hardware/clocks.h"
 #include "hardware/flash.h"
-#include "hardware/sync.h"
 
 #include "model_data.h"
+#include "arena_size.h"
 #include "GpioMap.h"
 
-#include "tensorflow/lite/micro/micro_interpreter.h"
-#include "tensorflow/lite/micro/micro_log.h"
-#include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
-#include "tensorflow/lite/micro/system_setup.h"
-#include "tensorflow/lite/schema/schema_generated.h"
-
 #include "game.h"
 #include "display.h"
+#include "animation.h"
+#include "inference.h"
+#include "hint_cache.h"
+#include "input.h"
+#include "scheduler.h"
+#include "store.h"
+#include "model_store.h"
+#include "pico_flash.h"
+#include "pico_worker_pool.h"
+#include "solver.h"
 
 #define PUSHBUTTON_PIN 12
-#define DEBOUNCE_TIME_US 150000
 #define DEFAULT_BRIGTHNESS 8
 #define DEFAULT_LEVEL 20
 
-#define FLASH_TARGET_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+// system clock while waiting for input and while the inference runs
+#define IDLE_CLOCK_KHZ 48000
+#define BOOST_CLOCK_KHZ 133000
+// operators run back to back per inference event, input is handled in between
+#define INFERENCE_SLICE_US 2000
+// restarts of an inference that failed on the same board
+#define INFERENCE_RETRIES 2
+// the exact search runs a slice ahead of every inference slice, and alone
+// once the inference finished, until its deadline; it checks the time every
+// SOLVER_SLICE_NODES boards
+#define SOLVER_SLICE_US 1000
+#define SOLVER_SLICE_NODES 32
+#define SOLVER_DEADLINE_US 250000
+// bytes on top of the tensor arena measured on the build host: in a 32-bit
+// host build the persistent structures can still pad differently from
+// arm-none-eabi, a 64-bit host overestimates anyway; report_arena_stats()
+// prints what the device really uses
+#define TENSOR_ARENA_MARGIN 64
+// operators the roofline table of a ROOFLINE_REPORT build has room for
+#define ROOFLINE_MAX_OPS 16
+
+// settings and statistics log in the last sectors, the single-page format
+// used the last sector alone
+#define STORE_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - STORE_SECTORS * STORE_SECTOR_SIZE)
+#define LEGACY_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+// model slots right below, written by picotool with an image of tools/modelimage
+#define MODEL_STORE_FLASH_OFFSET (STORE_FLASH_OFFSET - MODEL_STORE_BYTES)
 
 std::map<uint8_t, uint32_t> GpioMap;
 
-volatile uint32_t timer_start = 0;
-volatile uint32_t timer_stop = 0;
+uint32_t timer_start = 0;
+uint32_t game_start_ms = 0;
+uint16_t game_moves = 0;
 
-volatile bool game_started = false;
-volatile bool game_finished = false;
-volatile bool need_to_initialize = false;
-volatile bool state_changed = false;
-volatile bool display_hint = false;
-volatile int8_t last_hint_switch = -1;
+bool game_started = false;
+bool game_finished = false;
+int8_t last_hint_switch = -1;
 
 Game game = Game();
 Display display = Display(DEFAULT_BRIGTHNESS);
+Animator animator = Animator();
+
+// solved games, KEY_STATS
+struct GameStats
+{
+  uint32_t games;
+  uint32_t total_solve_s;
+  uint32_t best_solve_ms;
+  uint32_t total_moves;
+  uint32_t total_scramble_moves;
+};
+
+// last solved game, KEY_LAST_GAME
+struct LastGame
+{
+  uint32_t solve_ms;
+  uint16_t moves;
+  uint16_t scramble_moves;
+};
+
+PicoFlash flash = PicoFlash(STORE_FLASH_OFFSET);
+KvStore store = KvStore(flash);
+GameStats stats = {};
+PicoFlash model_flash = PicoFlash(MODEL_STORE_FLASH_OFFSET);
+ModelStore model_store = ModelStore(model_flash);
+
+// newest page of the single-page format, the values stay unchanged if it is empty
+void read_legacy_settings(uint8_t &brightness, uint8_t &difficulty)
+{
+    for (int8_t page = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE - 1; page >= 0; page--)
+    {
+        const uint8_t *p = (const uint8_t *)(XIP_BASE + LEGACY_FLASH_OFFSET + (page * FLASH_PAGE_SIZE));
+        if (*p != 0xFF)
+        {
+            brightness = p[0];
+            difficulty = p[1];
+            return;
+        }
+    }
+}
+
+// appends the solved game to the statistics, no erase needed
+void record_game(uint32_t solve_ms)
+{
+    LastGame last = {solve_ms, game_moves, game.scramble_moves};
+    stats.games++;
+    stats.total_solve_s += solve_ms / 1000;
+    if ((stats.best_solve_ms == 0) || (solve_ms < stats.best_solve_ms))
+    {
+        stats.best_solve_ms = solve_ms;
+    }
+    stats.total_moves += game_moves;
+    stats.total_scramble_moves += game.scramble_moves;
+    store.put(KEY_LAST_GAME, &last, sizeof(last));
+    store.put(KEY_STATS, &stats, sizeof(stats));
+    printf("solved in %lu ms, %u moves for %u scramble moves, %lu games\n", (unsigned long)solve_ms, game_moves,
+           game.scramble_moves, (unsigned long)stats.games);
+}
+
+// hides the row / column of the hinted switch, the mask is set per hint
+Keyframe hint_blink[] = {
+    {250, 0, palette_off},
+};
+
+uint32_t now_ms()
+{
+    return to_ms_since_boot(get_absolute_time());
+}
 
 void update_display()
 {
-    display.serialize_maze(game.maze);
+    Board frame;
+    animator.compose(game.maze, frame);
+    display.serialize_maze(frame);
     display.push_leds();
 }
 
-// Interrupt handler button / switch
-void pin_callback(uint gpio, uint32_t events)
+// hides the row / column of the hint switch for one blink
+void show_hint(uint8_t hint_switch)
 {
-    if (gpio == PUSHBUTTON_PIN)
+    if (hint_switch < 4)
     {
-        if (game_started == false)
-        {
-            // Initiates a new game by shuffling the dots, using a random seed based on the duration of the push button press
-            // Start the timer on falling edge
-            if (events & GPIO_IRQ_EDGE_FALL)
-            {
-                if ((time_us_32() - timer_start) > DEBOUNCE_TIME_US)
-                {
-                    timer_start = time_us_32();
-                }
-            }
-            // Stop the timer on rising edge
-            if ((events & GPIO_IRQ_EDGE_RISE) && ((time_us_32() - timer_start) > 1000))
-            {
-                // disable interrupt for this pin
-                gpio_set_irq_enabled(PUSHBUTTON_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
-                timer_stop = time_us_32();
+        hint_blink[0].mask = ROW_MASK(hint_switch + 1);
+    }
+    else
+    {
+        hint_blink[0].mask = COL_MASK(hint_switch - 3);
+    }
+    animator.start(LAYER_HINT, hint_blink, 1, false, now_ms());
+    update_display();
+}
 
-                // re-enable interrupt after DEBOUNCE_TIME_US
-                add_alarm_in_us(DEBOUNCE_TIME_US, [](alarm_id_t id, void *user_data) -> int64_t
-                                {
-                                    uint gpio = (uint)(uintptr_t)user_data;
+EventQueue events = EventQueue();
 
-                                    // clear all queued interupts
-                                    gpio_acknowledge_irq(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
-                                    // Re-enable the interrupt for this GPIO pin
-                                    gpio_set_irq_enabled(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+// changes clk_sys between two LED pushes, the PIO divider follows the clock
+void set_clock_khz(uint32_t khz)
+{
+    display.drain();
+    set_sys_clock_khz(khz, true);
+    display.retime();
+}
 
-                                    return 0; // No need to call again
-                                },
-                                (void *)(uintptr_t)gpio, false);
+Governor governor = Governor(IDLE_CLOCK_KHZ, BOOST_CLOCK_KHZ, &set_clock_khz);
 
-                need_to_initialize = true;
-                game_finished = false;
-            }
-        }
-        else // if game started show hint
-        {
-            if (events & GPIO_IRQ_EDGE_RISE)
-            {
-                display_hint = true;
-            }
-        }
-    }
+// set by a switch edge, the running inference slice stops at the next
+// operator boundary, its board is stale anyway
+volatile bool inference_cancel = false;
 
+// Debounced edge handler button / switch, runs in the input scanner
+// interrupt and only posts the edge to the run loop
+void pin_callback(uint gpio, uint32_t events_mask)
+{
+    Event event = {EVENT_SWITCH, 0, time_us_32()};
+    if (gpio == PUSHBUTTON_PIN)
+    {
+        event.type = (events_mask & GPIO_IRQ_EDGE_FALL) ? EVENT_BUTTON_DOWN : EVENT_BUTTON_UP;
+    }
     else
-    { // slide switches changed
-        // Disable further interrupts on this pin
-        gpio_set_irq_enabled(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    {
+        event.arg = GpioMap[gpio];
+        inference_cancel = true;
+    }
+    events.post(event);
+}
 
-        // user choosed different switch than recommended by AI
-        if (last_hint_switch != GpioMap[gpio])
-        {
-            last_hint_switch = -1;
-        }
+// an inference step is posted, the board changed since the inference started
+bool inference_queued = false;
+bool inference_stale = false;
+// the hint switch belongs to the current board, a hint was requested before
+bool hint_ready = false;
+bool hint_pending = false;
 
-        game_finished = false;
+// (re)starts the inference on the current board with the next queued step
+void request_inference()
+{
+    inference_stale = true;
+    hint_ready = false;
+    if (inference_queued == false)
+    {
+        events.post({EVENT_INFERENCE, 0, time_us_32()});
+        inference_queued = true;
+    }
+}
 
-        // update game
-        game.toggle_switch(GpioMap[gpio]);
-        update_display();
+// starts over on the current board after a cancelled or failed inference,
+// a model that keeps failing gives no final hint until the next move
+uint8_t inference_retries = 0;
+void retry_inference()
+{
+    if (inference_cancel == true)
+    {
+        // the move that set the token restarts the inference anyway
+        request_inference();
+    }
+    else if (inference_retries < INFERENCE_RETRIES)
+    {
+        printf("inference failed, retrying\n");
+        inference_retries++;
+        request_inference();
+    }
+    else
+    {
+        printf("inference failed, no hint for this board\n");
+    }
+}
 
-        // trigger new AI inference
-        state_changed = true;
+// where the hints came from, traced over stdio once a board's hint is final:
+// the cache, the exact search before the network, the network, or the exact
+// search after the network hint was out
+struct HintSources
+{
+  uint32_t cached;
+  uint32_t exact;
+  uint32_t network;
+  uint32_t replaced;
+};
+HintSources hint_sources = {};
+
+void trace_hint_sources()
+{
+    printf("hints: %lu cached, %lu exact, %lu network, %lu network replaced by exact\n",
+           (unsigned long)hint_sources.cached, (unsigned long)hint_sources.exact,
+           (unsigned long)hint_sources.network, (unsigned long)hint_sources.replaced);
+}
 
-        // re-enable interrupt after DEBOUNCE_TIME_US
-        add_alarm_in_us(DEBOUNCE_TIME_US, [](alarm_id_t id, void *user_data) -> int64_t
-                        {
-                            uint gpio = (uint)(uintptr_t)user_data;
+InputScanner input_scanner = InputScanner((1u << PUSHBUTTON_PIN) | (0xFFu << 18), &pin_callback);
 
-                            // clear all queued interupts
-                            gpio_acknowledge_irq(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
-                            // Re-enable the interrupt for this GPIO pin
-                            gpio_set_irq_enabled(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+// game.switches value matching the physical position of every slide switch
+void read_switches(uint8_t switch_state[8])
+{
+    for (uint8_t gpio = 18; gpio < 22; gpio++)
+    {
+        switch_state[GpioMap[gpio]] = gpio_get(gpio);
+    }
+    for (uint8_t gpio = 22; gpio < 26; gpio++)
+    {
+        switch_state[GpioMap[gpio]] = !gpio_get(gpio);
+    }
+}
 
-                            return 0; // No need to call again
-                        },
-                        (void *)(uintptr_t)gpio, false);
+// tflite infrastructure, the arena is the size tools/arenasize measured on the
+// build host plus TENSOR_ARENA_MARGIN
+constexpr uint32_t kTensorArenaSize = TENSOR_ARENA_SIZE + TENSOR_ARENA_MARGIN;
+uint8_t tensor_arena[kTensorArenaSize];
 
-        if ((game.check_finish() == true) && (game_started == true))
+Inference inference = Inference(COLORDOT_MODEL, tensor_arena, kTensorArenaSize);
+#ifdef ROOFLINE_REPORT
+tflite::MicroOpCost op_costs[ROOFLINE_MAX_OPS];
+#endif
+PicoWorkerPool worker_pool = PicoWorkerPool();
+HintCache hint_cache = HintCache(hint_cache_table);
+Solver solver = Solver(hint_cache);
+
+// Runs the newest hint model of the model store in place. The boot trusts
+// the slot header, only a model that fails to load is checked in full: if
+// the blob fails its CRC or the flatbuffer check it is damaged and rejected
+// for good, otherwise it does not fit this firmware (operator missing, arena
+// too small) and is only skipped, a later firmware may run it. The linked
+// model is the last resort, without it the game runs without hints.
+bool load_model()
+{
+    model_store.mount();
+    uint8_t skipped = 0;
+    for (int8_t slot = model_store.select(MODEL_ROLE_HINT); slot >= 0;
+         slot = model_store.select(MODEL_ROLE_HINT, skipped))
+    {
+        const ModelSlotHeader *header = model_store.header(slot);
+        inference.set_model(model_store.model(slot));
+        if (inference.init() == true)
+        {
+            printf("model %.*s version %lu from slot %d\n", MODEL_NAME_LEN, header->name,
+                   (unsigned long)header->version, slot);
+            return true;
+        }
+        if ((model_store.verify(slot) == false) || (model_valid(model_store.model(slot), header->length) == false))
         {
-            game_finished = true;
-            game_started = false;
+            printf("model in slot %d is damaged, rejected\n", slot);
+            model_store.reject(slot);
+            continue;
         }
+        printf("model in slot %d does not load in this firmware, skipped\n", slot);
+        skipped |= 1u << slot;
     }
+    inference.set_model(COLORDOT_MODEL);
+    if (inference.init() == false)
+    {
+        printf("linked model does not load, no hints\n");
+        return false;
+    }
+    return true;
 }
 
-// tflite infrastructure
-const tflite::Model *model = nullptr;
-tflite::MicroInterpreter *interpreter = nullptr;
-TfLiteTensor *input = nullptr;
-TfLiteTensor *output = nullptr;
-
-constexpr uint32_t kTensorArenaSize = 32000;
-uint8_t tensor_arena[kTensorArenaSize];
-
 int main()
 {
     GpioMap[21] = 0;
@@ -199,73 +370,54 @@ int main()
     PIO pio = pio0;
     uint8_t sm = 0;
     uint32_t offset = pio_add_program(pio, &ws2812_program);
-    ws2812_program_init(pio, sm, offset, WS2812_PIN, 800000, IS_RGBW);
+    ws2812_program_init(pio, sm, offset, WS2812_PIN, WS2812_FREQ, IS_RGBW);
 
     // read stored values for LED brightness and game difficulty
-    uint32_t addr;
-    int8_t page = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE - 1;
-    uint8_t *p, brightness, difficulty;
-
-    // flash wear protection
-    while (page >= 0)
+    uint8_t brightness = DEFAULT_BRIGTHNESS;
+    uint8_t difficulty = DEFAULT_LEVEL;
+    if (store.mount() == false)
     {
-        addr = XIP_BASE + FLASH_TARGET_OFFSET + (page * FLASH_PAGE_SIZE);
-        p = (uint8_t *)addr;
-        if (*p != 0xFF)
-        {
-            brightness = *p;
-            difficulty = p[1];
-            break;
-        }
-        page -= 1;
-    }
-
-    if (page == -1)
-    {
-        brightness = DEFAULT_BRIGTHNESS;
-        difficulty = DEFAULT_LEVEL;
+        // first start with the store, keep the settings of the single-page format
+        read_legacy_settings(brightness, difficulty);
+        store.format();
+        store.put(KEY_BRIGHTNESS, &brightness, 1);
+        store.put(KEY_DIFFICULTY, &difficulty, 1);
     }
+    store.get(KEY_BRIGHTNESS, &brightness, 1);
+    store.get(KEY_DIFFICULTY, &difficulty, 1);
+    store.get(KEY_STATS, &stats, sizeof(stats));
 
     // check for pressed PUSHBUTTON_PIN during power-on to reinitialize brightness and game difficulty
     if (gpio_get(PUSHBUTTON_PIN) == 0)
     {
         uint8_t tmp_brightness = brightness;
         uint8_t tmp_difficulty = difficulty;
+        uint8_t shown_brightness = 0;
         while (gpio_get(PUSHBUTTON_PIN) == 0)
         {
             tmp_brightness = 1 << (gpio_get(20) * 4 + gpio_get(19) * 2 + gpio_get(18));
-            // apply brightness
-            display.update_brightness(tmp_brightness);
-            update_display();
+            if (tmp_brightness != shown_brightness)
+            {
+                // apply brightness and preview it
+                display.update_brightness(tmp_brightness);
+                animator.start(LAYER_BRIGHTNESS, brightness_preview, brightness_preview_len, false, now_ms());
+                shown_brightness = tmp_brightness;
+                update_display();
+            }
 
             tmp_difficulty = gpio_get(24) * 4 + gpio_get(23) * 2 + gpio_get(22);
-            sleep_ms(100);
-        }
-        if ((tmp_brightness != brightness) || (tmp_difficulty != difficulty))
-        {
-            // store new parameters to flash
-            page += 1;
-            if (page == FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE)
-            // need to erase flash sector
+            if (animator.tick(now_ms()) == true)
             {
-                uint32_t ints = save_and_disable_interrupts();
-                flash_range_erase(FLASH_TARGET_OFFSET, FLASH_SECTOR_SIZE);
-                restore_interrupts(ints);
-                page = 0;
+                update_display();
             }
-            addr = XIP_BASE + FLASH_TARGET_OFFSET + (page * FLASH_PAGE_SIZE);
-            p = (uint8_t *)addr;
-
-            uint8_t buf[FLASH_PAGE_SIZE] = {0};
-            buf[0] = tmp_brightness;
-            buf[1] = tmp_difficulty;
-
-            difficulty = tmp_difficulty;
-
-            uint32_t ints = save_and_disable_interrupts();
-            flash_range_program(FLASH_TARGET_OFFSET + (page * FLASH_PAGE_SIZE), (uint8_t *)buf, FLASH_PAGE_SIZE);
-            restore_interrupts(ints);
+            sleep_ms(10);
         }
+        animator.stop(LAYER_BRIGHTNESS);
+        // unchanged values are not written again
+        brightness = tmp_brightness;
+        difficulty = tmp_difficulty;
+        store.put(KEY_BRIGHTNESS, &brightness, 1);
+        store.put(KEY_DIFFICULTY, &difficulty, 1);
     }
     else
     {
@@ -293,140 +445,254 @@ int main()
         }
     }
 
-    // enabel interrupts
-    for (uint32_t gpio = 18; gpio <= 25; gpio++)
-    {
-        gpio_set_irq_enabled_with_callback(gpio, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &pin_callback);
-    }
-    gpio_set_irq_enabled_with_callback(PUSHBUTTON_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &pin_callback);
+    // start sampling button and switches
+    input_scanner.start();
 
     // set up tflite model
-    tflite::InitializeTarget();
-
-    // Map the model into a usable data structure. This doesn't involve any
-    // copying or parsing, it's a very lightweight operation.
-    model = tflite::GetModel(colordot_q_tfl_tflite);
-
-    if (model->version() != TFLITE_SCHEMA_VERSION)
-    {
-        printf(
-            "Model provided is schema version %d not equal "
-            "to supported version %d. \n",
-            model->version(), TFLITE_SCHEMA_VERSION);
-    }
-
-    static tflite::MicroMutableOpResolver<11> resolver;
-    TfLiteStatus resolve_status = resolver.AddFullyConnected();
-    resolve_status = resolver.AddReshape();
-    resolve_status = resolver.AddGatherNd();
-    resolve_status = resolver.AddSub();
-    resolve_status = resolver.AddSlice();
-    resolve_status = resolver.AddConv2D();
-    resolve_status = resolver.AddTranspose();
-    resolve_status = resolver.AddPad();
-    resolve_status = resolver.AddConcatenation();
-    resolve_status = resolver.AddMaxPool2D();
-    resolve_status = resolver.AddAdd();
-
-    if (resolve_status != kTfLiteOk)
-    {
-        printf("Op resolution failed \n");
-    }
-
-    // Build an interpreter to run the model with.
-    static tflite::MicroInterpreter static_interpreter(
-        model, resolver, tensor_arena, kTensorArenaSize);
-    interpreter = &static_interpreter;
-
-    // Allocate memory from the tensor_arena for the model's tensors.
-    TfLiteStatus allocate_status = interpreter->AllocateTensors();
-    if (allocate_status != kTfLiteOk)
+    // core 1 takes half of every large operator
+    worker_pool.start();
+    inference.set_worker_pool(&worker_pool);
+    // a move changes one row or column, the next hint only recomputes the
+    // convolution around it
+    inference.set_incremental(true);
+    inference.set_cancellation_token(&inference_cancel);
+#ifdef ROOFLINE_REPORT
+    inference.set_op_costs(op_costs, ROOFLINE_MAX_OPS);
+#endif
+    // without a model the exact search alone gives the hints it finds in time
+    bool model_loaded = load_model();
+    if ((model_loaded == true) && (inference.has_provisional_head() == true))
     {
-        printf("AllocateTensors() failed \n");
+        printf("model has an early-exit head, hints show early\n");
     }
 
-    // Obtain pointers to the model's input and output tensors.
-    input = interpreter->input(0);
-    output = interpreter->output(0);
-
     uint8_t hint_switch = 0;
-    int8_t max_score = -127;
-
-    state_changed = true;
-
-    // Loop forever
+    int8_t excluded_switch = -1;
+    int8_t scores[NUM_SWITCHES];
+    bool refining = false;
+    bool searching = false;
+    uint32_t solver_start_us = 0;
+    uint8_t switch_state[8];
+    Event event;
+
+    // run at the idle clock, score the starting position
+    governor.start();
+    request_inference();
+
+    // Run loop: handles the posted events in order and sleeps until the next
+    // event or keyframe change
     while (true)
     {
-        if (need_to_initialize == true)
+        if (events.pop(event) == false)
         {
-            // Initiates a new game by shuffling the dots, using a random seed based on the duration of the push button press
-            game.shuffle_dots(difficulty, timer_stop - timer_start);
-            update_display();
-            need_to_initialize = false;
-            game_started = true;
-            state_changed = true;
+            uint32_t now = now_ms();
+            if (animator.tick(now) == true)
+            {
+                update_display();
+            }
+            inference.report_arena_stats();
+#ifdef ROOFLINE_REPORT
+            // the kernels run at the boost clock
+            inference.report_op_costs(BOOST_CLOCK_KHZ / 1000);
+#endif
+            // erase ahead of the next rollover while nothing else runs
+            store.maintain();
+            uint32_t change_ms;
+            events.wait(animator.next_change(now, change_ms) ? change_ms - now : WAIT_FOREVER);
+            continue;
         }
 
-        if (game_finished == true)
+        switch (event.type)
         {
-            // play effect
-            sleep_ms(200);
-            display.off();
-            display.push_leds();
-            sleep_ms(150);
-            display.serialize_maze_inner(game.maze);
-            display.push_leds();
-            sleep_ms(150);
-            display.serialize_maze_middle(game.maze);
-            display.push_leds();
-            sleep_ms(150);
-            display.serialize_maze(game.maze);
-            display.push_leds();
-            sleep_ms(200);
-        }
+        case EVENT_SWITCH:
+            // user choosed different switch than recommended by AI
+            if (last_hint_switch != event.arg)
+            {
+                last_hint_switch = -1;
+            }
+            game.toggle_switch(event.arg);
+            game_moves++;
+            inference_retries = 0;
+            game_finished = false;
+            animator.stop(LAYER_FINISH);
+            if ((game.check_finish() == true) && (game_started == true))
+            {
+                // play effect until the next move or game
+                game_finished = true;
+                game_started = false;
+                record_game(now_ms() - game_start_ms);
+                animator.start(LAYER_FINISH, finish_sweep, finish_sweep_len, true, now_ms());
+            }
+            update_display();
+            request_inference();
+            break;
 
-        if ((state_changed == true) && (game_finished == false))
-        {
-            // start a new model inference
-            state_changed = false;
+        case EVENT_BUTTON_DOWN:
+            if (game_started == false)
+            {
+                timer_start = event.data;
+            }
+            break;
 
-            // prepare input
-            for (uint8_t i = 0; i < 36; i++)
+        case EVENT_BUTTON_UP:
+            if (game_started == false)
             {
-                input->data.i32[i] = game.maze[i / 6][i % 6];
+                // Initiates a new game by shuffling the dots, using a random seed based on the duration of the push button press
+                read_switches(switch_state);
+                game.shuffle_dots(difficulty, event.data - timer_start, switch_state);
+                game_start_ms = now_ms();
+                game_moves = 0;
+                inference_retries = 0;
+                game_started = true;
+                game_finished = false;
+                animator.stop(LAYER_FINISH);
+                update_display();
+                request_inference();
             }
+            else if (hint_ready == true)
+            {
+                show_hint(hint_switch);
+            }
+            else
+            {
+                // shown as soon as the inference has a hint for this board
+                hint_pending = true;
+            }
+            break;
 
-            TfLiteStatus invoke_status = interpreter->Invoke();
+        case EVENT_INFERENCE:
+            inference_queued = false;
+            if ((game_finished == true) || (game.check_finish() == true))
+            {
+                // no hint for the solved board, also the boot position before a game
+                inference_stale = false;
+                refining = false;
+                searching = false;
+                hint_pending = false;
+            }
+            else if (inference_stale == true)
+            {
+                // start a new model inference
+                inference_stale = false;
+                excluded_switch = last_hint_switch;
+                int8_t cached_switch = hint_cache.lookup(game.maze);
 
-            // get argmax on the output
-            max_score = -128;
-            for (uint8_t i = 0; i < 8; i++)
+                if (cached_switch >= 0)
+                {
+                    // exact optimal move near the solution, no inference needed
+                    hint_switch = cached_switch;
+                    last_hint_switch = hint_switch;
+                    hint_ready = true;
+                    refining = false;
+                    searching = false;
+                    hint_sources.cached++;
+                    trace_hint_sources();
+                }
+                else
+                {
+                    // the exact search races the inference, both advance a
+                    // slice per event; a model with an early-exit head gives
+                    // a provisional hint on the way
+                    governor.boost(time_us_32());
+                    solver.start(game.maze);
+                    solver_start_us = time_us_32();
+                    searching = true;
+                    refining = inference.begin(game.maze);
+                    if ((refining == false) && (model_loaded == true))
+                    {
+                        searching = false;
+                        retry_inference();
+                    }
+                }
+            }
+            else if ((refining == true) || (searching == true))
             {
-                if ((output->data.int8[i] > max_score) && (i != last_hint_switch))
+                // the exact search gets its own slice per event until its
+                // deadline, also after the inference finished; a proven
+                // optimal move ends the inference or replaces its hint
+                uint32_t slice_start = time_us_32();
+                if (searching == true)
+                {
+                    while ((solver.search(SOLVER_SLICE_NODES) == SOLVER_SEARCHING) &&
+                           (time_us_32() - slice_start < SOLVER_SLICE_US))
+                    {
+                    }
+                    searching = (solver.status() == SOLVER_SEARCHING) &&
+                                (time_us_32() - solver_start_us < SOLVER_DEADLINE_US);
+                }
+                if ((solver.status() == SOLVER_SOLVED) && (solver.best_switch() < 0))
+                {
+                    // solved with no move left, there is no hint to give
+                    refining = false;
+                    searching = false;
+                }
+                else if (solver.status() == SOLVER_SOLVED)
+                {
+                    hint_switch = solver.best_switch();
+                    last_hint_switch = hint_switch;
+                    hint_ready = true;
+                    if ((refining == true) || (model_loaded == false))
+                    {
+                        hint_sources.exact++;
+                    }
+                    else
+                    {
+                        hint_sources.replaced++;
+                    }
+                    refining = false;
+                    searching = false;
+                }
+                else if (refining == true)
+                {
+                    // one slice per event, input in between is handled first
+                    switch (inference.refine(scores, INFERENCE_SLICE_US))
+                    {
+                    case INFERENCE_RUNNING:
+                        break;
+                    case INFERENCE_PROVISIONAL:
+                        hint_switch = select_hint(scores, excluded_switch);
+                        hint_ready = true;
+                        break;
+                    case INFERENCE_DONE:
+                        hint_switch = select_hint(scores, excluded_switch);
+                        last_hint_switch = hint_switch;
+                        hint_ready = true;
+                        refining = false;
+                        hint_sources.network++;
+                        break;
+                    default:
+                        // cancelled by a move or failed, scores are not for this board
+                        refining = false;
+                        searching = false;
+                        retry_inference();
+                        break;
+                    }
+                }
+                else if ((searching == false) && (model_loaded == false))
+                {
+                    printf("search ran out of time, no hint for this board\n");
+                }
+                if ((refining == false) && (searching == false) && (inference_stale == false))
                 {
-                    max_score = output->data.int8[i];
-                    hint_switch = i;
+                    trace_hint_sources();
                 }
             }
-            last_hint_switch = hint_switch;
-        }
 
-        if (display_hint == true)
-        {
-            // display AI recommondation
-            if (hint_switch < 4)
+            if ((hint_pending == true) && (hint_ready == true))
             {
-                display.serialize_maze_hide_row(game.maze, hint_switch + 1);
+                show_hint(hint_switch);
+                hint_pending = false;
             }
-            else
+            if ((refining == true) || (searching == true))
             {
-                display.serialize_maze_hide_col(game.maze, hint_switch - 3);
+                events.post({EVENT_INFERENCE, 0, time_us_32()});
+                inference_queued = true;
             }
-            display.push_leds();
-            sleep_ms(250);
-            update_display();
-            display_hint = false;
+            else if (inference_queued == false)
+            {
+                governor.relax(time_us_32());
+            }
+            break;
         }
-        sleep_ms(10);
     }
 }
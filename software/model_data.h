@@ -18,4 +18,13 @@
  */
 
 extern const unsigned int colordot_q_tfl_tflite_len;
-extern const unsigned char colordot_q_tfl_tflite[];
\ No newline at end of file
+extern const unsigned char colordot_q_tfl_tflite[];
+// int4 weight variant, generated by tools/int4pack
+extern const unsigned int colordot_q_tfl_s4_tflite_len;
+extern const unsigned char colordot_q_tfl_s4_tflite[];
+
+#ifdef MODEL_WEIGHTS_INT4
+#define COLORDOT_MODEL colordot_q_tfl_s4_tflite
+#else
+#define COLORDOT_MODEL colordot_q_tfl_tflite
+#endif
@@ -0,0 +1,204 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "model_store.h"
+
+#include <cstring>
+
+#define MODEL_STORE_MAGIC 0x534D444Eu // "NDMS"
+#define MODEL_STATE_USABLE 0xFFFFFFFFu
+#define MODEL_STATE_REJECTED 0u
+
+static_assert(MODEL_SLOT_SIZE % STORE_SECTOR_SIZE == 0, "slots are erased by sector");
+static_assert(sizeof(ModelSlotHeader) <= MODEL_HEADER_BYTES, "the header fits before the blob");
+
+// reflected, polynomial 0xEDB88320, chained by passing the previous result
+uint32_t model_crc32(const uint8_t *bytes, size_t len, uint32_t crc)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc ^= bytes[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t header_crc(const ModelSlotHeader *header)
+{
+    return model_crc32((const uint8_t *)header, offsetof(ModelSlotHeader, header_crc));
+}
+
+ModelStore::ModelStore(FlashDriver &flash) : flash(flash)
+{
+    memset(this->slot_role, 0, sizeof(this->slot_role));
+}
+
+uint8_t ModelStore::mount()
+{
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        const ModelSlotHeader *header = this->header(slot);
+        this->slot_role[slot] = this->header_valid(header) ? header->role : 0;
+        count += this->usable(slot);
+    }
+    return count;
+}
+
+int8_t ModelStore::select(uint8_t role, uint8_t skipped)
+{
+    int8_t newest = -1;
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        if ((this->slot_role[slot] == role) && (((skipped >> slot) & 1) == 0) && (this->usable(slot) == true) &&
+            ((newest < 0) || (this->header(slot)->version > this->header(newest)->version)))
+        {
+            newest = slot;
+        }
+    }
+    return newest;
+}
+
+const unsigned char *ModelStore::model(uint8_t slot)
+{
+    if (this->usable(slot) == false)
+    {
+        return nullptr;
+    }
+    return this->flash.data(slot * MODEL_SLOT_SIZE + MODEL_HEADER_BYTES);
+}
+
+const ModelSlotHeader *ModelStore::header(uint8_t slot)
+{
+    return (const ModelSlotHeader *)this->flash.data(slot * MODEL_SLOT_SIZE);
+}
+
+bool ModelStore::usable(uint8_t slot)
+{
+    return (slot < MODEL_STORE_SLOTS) && (this->slot_role[slot] != 0) &&
+           (this->header(slot)->state == MODEL_STATE_USABLE);
+}
+
+bool ModelStore::verify(uint8_t slot)
+{
+    if (this->usable(slot) == false)
+    {
+        return false;
+    }
+    const ModelSlotHeader *header = this->header(slot);
+    return model_crc32(this->model(slot), header->length) == header->crc;
+}
+
+void ModelStore::reject(uint8_t slot)
+{
+    if (this->usable(slot) == false)
+    {
+        return;
+    }
+    // clearing bits needs no erase, the header CRC stays valid
+    uint32_t state = MODEL_STATE_REJECTED;
+    this->flash.program(slot * MODEL_SLOT_SIZE + offsetof(ModelSlotHeader, state), (const uint8_t *)&state,
+                        sizeof(state));
+}
+
+int8_t ModelStore::install(uint8_t role, uint32_t version, const uint8_t *blob, size_t len, const char *name)
+{
+    int8_t slot = this->target_slot();
+    if ((role == 0) || (len == 0) || (len > MODEL_MAX_BYTES) || (slot < 0))
+    {
+        return -1;
+    }
+    this->slot_role[slot] = 0;
+    uint32_t start = slot * MODEL_SLOT_SIZE;
+    uint32_t end = start + MODEL_HEADER_BYTES + len;
+    for (uint32_t sector = start; sector < end; sector += STORE_SECTOR_SIZE)
+    {
+        this->flash.erase(sector);
+    }
+
+    // blob first and read back, the header commits it
+    ModelSlotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MODEL_STORE_MAGIC;
+    header.version = version;
+    header.length = len;
+    header.crc = model_crc32(blob, len);
+    header.role = role;
+    if (name != nullptr)
+    {
+        strncpy(header.name, name, MODEL_NAME_LEN);
+    }
+    header.header_crc = header_crc(&header);
+    header.state = MODEL_STATE_USABLE;
+    this->flash.program(start + MODEL_HEADER_BYTES, blob, len);
+    if (model_crc32(this->flash.data(start + MODEL_HEADER_BYTES), len) != header.crc)
+    {
+        return -1;
+    }
+    this->flash.program(start, (const uint8_t *)&header, sizeof(header));
+    if (this->header_valid(this->header(slot)) == false)
+    {
+        return -1;
+    }
+    this->slot_role[slot] = role;
+    return slot;
+}
+
+uint32_t ModelStore::newest_version(uint8_t role)
+{
+    uint32_t newest = 0;
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        if ((this->slot_role[slot] == role) && (this->header(slot)->version > newest))
+        {
+            newest = this->header(slot)->version;
+        }
+    }
+    return newest;
+}
+
+bool ModelStore::header_valid(const ModelSlotHeader *header)
+{
+    return (header->magic == MODEL_STORE_MAGIC) && (header->role != 0) && (header->length > 0) &&
+           (header->length <= MODEL_MAX_BYTES) && (header->header_crc == header_crc(header));
+}
+
+int8_t ModelStore::target_slot()
+{
+    // an unused or rejected slot, otherwise the oldest model that is not the
+    // active one of its role
+    int8_t oldest = -1;
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        if (this->usable(slot) == false)
+        {
+            return slot;
+        }
+        if ((this->select(this->slot_role[slot]) != slot) &&
+            ((oldest < 0) || (this->header(slot)->version < this->header(oldest)->version)))
+        {
+            oldest = slot;
+        }
+    }
+    return oldest;
+}
@@ -0,0 +1,102 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MODEL_STORE_H
+#define MODEL_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "store.h"
+
+#define MODEL_STORE_SLOTS 4
+// bytes per slot, whole sectors
+#define MODEL_SLOT_SIZE (64 * 1024)
+#define MODEL_STORE_BYTES (MODEL_STORE_SLOTS * MODEL_SLOT_SIZE)
+// the blob starts one flash page into its slot, aligned for the flatbuffer
+#define MODEL_HEADER_BYTES 256
+#define MODEL_MAX_BYTES (MODEL_SLOT_SIZE - MODEL_HEADER_BYTES)
+#define MODEL_NAME_LEN 16
+
+// what a stored model is used for, every role has its own A/B slots
+enum ModelRole
+{
+  MODEL_ROLE_HINT = 1,
+  MODEL_ROLE_SMALL = 2, // first stage of a ModelCascade
+};
+
+// Start of every slot. header_crc covers the fields before it, state is
+// programmed to 0 when the model is rejected and is not covered.
+struct ModelSlotHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t length;
+  uint32_t crc; // CRC-32 of the blob
+  uint8_t role;
+  uint8_t reserved[3];
+  char name[MODEL_NAME_LEN]; // not terminated at full length
+  uint32_t header_crc;
+  uint32_t state;
+};
+
+// CRC-32 (IEEE), of the blobs and the headers
+uint32_t model_crc32(const uint8_t *bytes, size_t len, uint32_t crc = 0);
+
+// Versioned .tflite blobs in MODEL_STORE_SLOTS slots of the flash, read in
+// place: model() points into the memory mapped flash (XIP on the Pico), so
+// tflite::GetModel() needs no copy. mount() reads the slot headers only, the
+// blob CRC is checked once by install() and on demand by verify(). The
+// newest usable slot of a role is the active one (A), the one before stays as
+// fallback (B) until the next install of the role overwrites the older.
+// install() writes the header last, a power loss before leaves the slot
+// unused and the previous model active.
+class ModelStore
+{
+public:
+  ModelStore(FlashDriver &flash);
+  // reads the slot headers, returns the number of usable slots
+  uint8_t mount();
+  // newest usable slot of role that is not in the skipped mask (bit per
+  // slot), -1 if there is none
+  int8_t select(uint8_t role, uint8_t skipped = 0);
+  // blob of a usable slot, nullptr otherwise
+  const unsigned char *model(uint8_t slot);
+  const ModelSlotHeader *header(uint8_t slot);
+  bool usable(uint8_t slot);
+  // compares the blob against its CRC, reads the whole slot
+  bool verify(uint8_t slot);
+  // marks a damaged model for good, select() falls back to the previous one
+  void reject(uint8_t slot);
+  // writes the model into an unused slot or the oldest one no role has
+  // active, returns the slot or -1 if none is free or the blob is too large
+  int8_t install(uint8_t role, uint32_t version, const uint8_t *blob, size_t len, const char *name = nullptr);
+  // highest version of role in a valid header, rejected ones included, 0 if none
+  uint32_t newest_version(uint8_t role);
+
+private:
+  FlashDriver &flash;
+  // header fields checked, 0: not usable
+  uint8_t slot_role[MODEL_STORE_SLOTS];
+
+  bool header_valid(const ModelSlotHeader *header);
+  int8_t target_slot();
+};
+
+#endif // MODEL_STORE_H
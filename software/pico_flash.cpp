@@ -0,0 +1,64 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pico_flash.h"
+
+#include <cstring>
+
+#include "pico/stdlib.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+static_assert(STORE_SECTOR_SIZE == FLASH_SECTOR_SIZE, "store sectors have to match the flash erase size");
+
+PicoFlash::PicoFlash(uint32_t flash_offset)
+{
+    this->flash_offset = flash_offset;
+}
+
+const uint8_t *PicoFlash::data(uint32_t offset)
+{
+    return (const uint8_t *)(XIP_BASE + this->flash_offset + offset);
+}
+
+void PicoFlash::program(uint32_t offset, const uint8_t *bytes, size_t len)
+{
+    // whole pages only, 0xFF leaves the bytes around the record untouched
+    uint8_t page[FLASH_PAGE_SIZE];
+    uint32_t start = this->flash_offset + offset;
+    uint32_t end = start + len;
+    for (uint32_t page_start = start & ~(FLASH_PAGE_SIZE - 1); page_start < end; page_start += FLASH_PAGE_SIZE)
+    {
+        uint32_t from = page_start > start ? page_start : start;
+        uint32_t to = page_start + FLASH_PAGE_SIZE < end ? page_start + FLASH_PAGE_SIZE : end;
+        memset(page, 0xFF, FLASH_PAGE_SIZE);
+        memcpy(page + (from - page_start), bytes + (from - start), to - from);
+
+        uint32_t ints = save_and_disable_interrupts();
+        flash_range_program(page_start, page, FLASH_PAGE_SIZE);
+        restore_interrupts(ints);
+    }
+}
+
+void PicoFlash::erase(uint32_t offset)
+{
+    uint32_t ints = save_and_disable_interrupts();
+    flash_range_erase(this->flash_offset + offset, FLASH_SECTOR_SIZE);
+    restore_interrupts(ints);
+}
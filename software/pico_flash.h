@@ -0,0 +1,39 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PICO_FLASH_H
+#define PICO_FLASH_H
+
+#include "store.h"
+
+// FlashDriver on the on-board flash at flash_offset. Programming and erasing
+// stall the XIP bus, both run with interrupts disabled.
+class PicoFlash : public FlashDriver
+{
+public:
+  PicoFlash(uint32_t flash_offset);
+  const uint8_t *data(uint32_t offset) override;
+  void program(uint32_t offset, const uint8_t *bytes, size_t len) override;
+  void erase(uint32_t offset) override;
+
+private:
+  uint32_t flash_offset;
+};
+
+#endif // PICO_FLASH_H
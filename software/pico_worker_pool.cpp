@@ -0,0 +1,87 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "pico_worker_pool.h"
+
+#include "pico/multicore.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+// the part core 1 runs next, written by core 0 before the FIFO entry
+static volatile tflite::MicroWorkerPool::Task core1_task = nullptr;
+static void *volatile core1_data = nullptr;
+static volatile int core1_num_parts = 0;
+
+// Only the part itself runs from flash. Between parts core 1 sleeps here with
+// nothing but SIO accesses, so flash writes on core 0 cannot stall it.
+static void __not_in_flash_func(core1_loop)()
+{
+    while (true)
+    {
+        while (multicore_fifo_rvalid() == false)
+        {
+            __wfe();
+        }
+        (void)sio_hw->fifo_rd;
+        core1_task(core1_data, 1, core1_num_parts);
+        while (multicore_fifo_wready() == false)
+        {
+        }
+        sio_hw->fifo_wr = 0;
+        __sev();
+    }
+}
+
+PicoWorkerPool::PicoWorkerPool() : tflite::MicroWorkerPool(PICO_MIN_WORK_PER_CORE)
+{
+    this->started = false;
+}
+
+void PicoWorkerPool::start()
+{
+    multicore_launch_core1(core1_loop);
+    this->started = true;
+}
+
+int PicoWorkerPool::num_workers() const
+{
+    return 2;
+}
+
+void PicoWorkerPool::Run(Task task, void *data, int num_parts)
+{
+    if ((this->started == false) || (num_parts < 2))
+    {
+        for (int part = 0; part < num_parts; part++)
+        {
+            task(data, part, num_parts);
+        }
+        return;
+    }
+    core1_task = task;
+    core1_data = data;
+    core1_num_parts = num_parts;
+    // the arguments are written before core 1 sees the FIFO entry
+    __dmb();
+    multicore_fifo_push_blocking(1);
+    task(data, 0, num_parts);
+    // barrier: the next operator reads the output of both parts
+    multicore_fifo_pop_blocking();
+    __dmb();
+}
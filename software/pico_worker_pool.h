@@ -0,0 +1,45 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PICO_WORKER_POOL_H
+#define PICO_WORKER_POOL_H
+
+#include "tensorflow/lite/micro/micro_worker_pool.h"
+
+// one inner-loop step of an M0+ kernel is several cycles, the hand-over
+// through the inter-core FIFO well under a hundred
+#define PICO_MIN_WORK_PER_CORE 512
+
+// MicroWorkerPool over both RP2040 cores: part 0 runs on the calling core 0,
+// part 1 on core 1, which waits for the next part in SRAM so that core 0 can
+// program the flash between two inferences.
+class PicoWorkerPool : public tflite::MicroWorkerPool
+{
+public:
+  PicoWorkerPool();
+  // launches the worker loop on core 1
+  void start();
+  int num_workers() const override;
+  void Run(Task task, void *data, int num_parts) override;
+
+private:
+  bool started;
+};
+
+#endif // PICO_WORKER_POOL_H
@@ -0,0 +1,100 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "renderer.h"
+
+#include "game.h"
+
+// board cell (6 * row + col) of every pixel, the serpentine of the game tables
+static constexpr const uint8_t (&pixel_cell)[NUM_PIXELS] = Game::tables.pixel_cell;
+
+Renderer::Renderer()
+{
+    for (uint8_t i = 0; i < NUM_COLOURS; i++)
+    {
+        this->palette[i] = 0;
+    }
+    for (uint8_t i = 0; i < NUM_PIXELS; i++)
+    {
+        this->colours[i] = 0;
+        this->words[i] = 0;
+    }
+    this->is_dirty = true;
+}
+
+void Renderer::set_palette(uint8_t colour, uint32_t grb)
+{
+    if (this->palette[colour] == grb)
+    {
+        return;
+    }
+    this->palette[colour] = grb;
+    for (uint8_t i = 0; i < NUM_PIXELS; i++)
+    {
+        if (this->colours[i] == colour)
+        {
+            this->words[i] = grb;
+            this->is_dirty = true;
+        }
+    }
+}
+
+uint32_t Renderer::diff(const Board frame, uint64_t mask) const
+{
+    const uint8_t *cells = &frame[0][0];
+    uint32_t changed = 0;
+    for (uint8_t i = 0; i < NUM_PIXELS; i++)
+    {
+        uint8_t cell = pixel_cell[i];
+        uint8_t colour = (mask >> cell) & 1 ? cells[cell] : 0;
+        changed |= (uint32_t)(colour != this->colours[i]) << i;
+    }
+    return changed;
+}
+
+uint32_t Renderer::render(const Board frame, uint64_t mask)
+{
+    const uint8_t *cells = &frame[0][0];
+    uint32_t changed = this->diff(frame, mask);
+    for (uint32_t pending = changed; pending != 0; pending &= pending - 1)
+    {
+        uint8_t i = __builtin_ctz(pending);
+        uint8_t cell = pixel_cell[i];
+        this->colours[i] = (mask >> cell) & 1 ? cells[cell] : 0;
+        this->words[i] = this->palette[this->colours[i]];
+    }
+    this->is_dirty |= changed != 0;
+    return changed;
+}
+
+void Renderer::invalidate()
+{
+    this->is_dirty = true;
+}
+
+bool Renderer::dirty() const
+{
+    return this->is_dirty;
+}
+
+const uint32_t *Renderer::take_words()
+{
+    this->is_dirty = false;
+    return this->words;
+}
@@ -0,0 +1,55 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <cstdint>
+
+#include "board.h"
+
+#define NUM_PIXELS 32
+#define NUM_COLOURS 8
+
+// Encodes board frames into the GRB words of the LED chain. Only pixels
+// whose colour changed are re-encoded, and the chain is only dirty when a
+// word changed since the last take_words().
+class Renderer
+{
+public:
+  Renderer();
+  void set_palette(uint8_t colour, uint32_t grb);
+  // pixels (bit i for pixel i) that render() would change
+  uint32_t diff(const Board frame, uint64_t mask = ALL_CELLS_MASK) const;
+  // cells outside mask are dark, returns the changed pixels
+  uint32_t render(const Board frame, uint64_t mask = ALL_CELLS_MASK);
+  // the LEDs no longer show the last words, resend them on the next push
+  void invalidate();
+  bool dirty() const;
+  // words of the whole chain, clears dirty
+  const uint32_t *take_words();
+
+private:
+  uint32_t palette[NUM_COLOURS];
+  uint8_t colours[NUM_PIXELS];
+  uint32_t words[NUM_PIXELS];
+  bool is_dirty;
+};
+
+#endif // RENDERER_H
@@ -0,0 +1,188 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "scheduler.h"
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#else
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+static std::mutex queue_mutex;
+static std::condition_variable queue_posted;
+#endif
+
+EventQueue::EventQueue()
+{
+    this->head = 0;
+    this->tail = 0;
+    this->drops = 0;
+}
+
+bool EventQueue::post(Event event)
+{
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    // the loop posts too, keep the scanner interrupt out while the slot is claimed
+    uint32_t ints = save_and_disable_interrupts();
+#else
+    std::lock_guard<std::mutex> lock(queue_mutex);
+#endif
+    bool posted = this->head - this->tail < EVENT_QUEUE_SIZE;
+    if (posted == true)
+    {
+        this->events[this->head % EVENT_QUEUE_SIZE] = event;
+        this->head = this->head + 1;
+    }
+    else
+    {
+        this->drops = this->drops + 1;
+    }
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    restore_interrupts(ints);
+    // wakes a WFE that started between the empty() check and the post
+    __sev();
+#else
+    queue_posted.notify_one();
+#endif
+    return posted;
+}
+
+bool EventQueue::pop(Event &event)
+{
+#if !(defined(PICO_ON_DEVICE) && PICO_ON_DEVICE)
+    std::lock_guard<std::mutex> lock(queue_mutex);
+#endif
+    if (this->head == this->tail)
+    {
+        return false;
+    }
+    event = this->events[this->tail % EVENT_QUEUE_SIZE];
+    this->tail = this->tail + 1;
+    return true;
+}
+
+bool EventQueue::empty()
+{
+    return this->head == this->tail;
+}
+
+void EventQueue::wait(uint32_t timeout_ms)
+{
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    if (this->empty() == false)
+    {
+        return;
+    }
+    // any interrupt wakes the core as well, the caller loops
+    if (timeout_ms == WAIT_FOREVER)
+    {
+        __wfe();
+    }
+    else
+    {
+        best_effort_wfe_or_timeout(make_timeout_time_ms(timeout_ms));
+    }
+#else
+    std::unique_lock<std::mutex> lock(queue_mutex);
+    auto posted = [this]
+    { return this->head != this->tail; };
+    if (timeout_ms == WAIT_FOREVER)
+    {
+        queue_posted.wait(lock, posted);
+    }
+    else
+    {
+        queue_posted.wait_for(lock, std::chrono::milliseconds(timeout_ms), posted);
+    }
+#endif
+}
+
+uint32_t EventQueue::dropped()
+{
+    return this->drops;
+}
+
+Governor::Governor(uint32_t idle_khz, uint32_t boost_khz, clock_setter_t set_clock)
+{
+    this->idle_khz = idle_khz;
+    this->boost_khz = boost_khz;
+    this->set_clock = set_clock;
+    this->is_boosted = false;
+    this->clock_switches = 0;
+    this->boost_start_us = 0;
+    this->boost_total_us = 0;
+}
+
+void Governor::start()
+{
+    this->set_clock(this->idle_khz);
+    this->is_boosted = false;
+}
+
+void Governor::boost(uint32_t now_us)
+{
+    if (this->is_boosted == true)
+    {
+        return;
+    }
+    this->set_clock(this->boost_khz);
+    this->is_boosted = true;
+    this->clock_switches++;
+    this->boost_start_us = now_us;
+}
+
+void Governor::relax(uint32_t now_us)
+{
+    if (this->is_boosted == false)
+    {
+        return;
+    }
+    this->set_clock(this->idle_khz);
+    this->is_boosted = false;
+    this->clock_switches++;
+    this->boost_total_us += now_us - this->boost_start_us;
+}
+
+bool Governor::boosted()
+{
+    return this->is_boosted;
+}
+
+uint32_t Governor::khz()
+{
+    return this->is_boosted ? this->boost_khz : this->idle_khz;
+}
+
+uint32_t Governor::switches()
+{
+    return this->clock_switches;
+}
+
+uint64_t Governor::boosted_us(uint32_t now_us)
+{
+    uint64_t total = this->boost_total_us;
+    if (this->is_boosted == true)
+    {
+        total += now_us - this->boost_start_us;
+    }
+    return total;
+}
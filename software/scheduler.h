@@ -0,0 +1,95 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <cstdint>
+
+#define EVENT_QUEUE_SIZE 32 // power of two
+#define WAIT_FOREVER UINT32_MAX
+
+enum EventType
+{
+  EVENT_SWITCH,      // arg: switch index
+  EVENT_BUTTON_DOWN, // data: time_us_32() of the edge
+  EVENT_BUTTON_UP,   // data: time_us_32() of the edge
+  EVENT_INFERENCE,   // next step of the hint inference
+};
+
+struct Event
+{
+  uint8_t type;
+  uint8_t arg;
+  uint32_t data;
+};
+
+// Fixed size event queue between the interrupt handlers and the run loop.
+// post() may be called from interrupts and from the loop itself, pop() and
+// wait() only from the loop. wait() sleeps the core (WFE on the Pico, a
+// condition variable on the host) until an event is posted or the timeout
+// ran out.
+class EventQueue
+{
+public:
+  EventQueue();
+  // false if the queue is full, the event is dropped and counted
+  bool post(Event event);
+  bool pop(Event &event);
+  bool empty();
+  void wait(uint32_t timeout_ms);
+  uint32_t dropped();
+
+private:
+  Event events[EVENT_QUEUE_SIZE];
+  volatile uint32_t head; // next slot to write
+  volatile uint32_t tail; // next slot to read
+  volatile uint32_t drops;
+};
+
+typedef void (*clock_setter_t)(uint32_t khz);
+
+// Runs the system clock at idle_khz and raises it to boost_khz while the
+// inference runs. The clock is changed through a callback, so the governor
+// also drives the host simulation.
+class Governor
+{
+public:
+  Governor(uint32_t idle_khz, uint32_t boost_khz, clock_setter_t set_clock);
+  // applies the idle clock
+  void start();
+  void boost(uint32_t now_us);
+  void relax(uint32_t now_us);
+  bool boosted();
+  uint32_t khz();
+  uint32_t switches();
+  // time spent at the boost clock up to now_us
+  uint64_t boosted_us(uint32_t now_us);
+
+private:
+  uint32_t idle_khz;
+  uint32_t boost_khz;
+  clock_setter_t set_clock;
+  bool is_boosted;
+  uint32_t clock_switches;
+  uint32_t boost_start_us;
+  uint64_t boost_total_us;
+};
+
+#endif // SCHEDULER_H
@@ -0,0 +1,225 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "solver.h"
+
+#include "game.h"
+
+#define ROW_FIELD 0x3FFFFull              // 6 cells of a row in a packed word
+#define CELL_LOW_BITS 0x9249249249249ull  // lowest bit of the 18 cells of a packed word
+
+// moves work on the bits of a PackedBoard, which only holds the device board
+static_assert((Game::HEIGHT == 6) && (Game::WIDTH == 6), "packed moves need a 6 x 6 board");
+
+// cell value on the packed bits
+static inline uint8_t packed_cell(const PackedBoard &board, uint8_t row, uint8_t col)
+{
+    uint64_t word = row < 3 ? board.lo : board.hi;
+    return (word >> (3 * ((row % 3) * 6 + col))) & 0x7;
+}
+
+PackedBoard packed_toggle_switch(const PackedBoard &board, uint8_t sw)
+{
+    PackedBoard moved = board;
+    if (sw < 4)
+    {
+        // a row stays within one word, shifting right moves its cells to higher bits
+        uint8_t row = 1 + sw;
+        uint64_t &word = row < 3 ? moved.lo : moved.hi;
+        uint8_t offset = 18 * (row % 3);
+        uint64_t field = (word >> offset) & ROW_FIELD;
+        field = packed_cell(board, row, 0) != 0 ? (field << 3) & ROW_FIELD : field >> 3;
+        word = (word & ~(ROW_FIELD << offset)) | (field << offset);
+    }
+    else
+    {
+        // a column crosses from row 2 in lo to row 3 in hi
+        uint8_t col = sw - 3;
+        uint64_t mask = (0x7ull << (3 * col)) * 0x1000040001ull; // rows 0..2 (3..5 in hi) of the column
+        uint64_t lo = board.lo & mask;
+        uint64_t hi = board.hi & mask;
+        if (packed_cell(board, 0, col) != 0)
+        {
+            // shift down, the cell of row 2 moves on to row 3
+            uint64_t carry = (lo >> (36 + 3 * col)) & 0x7;
+            moved.lo = (board.lo & ~mask) | ((lo << 18) & mask);
+            moved.hi = (board.hi & ~mask) | ((hi << 18) & mask) | (carry << (3 * col));
+        }
+        else
+        {
+            // shift up, the cell of row 3 moves on to row 2
+            uint64_t carry = (hi >> (3 * col)) & 0x7;
+            moved.lo = (board.lo & ~mask) | (lo >> 18) | (carry << (36 + 3 * col));
+            moved.hi = (board.hi & ~mask) | (hi >> 18);
+        }
+    }
+    return moved;
+}
+
+Solver::Solver(HintCache &cache) : cache(cache)
+{
+    Game solved = Game();
+    this->goal = pack_board(solved.maze);
+    this->top = 0;
+    this->bound = 0;
+    this->next_bound = 0;
+    this->state = SOLVER_IDLE;
+    this->solution_switch = -1;
+    this->expanded = 0;
+}
+
+uint8_t Solver::heuristic(const PackedBoard &board, bool &exact)
+{
+    // misplaced cells, one bit per cell at 6 * row + col as in board.h
+    uint64_t lo = board.lo ^ this->goal.lo;
+    uint64_t hi = board.hi ^ this->goal.hi;
+    lo = (lo | (lo >> 1) | (lo >> 2)) & CELL_LOW_BITS;
+    hi = (hi | (hi >> 1) | (hi >> 2)) & CELL_LOW_BITS;
+    uint64_t misplaced = 0;
+    for (uint8_t i = 0; i < 18; i++)
+    {
+        misplaced |= ((lo >> (3 * i)) & 1) << i;
+        misplaced |= ((hi >> (3 * i)) & 1) << (18 + i);
+    }
+
+    uint8_t forced = (((misplaced >> 1) | (misplaced >> 31)) & 0xF) << 4;
+    uint8_t switched = 0;
+    uint8_t cells[4];
+    for (uint8_t line = 0; line < 4; line++)
+    {
+        uint8_t row = 1 + line;
+        forced |= (((misplaced >> (6 * row)) | (misplaced >> (6 * row + 5))) & 1) << line;
+        cells[line] = (misplaced >> (6 * row + 1)) & 0xF;
+        switched |= (packed_cell(board, row, 0) == 0) << line;
+        switched |= (packed_cell(board, 0, row) == 0) << (4 + line);
+    }
+    uint8_t bound = line_cover_bound(forced, switched, cells);
+
+    exact = false;
+    if (bound > this->cache.depth())
+    {
+        return bound;
+    }
+    Board maze;
+    unpack_board(board, maze);
+    int8_t distance = this->cache.distance(maze);
+    if (distance >= 0)
+    {
+        exact = true;
+        return distance;
+    }
+    // not in the cache, so further away than its depth
+    return bound > this->cache.depth() + 1 ? bound : this->cache.depth() + 1;
+}
+
+void Solver::restart(uint8_t new_bound)
+{
+    this->bound = new_bound;
+    this->next_bound = UINT8_MAX;
+    this->top = 0;
+    this->stack[0].next_switch = 0;
+    this->state = new_bound <= SOLVER_MAX_DEPTH ? SOLVER_SEARCHING : SOLVER_GAVE_UP;
+}
+
+void Solver::start(const Board maze)
+{
+    this->stack[0] = {pack_board(maze), -1, 0};
+    this->solution_switch = -1;
+    this->expanded = 0;
+    bool exact;
+    uint8_t h = this->heuristic(this->stack[0].board, exact);
+    if (exact == true)
+    {
+        // near the solution the cache has the answer already
+        this->bound = h;
+        this->solution_switch = this->cache.lookup(maze);
+        this->state = SOLVER_SOLVED;
+        return;
+    }
+    this->restart(h);
+}
+
+SolverStatus Solver::search(uint32_t max_nodes)
+{
+    while ((this->state == SOLVER_SEARCHING) && (max_nodes > 0))
+    {
+        Frame &frame = this->stack[this->top];
+        if (frame.next_switch == 8)
+        {
+            if (this->top > 0)
+            {
+                this->top--;
+            }
+            else
+            {
+                // no solution within bound, the next iteration goes as far as the closest cut-off
+                this->restart(this->next_bound);
+            }
+            continue;
+        }
+        uint8_t sw = frame.next_switch++;
+        if (sw == frame.last_switch)
+        {
+            continue;
+        }
+
+        max_nodes--;
+        this->expanded++;
+        PackedBoard child = packed_toggle_switch(frame.board, sw);
+        bool exact;
+        uint8_t cost = this->top + 1 + this->heuristic(child, exact);
+        if (cost > this->bound)
+        {
+            this->next_bound = cost < this->next_bound ? cost : this->next_bound;
+        }
+        else if (exact == true)
+        {
+            // All paths shorter than bound were ruled out before, so this one is optimal
+            this->bound = cost;
+            this->solution_switch = this->top == 0 ? sw : this->stack[1].last_switch;
+            this->state = SOLVER_SOLVED;
+        }
+        else
+        {
+            this->top++;
+            this->stack[this->top] = {child, (int8_t)sw, 0};
+        }
+    }
+    return this->state;
+}
+
+SolverStatus Solver::status()
+{
+    return this->state;
+}
+
+int8_t Solver::best_switch()
+{
+    return this->state == SOLVER_SOLVED ? this->solution_switch : -1;
+}
+
+uint8_t Solver::distance()
+{
+    return this->bound;
+}
+
+uint32_t Solver::nodes()
+{
+    return this->expanded;
+}
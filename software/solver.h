@@ -0,0 +1,85 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstdint>
+
+#include "board.h"
+#include "hint_cache.h"
+
+// deepest search, bounds the explicit stack to SOLVER_MAX_DEPTH + 1 frames
+#define SOLVER_MAX_DEPTH 24
+
+enum SolverStatus
+{
+  SOLVER_IDLE,
+  SOLVER_SEARCHING,
+  SOLVER_SOLVED,  // best_switch() is a proven optimal move
+  SOLVER_GAVE_UP, // the solution is more than SOLVER_MAX_DEPTH moves away
+};
+
+// Exact search for the optimal move with IDA*, run in slices of expanded
+// nodes so it can race the inference. Boards are bit-packed and moved on the
+// packed bits. The heuristic is line_cover_bound(), and the hint cache in
+// flash for boards near the solution: it gives their exact distance, and a
+// miss proves a board to be more than its depth away. The search path is an
+// explicit stack of fixed size, no recursion and no allocation.
+class Solver
+{
+public:
+  Solver(HintCache &cache);
+  void start(const Board maze);
+  // expands up to max_nodes boards and returns the status after them
+  SolverStatus search(uint32_t max_nodes);
+  SolverStatus status();
+  // optimal first move once solved, -1 before
+  int8_t best_switch();
+  // optimal number of moves once solved, the proven lower bound before
+  uint8_t distance();
+  // boards expanded since start()
+  uint32_t nodes();
+
+private:
+  struct Frame
+  {
+    PackedBoard board;
+    int8_t last_switch;  // move that led here, not undone right away
+    uint8_t next_switch; // next child to expand
+  };
+
+  HintCache &cache;
+  PackedBoard goal;
+  Frame stack[SOLVER_MAX_DEPTH + 1];
+  int8_t top;
+  uint8_t bound;
+  uint8_t next_bound;
+  SolverStatus state;
+  int8_t solution_switch;
+  uint32_t expanded;
+
+  uint8_t heuristic(const PackedBoard &board, bool &exact);
+  void restart(uint8_t new_bound);
+};
+
+// the board after a move, on the packed bits
+PackedBoard packed_toggle_switch(const PackedBoard &board, uint8_t sw);
+
+#endif // SOLVER_H
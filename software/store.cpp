@@ -0,0 +1,280 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "store.h"
+
+#include <cstring>
+
+#define STORE_MAGIC 0x564B444Eu // "NDKV"
+#define SECTOR_HEADER_BYTES 8
+#define RECORD_HEADER_BYTES 4
+#define KEY_COMMIT 0xFE // ends the snapshot at the start of a sector
+#define KEY_ERASED 0xFF
+
+// Sector: magic and sequence number (4 bytes each, little endian), then the
+// records. Record: key, value length, CRC-16 of key, length and value, then
+// the value padded to 4 bytes. A record that fails its CRC was torn by a
+// power loss, nothing is appended behind it.
+
+static uint32_t record_bytes(uint8_t len)
+{
+    return RECORD_HEADER_BYTES + ((len + 3u) & ~3u);
+}
+
+// CRC-16/CCITT-FALSE
+static uint16_t record_crc(uint8_t key, uint8_t len, const uint8_t *value)
+{
+    uint16_t crc = 0xFFFF;
+    uint8_t header[2] = {key, len};
+    for (uint32_t i = 0; i < 2u + len; i++)
+    {
+        crc ^= (uint16_t)(i < 2 ? header[i] : value[i - 2]) << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint32_t read_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+KvStore::KvStore(FlashDriver &flash) : flash(flash)
+{
+    memset(this->entries, 0, sizeof(this->entries));
+    this->active = 0;
+    this->seq = 0;
+    this->write_offset = STORE_SECTOR_SIZE;
+    this->spare_erased = false;
+}
+
+bool KvStore::mount()
+{
+    // newest committed sector first, an interrupted rollover leaves a newer
+    // sector without commit behind and the previous one is still complete
+    uint32_t tried = 0;
+    for (uint8_t attempt = 0; attempt < STORE_SECTORS; attempt++)
+    {
+        int8_t newest = -1;
+        uint32_t newest_seq = 0;
+        for (uint8_t sector = 0; sector < STORE_SECTORS; sector++)
+        {
+            const uint8_t *header = this->flash.data(sector * STORE_SECTOR_SIZE);
+            uint32_t sector_seq = read_u32(header + 4);
+            if ((read_u32(header) == STORE_MAGIC) && ((tried >> sector & 1) == 0) &&
+                ((newest < 0) || (sector_seq > newest_seq)))
+            {
+                newest = sector;
+                newest_seq = sector_seq;
+            }
+        }
+        if (newest < 0)
+        {
+            break;
+        }
+        tried |= 1u << newest;
+
+        Entry found[STORE_MAX_KEYS] = {};
+        uint32_t end;
+        if (this->scan(newest, found, end) == true)
+        {
+            memcpy(this->entries, found, sizeof(this->entries));
+            this->active = newest;
+            this->seq = newest_seq;
+            this->write_offset = end;
+            this->spare_erased = false;
+            return true;
+        }
+    }
+    memset(this->entries, 0, sizeof(this->entries));
+    this->write_offset = STORE_SECTOR_SIZE;
+    return false;
+}
+
+void KvStore::format()
+{
+    this->flash.erase(0);
+    memset(this->entries, 0, sizeof(this->entries));
+    this->open_sector(0, 1);
+    this->append(KEY_COMMIT, nullptr, 0);
+    this->spare_erased = false;
+}
+
+bool KvStore::get(uint8_t key, void *value, size_t len)
+{
+    if ((key >= STORE_MAX_KEYS) || (this->entries[key].len == 0) || (this->entries[key].len != len))
+    {
+        return false;
+    }
+    memcpy(value, this->entries[key].value, len);
+    return true;
+}
+
+bool KvStore::put(uint8_t key, const void *value, size_t len)
+{
+    if ((key >= STORE_MAX_KEYS) || (len == 0) || (len > STORE_MAX_VALUE))
+    {
+        return false;
+    }
+    Entry &entry = this->entries[key];
+    if ((entry.len == len) && (memcmp(entry.value, value, len) == 0))
+    {
+        return true;
+    }
+    if (this->write_offset + record_bytes(len) > STORE_SECTOR_SIZE)
+    {
+        this->rollover();
+    }
+    entry.len = len;
+    memcpy(entry.value, value, len);
+    this->append(key, entry.value, len);
+    return true;
+}
+
+bool KvStore::maintain()
+{
+    if ((this->spare_erased == true) || (this->write_offset < STORE_SECTOR_SIZE * 3 / 4))
+    {
+        return false;
+    }
+    uint8_t next = (this->active + 1) % STORE_SECTORS;
+    bool erased = false;
+    if (this->sector_erased(next) == false)
+    {
+        this->flash.erase(next * STORE_SECTOR_SIZE);
+        erased = true;
+    }
+    this->spare_erased = true;
+    return erased;
+}
+
+uint32_t KvStore::sequence()
+{
+    return this->seq;
+}
+
+uint32_t KvStore::free_bytes()
+{
+    return STORE_SECTOR_SIZE - this->write_offset;
+}
+
+bool KvStore::scan(uint8_t sector, Entry *found, uint32_t &end)
+{
+    const uint8_t *p = this->flash.data(sector * STORE_SECTOR_SIZE);
+    bool committed = false;
+    uint32_t offset = SECTOR_HEADER_BYTES;
+    while (offset + RECORD_HEADER_BYTES <= STORE_SECTOR_SIZE)
+    {
+        uint8_t key = p[offset];
+        uint8_t len = p[offset + 1];
+        uint16_t crc = p[offset + 2] | (p[offset + 3] << 8);
+        if ((key == KEY_ERASED) && (len == 0xFF) && (crc == 0xFFFF))
+        {
+            break;
+        }
+        if ((len > STORE_MAX_VALUE) || (offset + record_bytes(len) > STORE_SECTOR_SIZE) ||
+            (crc != record_crc(key, len, p + offset + RECORD_HEADER_BYTES)))
+        {
+            // torn record, the rest of the sector is not written again
+            offset = STORE_SECTOR_SIZE;
+            break;
+        }
+        if (key == KEY_COMMIT)
+        {
+            committed = true;
+        }
+        else if (key < STORE_MAX_KEYS)
+        {
+            found[key].len = len;
+            memcpy(found[key].value, p + offset + RECORD_HEADER_BYTES, len);
+        }
+        offset += record_bytes(len);
+    }
+    end = offset;
+    return committed;
+}
+
+bool KvStore::sector_erased(uint8_t sector)
+{
+    const uint8_t *p = this->flash.data(sector * STORE_SECTOR_SIZE);
+    for (uint32_t i = 0; i < STORE_SECTOR_SIZE; i++)
+    {
+        if (p[i] != 0xFF)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void KvStore::append(uint8_t key, const uint8_t *value, uint8_t len)
+{
+    uint8_t record[RECORD_HEADER_BYTES + STORE_MAX_VALUE + 3];
+    uint32_t bytes = record_bytes(len);
+    uint16_t crc = record_crc(key, len, value);
+    memset(record, 0xFF, bytes);
+    record[0] = key;
+    record[1] = len;
+    record[2] = crc & 0xFF;
+    record[3] = crc >> 8;
+    if (len > 0)
+    {
+        memcpy(record + RECORD_HEADER_BYTES, value, len);
+    }
+    this->flash.program(this->active * STORE_SECTOR_SIZE + this->write_offset, record, bytes);
+    this->write_offset += bytes;
+}
+
+void KvStore::open_sector(uint8_t sector, uint32_t sector_seq)
+{
+    uint8_t header[SECTOR_HEADER_BYTES];
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        header[i] = STORE_MAGIC >> (8 * i);
+        header[4 + i] = sector_seq >> (8 * i);
+    }
+    this->flash.program(sector * STORE_SECTOR_SIZE, header, SECTOR_HEADER_BYTES);
+    this->active = sector;
+    this->seq = sector_seq;
+    this->write_offset = SECTOR_HEADER_BYTES;
+}
+
+void KvStore::rollover()
+{
+    uint8_t next = (this->active + 1) % STORE_SECTORS;
+    if ((this->spare_erased == false) && (this->sector_erased(next) == false))
+    {
+        this->flash.erase(next * STORE_SECTOR_SIZE);
+    }
+    this->spare_erased = false;
+
+    // snapshot of all values, the old sector stays valid until the commit
+    this->open_sector(next, this->seq + 1);
+    for (uint8_t key = 0; key < STORE_MAX_KEYS; key++)
+    {
+        if (this->entries[key].len > 0)
+        {
+            this->append(key, this->entries[key].value, this->entries[key].len);
+        }
+    }
+    this->append(KEY_COMMIT, nullptr, 0);
+}
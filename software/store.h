@@ -0,0 +1,95 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STORE_H
+#define STORE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#define STORE_SECTORS 4
+#define STORE_SECTOR_SIZE 4096
+#define STORE_MAX_KEYS 8
+#define STORE_MAX_VALUE 20
+
+// Flash below the store, program() can only clear bits and erase() sets a
+// whole sector back to 0xFF. Offsets are relative to the store region.
+class FlashDriver
+{
+public:
+  virtual ~FlashDriver() {}
+  // memory mapped contents, XIP on the Pico
+  virtual const uint8_t *data(uint32_t offset) = 0;
+  virtual void program(uint32_t offset, const uint8_t *bytes, size_t len) = 0;
+  virtual void erase(uint32_t offset) = 0;
+};
+
+enum StoreKey
+{
+  KEY_BRIGHTNESS = 1,
+  KEY_DIFFICULTY = 2,
+  KEY_STATS = 3,
+  KEY_LAST_GAME = 4,
+};
+
+// Log-structured key/value store over STORE_SECTORS sectors used as a ring.
+// Every value is appended as a CRC'd record to the active sector and the
+// latest value of every key is kept in RAM, so get() never touches flash.
+// A full sector rolls over to the next one, which starts with a snapshot of
+// all values, so mount() only reads the newest committed sector. The next
+// sector is erased ahead of time by maintain(), from the idle loop.
+class KvStore
+{
+public:
+  KvStore(FlashDriver &flash);
+  // false if no sector holds a committed log, the store is then empty
+  bool mount();
+  // erases the first sector and starts an empty log
+  void format();
+  // value bytes of key, false if the key was never stored or len differs
+  bool get(uint8_t key, void *value, size_t len);
+  // appends the value unless it is unchanged, rolls over on a full sector
+  bool put(uint8_t key, const void *value, size_t len);
+  // erases the sector the next rollover writes, true if it erased
+  bool maintain();
+  uint32_t sequence();
+  uint32_t free_bytes();
+
+private:
+  struct Entry
+  {
+    uint8_t len; // 0: not stored
+    uint8_t value[STORE_MAX_VALUE];
+  };
+
+  FlashDriver &flash;
+  Entry entries[STORE_MAX_KEYS];
+  uint8_t active;
+  uint32_t seq;
+  uint32_t write_offset;
+  bool spare_erased;
+
+  bool scan(uint8_t sector, Entry *entries, uint32_t &end);
+  bool sector_erased(uint8_t sector);
+  void append(uint8_t key, const uint8_t *value, uint8_t len);
+  void open_sector(uint8_t sector, uint32_t seq);
+  void rollover();
+};
+
+#endif // STORE_H
@@ -0,0 +1,102 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "symmetry.h"
+
+static constexpr Symmetry make_identity()
+{
+    Symmetry s = {};
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        s.cell[i] = i;
+    }
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        s.color[i] = i;
+        s.sw[i] = i;
+    }
+    return s;
+}
+
+static constexpr Symmetry make_transpose()
+{
+    Symmetry s = make_identity();
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        s.cell[i] = (i % 6) * 6 + i / 6;
+    }
+    // top right and bottom left quadrant trade places
+    s.color[3] = 4;
+    s.color[4] = 3;
+    // row switch 0..3 (row 1..4) becomes column switch 4..7 (column 1..4)
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        s.sw[i] = i + 4;
+        s.sw[i + 4] = i;
+    }
+    return s;
+}
+
+const Symmetry symmetries[NUM_SYMMETRIES] = {make_identity(), make_transpose()};
+
+static inline uint8_t packed_cell(const PackedBoard &packed, uint8_t i)
+{
+    return i < 18 ? (packed.lo >> (3 * i)) & 0x7 : (packed.hi >> (3 * (i - 18))) & 0x7;
+}
+
+PackedBoard transform_board(const PackedBoard &packed, uint8_t transform)
+{
+    const Symmetry &s = symmetries[transform];
+    PackedBoard result = {0, 0};
+    for (uint8_t i = 0; i < 18; i++)
+    {
+        result.lo |= (uint64_t)s.color[packed_cell(packed, s.cell[i])] << (3 * i);
+        result.hi |= (uint64_t)s.color[packed_cell(packed, s.cell[18 + i])] << (3 * i);
+    }
+    return result;
+}
+
+CanonicalBoard canonicalize(const PackedBoard &packed)
+{
+    CanonicalBoard canonical = {packed, 0};
+    for (uint8_t t = 1; t < NUM_SYMMETRIES; t++)
+    {
+        PackedBoard candidate = transform_board(packed, t);
+        if ((candidate.hi < canonical.packed.hi) ||
+            ((candidate.hi == canonical.packed.hi) && (candidate.lo < canonical.packed.lo)))
+        {
+            canonical.packed = candidate;
+            canonical.transform = t;
+        }
+    }
+    return canonical;
+}
+
+CanonicalBoard canonicalize(const Board maze)
+{
+    return canonicalize(pack_board(maze));
+}
+
+void transform_switches(const uint8_t switches[8], uint8_t transform, uint8_t transformed[8])
+{
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        transformed[symmetries[transform].sw[i]] = switches[i];
+    }
+}
@@ -0,0 +1,66 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include <cstdint>
+
+#include "board.h"
+
+// Transforms of the board that commute with every move and keep the solution
+// fixed, so the distance to the solution and the optimal moves carry over.
+// Reflections and rotations move the white border away from the top / left
+// edge and colour permutations alone change the solution; what remains is the
+// identity and the transpose combined with swapping colours 3 and 4.
+#define NUM_SYMMETRIES 2
+
+struct Symmetry
+{
+  uint8_t cell[36]; // source cell of every cell of the transformed board
+  uint8_t color[8]; // colour of the transformed board for every colour
+  uint8_t sw[8];    // switch of the transformed board doing what switch i did
+};
+
+extern const Symmetry symmetries[NUM_SYMMETRIES];
+
+struct CanonicalBoard
+{
+  PackedBoard packed; // smallest transformed board
+  uint8_t transform;  // index into symmetries that produced it
+};
+
+PackedBoard transform_board(const PackedBoard &packed, uint8_t transform);
+CanonicalBoard canonicalize(const PackedBoard &packed);
+CanonicalBoard canonicalize(const Board maze);
+void transform_switches(const uint8_t switches[8], uint8_t transform, uint8_t transformed[8]);
+
+// move on the canonical board for a move on the original board and back
+inline uint8_t switch_to_canonical(uint8_t transform, uint8_t sw)
+{
+  return symmetries[transform].sw[sw];
+}
+
+// every symmetry is an involution, so the table maps both ways
+inline uint8_t switch_from_canonical(uint8_t transform, uint8_t sw)
+{
+  return symmetries[transform].sw[sw];
+}
+
+#endif // SYMMETRY_H
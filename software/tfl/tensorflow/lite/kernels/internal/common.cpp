@@ -67,12 +67,11 @@ int32_t MultiplyByQuantizedMultiplier(int64_t x, int32_t quantized_multiplier,
 int32_t MultiplyByQuantizedMultiplier(int32_t x, int32_t quantized_multiplier,
                                       int shift) {
   using gemmlowp::RoundingDivideByPOT;
-  using gemmlowp::SaturatingRoundingDoublingHighMul;
   int left_shift = shift > 0 ? shift : 0;
   int right_shift = shift > 0 ? 0 : -shift;
-  return RoundingDivideByPOT(SaturatingRoundingDoublingHighMul(
-                                 x * (1 << left_shift), quantized_multiplier),
-                             right_shift);
+  return RoundingDivideByPOT(
+      RequantizeDoublingHighMul(x * (1 << left_shift), quantized_multiplier),
+      right_shift);
 }
 
 int32_t MultiplyByQuantizedMultiplier(int64_t x, int32_t quantized_multiplier,
@@ -257,6 +257,57 @@ inline void BiasAndClamp(float clamp_min, float clamp_max, int bias_size,
 #endif
 }
 
+// Same result as gemmlowp::SaturatingRoundingDoublingHighMul(int32_t, int32_t)
+// using only 32x32->32 multiplies on 16-bit halves. On cores without a long
+// multiply (e.g. Cortex-M0+) the int64_t product of the gemmlowp version is a
+// libgcc __aeabi_lmul call per requantized element.
+inline int32_t SaturatingRoundingDoublingHighMul32(int32_t a, int32_t b) {
+  if (a == b && a == std::numeric_limits<int32_t>::min()) {
+    return std::numeric_limits<int32_t>::max();
+  }
+  const int32_t a_hi = a >> 16;
+  const int32_t b_hi = b >> 16;
+  const int32_t a_lo = a & 0xFFFF;
+  const int32_t b_lo = b & 0xFFFF;
+
+  // High and low word of the 64-bit product a * b.
+  const uint32_t lo_lo =
+      static_cast<uint32_t>(a_lo) * static_cast<uint32_t>(b_lo);
+  const int32_t cross1 = a_hi * b_lo + static_cast<int32_t>(lo_lo >> 16);
+  const int32_t cross2 = a_lo * b_hi + (cross1 & 0xFFFF);
+  int32_t high = a_hi * b_hi + (cross1 >> 16) + (cross2 >> 16);
+  uint32_t low = static_cast<uint32_t>(a) * static_cast<uint32_t>(b);
+
+  // (a * b + nudge) / 2^31, rounding half away from zero like gemmlowp.
+  if (high >= 0) {
+    const uint32_t sum = low + (1u << 30);
+    high += sum < low;
+    low = sum;
+  } else {
+    const uint32_t sum = low + static_cast<uint32_t>(1 - (1 << 30));
+    high += (sum < low) - 1;
+    low = sum;
+    if (high < 0) {
+      // Division truncates towards zero.
+      const uint32_t biased = low + 0x7FFFFFFFu;
+      high += biased < low;
+      low = biased;
+    }
+  }
+  return static_cast<int32_t>((static_cast<uint32_t>(high) << 1) |
+                              (low >> 31));
+}
+
+// Doubling high multiply used by the double-rounding requantization helpers.
+// Defining TFLITE_REQUANTIZE_32BIT selects the 32-bit-only implementation.
+inline int32_t RequantizeDoublingHighMul(int32_t a, int32_t b) {
+#ifdef TFLITE_REQUANTIZE_32BIT
+  return SaturatingRoundingDoublingHighMul32(a, b);
+#else
+  return gemmlowp::SaturatingRoundingDoublingHighMul(a, b);
+#endif
+}
+
 TFLITE_NOINLINE int32_t MultiplyByQuantizedMultiplier(
     int32_t x, int32_t quantized_multiplier, int shift);
 
@@ -314,16 +365,14 @@ inline int32x4x4_t MultiplyByQuantizedMultiplier4Rows(
 inline int32_t MultiplyByQuantizedMultiplierSmallerThanOneExp(
     int32_t x, int32_t quantized_multiplier, int left_shift) {
   using gemmlowp::RoundingDivideByPOT;
-  using gemmlowp::SaturatingRoundingDoublingHighMul;
   return RoundingDivideByPOT(
-      SaturatingRoundingDoublingHighMul(x, quantized_multiplier), -left_shift);
+      RequantizeDoublingHighMul(x, quantized_multiplier), -left_shift);
 }
 
 inline int32_t MultiplyByQuantizedMultiplierGreaterThanOne(
     int32_t x, int32_t quantized_multiplier, int left_shift) {
-  using gemmlowp::SaturatingRoundingDoublingHighMul;
-  return SaturatingRoundingDoublingHighMul(x * (1 << left_shift),
-                                           quantized_multiplier);
+  return RequantizeDoublingHighMul(x * (1 << left_shift),
+                                   quantized_multiplier);
 }
 
 #ifdef USE_NEON
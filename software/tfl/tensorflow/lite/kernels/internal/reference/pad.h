@@ -86,13 +86,24 @@ inline void PadImpl(const tflite::PadParams& op_params,
 
   const T pad_value = *pad_value_ptr;
 
-  const T* in_ptr = input_data;
-  T* out_ptr = output_data;
-  for (int out_b = 0; out_b < output_batch; ++out_b) {
-    for (int out_p = 0; out_p < output_plane; ++out_p) {
-      for (int out_h = 0; out_h < output_height; ++out_h) {
-        for (int out_w = 0; out_w < output_width; ++out_w) {
-          for (int out_d = 0; out_d < output_depth; ++out_d) {
+  // In place the input is the start of the output buffer. Every input element
+  // moves to the same or a later position, so walking both back to front
+  // reads each input element before anything is written over it.
+  const bool in_place = static_cast<const void*>(input_data) ==
+                        static_cast<const void*>(output_data);
+  const int step = in_place ? -1 : 1;
+  int in_index = in_place ? ext_input_shape.FlatSize() - 1 : 0;
+  int out_index = in_place ? ext_output_shape.FlatSize() - 1 : 0;
+  for (int b = 0; b < output_batch; ++b) {
+    const int out_b = in_place ? output_batch - 1 - b : b;
+    for (int p = 0; p < output_plane; ++p) {
+      const int out_p = in_place ? output_plane - 1 - p : p;
+      for (int h = 0; h < output_height; ++h) {
+        const int out_h = in_place ? output_height - 1 - h : h;
+        for (int w = 0; w < output_width; ++w) {
+          const int out_w = in_place ? output_width - 1 - w : w;
+          for (int d = 0; d < output_depth; ++d) {
+            const int out_d = in_place ? output_depth - 1 - d : d;
             if (out_b < left_b_padding ||
                 out_b >= output_batch - right_b_padding ||
                 out_p < left_p_padding ||
@@ -103,10 +114,12 @@ inline void PadImpl(const tflite::PadParams& op_params,
                 out_w >= output_width - right_w_padding ||
                 out_d < left_d_padding ||
                 out_d >= output_depth - right_d_padding) {
-              *out_ptr++ = pad_value;
+              output_data[out_index] = pad_value;
             } else {
-              *out_ptr++ = *in_ptr++;
+              output_data[out_index] = input_data[in_index];
+              in_index += step;
             }
+            out_index += step;
           }
         }
       }
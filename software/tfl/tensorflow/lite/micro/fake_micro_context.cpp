@@ -53,8 +53,10 @@ void FakeMicroContext::DeallocateTempBuffer(uint8_t* buffer) {
 
 TfLiteEvalTensor* FakeMicroContext::GetEvalTensor(int tensor_index) {
   TfLiteEvalTensor* eval_tensor =
-      reinterpret_cast<TfLiteEvalTensor*>(allocator_->AllocateTemp(
-          sizeof(TfLiteEvalTensor), alignof(TfLiteEvalTensor)));
+      tensor_index < kNumEvalTensors_
+          ? &eval_tensors_[tensor_index]
+          : reinterpret_cast<TfLiteEvalTensor*>(allocator_->AllocateTemp(
+                sizeof(TfLiteEvalTensor), alignof(TfLiteEvalTensor)));
   TFLITE_DCHECK(eval_tensor != nullptr);
 
   // In unit tests, the TfLiteTensor pointer contains the source of truth for
@@ -55,6 +55,11 @@ class FakeMicroContext : public MicroContext {
   void* external_context() override;
   MicroGraph& graph() override;
 
+  // Kernels split their operators over pool, nullptr runs them on the
+  // calling thread.
+  void set_worker_pool(MicroWorkerPool* pool) { worker_pool_ = pool; }
+  MicroWorkerPool* worker_pool() override { return worker_pool_; }
+
 #ifdef USE_TFLM_COMPRESSION
 
   // Available during Prepare & Eval. Returns false if tensor is not
@@ -75,15 +80,20 @@ class FakeMicroContext : public MicroContext {
 
  private:
   static constexpr int kNumScratchBuffers_ = 12;
+  // Eval tensors of the first tensors live here, so a kernel can be invoked
+  // any number of times; the others take temp memory on every call.
+  static constexpr int kNumEvalTensors_ = 16;
 
   MicroGraph& graph_;
   int scratch_buffer_count_ = 0;
   uint8_t* scratch_buffers_[kNumScratchBuffers_];
+  TfLiteEvalTensor eval_tensors_[kNumEvalTensors_];
 
   TfLiteTensor* tensors_;
   int allocated_temp_count_ = 0;
 
   SingleArenaBufferAllocator* allocator_;
+  MicroWorkerPool* worker_pool_ = nullptr;
 
 #ifdef USE_TFLM_COMPRESSION
 
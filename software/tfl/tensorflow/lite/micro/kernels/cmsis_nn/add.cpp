@@ -406,15 +406,24 @@ TfLiteStatus EvalAddInt16(TfLiteContext* context, TfLiteNode* node) {
 }
 
 TFLMRegistration Register_ADD() {
-  return tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAdd);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAdd);
+  registration.in_place = TFLMInPlace::kElementwise;
+  return registration;
 }
 
 TFLMRegistration Register_ADD_INT8() {
-  return tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAddInt8);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAddInt8);
+  registration.in_place = TFLMInPlace::kElementwise;
+  return registration;
 }
 
 TFLMRegistration Register_ADD_INT16() {
-  return tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAddInt16);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(InitAdd, PrepareAdd, EvalAddInt16);
+  registration.in_place = TFLMInPlace::kElementwise;
+  return registration;
 }
 
 }  // namespace tflite
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/lite/micro/kernels/conv.h"
 
+#include <cstring>
+
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "tensorflow/lite/c/builtin_op_data.h"
 #include "tensorflow/lite/c/common.h"
@@ -26,17 +28,88 @@ limitations under the License.
 #include "tensorflow/lite/kernels/padding.h"
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
 
 namespace tflite {
 namespace {
 
+// Input and output of the previous Eval, kept for incremental invocation.
+// The output is only recomputed where its window reads input pixels that
+// differ from the cached input.
+struct ConvCache {
+  void* input;
+  void* output;
+  // Bytes from the start of the staging buffer to the staged output.
+  int staging_output_offset;
+  bool valid;
+};
+
 struct OpData {
   OpDataConv reference_op_data;
 
   // Index to buffer for optimizations if applicable.
   int buffer_idx;
+  // Bytes between the buffers of two workers, one per worker of the pool.
+  int buffer_stride;
+
+  // Set when the interpreter runs incrementally, nullptr otherwise.
+  ConvCache* cache;
+  // Index to the buffer the changed part of input and output is staged in.
+  int staging_buffer_idx;
 };
 
+// Narrows a convolution to part `part` of `num_parts`: whole images of a
+// batch, or output rows of a single image. The input rows of the slice keep
+// the padding above the first of them. Returns the element offsets of the
+// slice in input and output, the slice may be empty.
+void SliceConvolution(int part, int num_parts, cmsis_nn_conv_params* params,
+                      cmsis_nn_dims* input_dims,
+                      const cmsis_nn_dims& filter_dims,
+                      cmsis_nn_dims* output_dims, int* input_offset,
+                      int* output_offset) {
+  int start;
+  int end;
+  if (input_dims->n > 1) {
+    PartitionRange(input_dims->n, 1, part, num_parts, &start, &end);
+    *input_offset = start * input_dims->h * input_dims->w * input_dims->c;
+    *output_offset = start * output_dims->h * output_dims->w * output_dims->c;
+    input_dims->n = end - start;
+    output_dims->n = end - start;
+    return;
+  }
+  PartitionRange(output_dims->h, 1, part, num_parts, &start, &end);
+  int in_start;
+  int in_end;
+  int top_padding;
+  WindowInputRows(start, end, params->stride.h, params->padding.h,
+                  (filter_dims.h - 1) * params->dilation.h + 1, input_dims->h,
+                  &in_start, &in_end, &top_padding);
+  *input_offset = in_start * input_dims->w * input_dims->c;
+  *output_offset = start * output_dims->w * output_dims->c;
+  params->padding.h = top_padding;
+  input_dims->h = in_end - in_start;
+  output_dims->h = end - start;
+}
+
+// Quarters of the output a change has to reach before the incremental Eval
+// convolves the whole image instead of the changed part.
+constexpr int kFullConvolutionQuarters = 3;
+
+// Output positions [*out_start, *out_end) along one axis whose window reads
+// any of the input positions [in_start, in_end). The inverse of
+// WindowInputRows, the range may be empty.
+void WindowOutputRange(int in_start, int in_end, int stride, int padding,
+                       int extent, int output_size, int* out_start,
+                       int* out_end) {
+  const int before = in_start + padding - extent;
+  *out_start = before < 0 ? 0 : before / stride + 1;
+  const int last = (in_end - 1 + padding) / stride + 1;
+  *out_end = last < output_size ? last : output_size;
+  if (*out_end < *out_start) {
+    *out_end = *out_start;
+  }
+}
+
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
   TFLITE_DCHECK(context->AllocatePersistentBuffer != nullptr);
   return context->AllocatePersistentBuffer(context, sizeof(OpData));
@@ -50,6 +123,8 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
   const auto& params =
       *(static_cast<const TfLiteConvParams*>(node->builtin_data));
   OpData* data = static_cast<OpData*>(node->user_data);
+  data->cache = nullptr;
+  data->staging_buffer_idx = -1;
 
   MicroContext* micro_context = GetMicroContext(context);
 
@@ -151,21 +226,70 @@ TfLiteStatus Prepare(TfLiteContext* context, TfLiteNode* node) {
     conv_params.activation.min = data->reference_op_data.output_activation_min;
     conv_params.activation.max = data->reference_op_data.output_activation_max;
 
-    if (input->type == kTfLiteInt8) {
-      buf_size = arm_convolve_wrapper_s8_get_buffer_size(
-          &conv_params, &input_dims, &filter_dims, &output_dims);
-    } else if (input->type == kTfLiteInt16) {
+    if (input->type == kTfLiteInt16) {
       TF_LITE_ENSURE_EQ(context, input->params.zero_point, 0);
       TF_LITE_ENSURE_EQ(context, output->params.zero_point, 0);
-      buf_size = arm_convolve_wrapper_s16_get_buffer_size(
-          &conv_params, &input_dims, &filter_dims, &output_dims);
+    }
+
+    // Each worker runs the kernel on its slice with its own buffer, sized for
+    // the largest slice of any split Eval may choose.
+    MicroWorkerPool* pool = micro_context->worker_pool();
+    const int num_workers = pool != nullptr ? pool->num_workers() : 1;
+    for (int num_parts = 1; num_parts <= num_workers; ++num_parts) {
+      for (int part = 0; part < num_parts; ++part) {
+        cmsis_nn_conv_params part_params = conv_params;
+        cmsis_nn_dims part_input_dims = input_dims;
+        cmsis_nn_dims part_output_dims = output_dims;
+        int input_offset;
+        int output_offset;
+        SliceConvolution(part, num_parts, &part_params, &part_input_dims,
+                         filter_dims, &part_output_dims, &input_offset,
+                         &output_offset);
+        int32_t part_size = 0;
+        if (input->type == kTfLiteInt8 && filter->type == kTfLiteInt4) {
+          part_size = arm_convolve_wrapper_s4_get_buffer_size(
+              &part_params, &part_input_dims, &filter_dims, &part_output_dims);
+        } else if (input->type == kTfLiteInt8) {
+          part_size = arm_convolve_wrapper_s8_get_buffer_size(
+              &part_params, &part_input_dims, &filter_dims, &part_output_dims);
+        } else if (input->type == kTfLiteInt16) {
+          part_size = arm_convolve_wrapper_s16_get_buffer_size(
+              &part_params, &part_input_dims, &filter_dims, &part_output_dims);
+        }
+        buf_size = part_size > buf_size ? part_size : buf_size;
+      }
     }
 
     if (buf_size > 0) {
+      data->buffer_stride = (buf_size + 3) & ~3;
       TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
-          context, buf_size, &data->buffer_idx));
+          context, num_workers * data->buffer_stride, &data->buffer_idx));
     } else {
       data->buffer_idx = -1;
+      data->buffer_stride = 0;
+    }
+
+    // Incremental invocation keeps the last input and output of single
+    // images and stages the changed part of both.
+    if (micro_context->incremental_invoke() && input_dims.n == 1) {
+      const int element_size = input->type == kTfLiteInt16 ? 2 : 1;
+      const int input_bytes =
+          (input_dims.h * input_dims.w * input_dims.c * element_size + 3) & ~3;
+      const int output_bytes =
+          output_dims.h * output_dims.w * output_dims.c * element_size;
+      data->cache = static_cast<ConvCache*>(
+          context->AllocatePersistentBuffer(context, sizeof(ConvCache)));
+      TF_LITE_ENSURE(context, data->cache != nullptr);
+      data->cache->input =
+          context->AllocatePersistentBuffer(context, input_bytes);
+      data->cache->output =
+          context->AllocatePersistentBuffer(context, output_bytes);
+      TF_LITE_ENSURE(context, data->cache->input != nullptr &&
+                                  data->cache->output != nullptr);
+      data->cache->staging_output_offset = input_bytes;
+      data->cache->valid = false;
+      TF_LITE_ENSURE_STATUS(context->RequestScratchBufferInArena(
+          context, input_bytes + output_bytes, &data->staging_buffer_idx));
     }
   }
 
@@ -241,6 +365,232 @@ arm_cmsis_nn_status convolve_wrapper(
                                   &bias_data, output_dims, output);
 }
 
+// One quantized convolution, run by ConvolvePart in slices.
+template <typename ActType, typename BiasType>
+struct ConvTask {
+  cmsis_nn_conv_params conv_params;
+  cmsis_nn_per_channel_quant_params quant_params;
+  cmsis_nn_dims input_dims;
+  const ActType* input;
+  cmsis_nn_dims filter_dims;
+  const int8_t* filter;
+  cmsis_nn_dims bias_dims;
+  const BiasType* bias;
+  cmsis_nn_dims output_dims;
+  ActType* output;
+  // Scratch buffers of all workers, buffer_stride bytes apart.
+  int8_t* buffer;
+  int buffer_stride;
+  // Result of every part, checked after the last one.
+  arm_cmsis_nn_status status[kMaxWorkerParts];
+};
+
+template <typename ActType, typename BiasType, TfLiteType type>
+void ConvolvePart(void* data, int part, int num_parts) {
+  ConvTask<ActType, BiasType>& task =
+      *static_cast<ConvTask<ActType, BiasType>*>(data);
+  cmsis_nn_conv_params conv_params = task.conv_params;
+  cmsis_nn_dims input_dims = task.input_dims;
+  cmsis_nn_dims output_dims = task.output_dims;
+  int input_offset;
+  int output_offset;
+  SliceConvolution(part, num_parts, &conv_params, &input_dims,
+                   task.filter_dims, &output_dims, &input_offset,
+                   &output_offset);
+  if (output_dims.n == 0 || output_dims.h == 0) {
+    task.status[part] = ARM_CMSIS_NN_SUCCESS;
+    return;
+  }
+
+  // Initialize cmsis_nn context
+  cmsis_nn_context ctx;
+  ctx.buf = nullptr;
+  ctx.size = 0;
+  if (task.buffer != nullptr) {
+    ctx.buf = task.buffer + part * task.buffer_stride;
+    // Note: ctx.size is currently not used in cmsis_nn.
+    // The buffer should be allocated in the prepare function through
+    // the corresponding arm_convolve_wrapper_[type]_get_buffer_size
+  }
+
+  // arm_convolve_wrapper_[type] dispatches the optimized kernel accordingly
+  // with the parameters passed
+  task.status[part] =
+      convolve_wrapper(&ctx, &conv_params, &task.quant_params, &input_dims,
+                       task.input + input_offset, &task.filter_dims,
+                       task.filter, &task.bias_dims, task.bias, &output_dims,
+                       task.output + output_offset, type);
+}
+
+// Runs task, split over the worker pool when it is worth the hand-over, and
+// fails if any part did.
+template <typename ActType, typename BiasType, TfLiteType type>
+TfLiteStatus RunConvolution(TfLiteContext* context,
+                    ConvTask<ActType, BiasType>* task) {
+  MicroWorkerPool* pool = GetMicroContext(context)->worker_pool();
+  const cmsis_nn_dims& output_dims = task->output_dims;
+  const cmsis_nn_dims& filter_dims = task->filter_dims;
+  const int rows = output_dims.n > 1 ? output_dims.n : output_dims.h;
+  int num_parts = 1;
+  if (pool != nullptr) {
+    num_parts = pool->PartsFor(static_cast<int64_t>(output_dims.n) *
+                               output_dims.h * output_dims.w * output_dims.c *
+                               filter_dims.h * filter_dims.w * filter_dims.c);
+    num_parts = num_parts < rows ? num_parts : rows;
+  }
+  if (num_parts > 1) {
+    pool->Run(ConvolvePart<ActType, BiasType, type>, task, num_parts);
+  } else {
+    ConvolvePart<ActType, BiasType, type>(task, 0, 1);
+  }
+  for (int part = 0; part < num_parts; ++part) {
+    TF_LITE_ENSURE_EQ(context, task->status[part], ARM_CMSIS_NN_SUCCESS);
+  }
+  return kTfLiteOk;
+}
+
+// Incremental Eval of a single image: compares the input with the cached one
+// and recomputes the rectangle of output pixels whose window reads a changed
+// pixel. The rectangle is convolved on its own from a copy of its input
+// window, with the padding of the full image at the borders, so it is
+// bit-exact with a full convolution. The rest of the output comes from the
+// cache. The worker buffers planned in Prepare fit the rectangle, their size
+// only depends on the channels and the filter. A change over most of the
+// image, as after a new game, is not worth the staging: the diff stops, the
+// whole image is convolved as without the cache and the cache is dropped
+// instead of refreshed. The Eval after that refreshes it, so a run of
+// unrelated images pays the cache copies only every other time.
+template <typename ActType, typename BiasType, TfLiteType type>
+TfLiteStatus ConvolveChanged(TfLiteContext* context, const OpData& data,
+                             ConvTask<ActType, BiasType>* task) {
+  ConvCache* cache = data.cache;
+  const cmsis_nn_dims& input_dims = task->input_dims;
+  const cmsis_nn_dims& output_dims = task->output_dims;
+  const ActType* input = task->input;
+  ActType* input_cache = static_cast<ActType*>(cache->input);
+  ActType* output_cache = static_cast<ActType*>(cache->output);
+  const int pixel_bytes = input_dims.c * sizeof(ActType);
+  const int input_bytes =
+      input_dims.h * input_dims.w * input_dims.c * sizeof(ActType);
+  const int output_bytes =
+      output_dims.h * output_dims.w * output_dims.c * sizeof(ActType);
+
+  // Bounding box of the input pixels that changed since the last Eval and
+  // the rectangle of output pixels whose window reads one of them. Rows are
+  // compared whole first, in a changed row only its first and last changed
+  // pixel matter. The diff stops once the rectangle covers
+  // kFullConvolutionQuarters of the output.
+  const cmsis_nn_conv_params& conv_params = task->conv_params;
+  const int extent_h =
+      (task->filter_dims.h - 1) * conv_params.dilation.h + 1;
+  const int extent_w =
+      (task->filter_dims.w - 1) * conv_params.dilation.w + 1;
+  const int row_bytes = input_dims.w * pixel_bytes;
+  bool full = !cache->valid;
+  int row_start = -1;
+  int col_start = input_dims.w;
+  int col_end = 0;
+  int out_row_start = 0;
+  int out_row_end = 0;
+  int out_col_start = 0;
+  int out_col_end = 0;
+  for (int y = 0; y < input_dims.h && !full; ++y) {
+    const ActType* row = input + y * input_dims.w * input_dims.c;
+    const ActType* cached_row = input_cache + y * input_dims.w * input_dims.c;
+    if (std::memcmp(row, cached_row, row_bytes) == 0) {
+      continue;
+    }
+    int first = 0;
+    while (std::memcmp(row + first * input_dims.c,
+                       cached_row + first * input_dims.c, pixel_bytes) == 0) {
+      ++first;
+    }
+    int last = input_dims.w - 1;
+    while (std::memcmp(row + last * input_dims.c,
+                       cached_row + last * input_dims.c, pixel_bytes) == 0) {
+      --last;
+    }
+    row_start = row_start < 0 ? y : row_start;
+    col_start = first < col_start ? first : col_start;
+    col_end = last + 1 > col_end ? last + 1 : col_end;
+    WindowOutputRange(row_start, y + 1, conv_params.stride.h,
+                      conv_params.padding.h, extent_h, output_dims.h,
+                      &out_row_start, &out_row_end);
+    WindowOutputRange(col_start, col_end, conv_params.stride.w,
+                      conv_params.padding.w, extent_w, output_dims.w,
+                      &out_col_start, &out_col_end);
+    full = (out_row_end - out_row_start) * (out_col_end - out_col_start) * 4 >=
+           output_dims.h * output_dims.w * kFullConvolutionQuarters;
+  }
+  const int rows = out_row_end - out_row_start;
+  const int cols = out_col_end - out_col_start;
+
+  if (full && cache->valid) {
+    // the input is unrelated to the cached one
+    cache->valid = false;
+    return RunConvolution<ActType, BiasType, type>(context, task);
+  }
+  if (full) {
+    TF_LITE_ENSURE_STATUS(
+        (RunConvolution<ActType, BiasType, type>(context, task)));
+    std::memcpy(output_cache, task->output, output_bytes);
+  } else {
+    if (rows > 0 && cols > 0) {
+      int in_row_start;
+      int in_row_end;
+      int top_padding;
+      WindowInputRows(out_row_start, out_row_end, conv_params.stride.h,
+                      conv_params.padding.h, extent_h, input_dims.h,
+                      &in_row_start, &in_row_end, &top_padding);
+      int in_col_start;
+      int in_col_end;
+      int left_padding;
+      WindowInputRows(out_col_start, out_col_end, conv_params.stride.w,
+                      conv_params.padding.w, extent_w, input_dims.w,
+                      &in_col_start, &in_col_end, &left_padding);
+
+      int8_t* staging = static_cast<int8_t*>(
+          context->GetScratchBuffer(context, data.staging_buffer_idx));
+      ConvTask<ActType, BiasType> changed = *task;
+      changed.conv_params.padding.h = top_padding;
+      changed.conv_params.padding.w = left_padding;
+      changed.input_dims.h = in_row_end - in_row_start;
+      changed.input_dims.w = in_col_end - in_col_start;
+      changed.output_dims.h = rows;
+      changed.output_dims.w = cols;
+      ActType* staged_input = reinterpret_cast<ActType*>(staging);
+      ActType* staged_output = reinterpret_cast<ActType*>(
+          staging + cache->staging_output_offset);
+      const int input_row = changed.input_dims.w * input_dims.c;
+      for (int y = 0; y < changed.input_dims.h; ++y) {
+        std::memcpy(staged_input + y * input_row,
+                    input + ((in_row_start + y) * input_dims.w +
+                             in_col_start) *
+                                input_dims.c,
+                    input_row * sizeof(ActType));
+      }
+      changed.input = staged_input;
+      changed.output = staged_output;
+      TF_LITE_ENSURE_STATUS(
+          (RunConvolution<ActType, BiasType, type>(context, &changed)));
+
+      const int output_row = cols * output_dims.c;
+      for (int y = 0; y < rows; ++y) {
+        std::memcpy(output_cache + ((out_row_start + y) * output_dims.w +
+                                    out_col_start) *
+                                       output_dims.c,
+                    staged_output + y * output_row,
+                    output_row * sizeof(ActType));
+      }
+    }
+    std::memcpy(task->output, output_cache, output_bytes);
+  }
+
+  std::memcpy(input_cache, input, input_bytes);
+  cache->valid = true;
+  return kTfLiteOk;
+}
+
 template <typename ActType, typename BiasType, TfLiteType type>
 TfLiteStatus EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
                                      const TfLiteConvParams& params,
@@ -296,30 +646,28 @@ TfLiteStatus EvalQuantizedPerChannel(TfLiteContext* context, TfLiteNode* node,
   output_dims.w = output->dims->data[2];
   output_dims.c = output->dims->data[3];
 
-  // Initialize cmsis_nn context
-  cmsis_nn_context ctx;
-  ctx.buf = nullptr;
-  ctx.size = 0;
-
+  ConvTask<ActType, BiasType> task;
+  task.conv_params = conv_params;
+  task.quant_params = quant_params;
+  task.input_dims = input_dims;
+  task.input = tflite::micro::GetTensorData<ActType>(input);
+  task.filter_dims = filter_dims;
+  task.filter = tflite::micro::GetTensorData<int8_t>(filter);
+  task.bias_dims = bias_dims;
+  task.bias = tflite::micro::GetOptionalTensorData<BiasType>(bias);
+  task.output_dims = output_dims;
+  task.output = tflite::micro::GetTensorData<ActType>(output);
+  task.buffer = nullptr;
+  task.buffer_stride = data.buffer_stride;
   if (data.buffer_idx > -1) {
-    ctx.buf = context->GetScratchBuffer(context, data.buffer_idx);
-    // Note: ctx.size is currently not used in cmsis_nn.
-    // The buffer should be allocated in the prepare function through
-    // the corresponding arm_convolve_wrapper_[type]_get_buffer_size
+    task.buffer = static_cast<int8_t*>(
+        context->GetScratchBuffer(context, data.buffer_idx));
   }
 
-  // arm_convolve_wrapper_[type] dispatches the optimized kernel accordingly
-  // with the parameters passed
-  TFLITE_DCHECK_EQ(
-      convolve_wrapper(
-          &ctx, &conv_params, &quant_params, &input_dims,
-          tflite::micro::GetTensorData<ActType>(input), &filter_dims,
-          tflite::micro::GetTensorData<int8_t>(filter), &bias_dims,
-          tflite::micro::GetOptionalTensorData<BiasType>(bias), &output_dims,
-          tflite::micro::GetTensorData<ActType>(output), type),
-      ARM_CMSIS_NN_SUCCESS);
-
-  return kTfLiteOk;
+  if (data.cache != nullptr) {
+    return ConvolveChanged<ActType, BiasType, type>(context, data, &task);
+  }
+  return RunConvolution<ActType, BiasType, type>(context, &task);
 }
 
 TfLiteStatus EvalInt4(TfLiteContext* context, TfLiteNode* node) {
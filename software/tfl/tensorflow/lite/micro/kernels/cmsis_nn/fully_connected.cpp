@@ -28,6 +28,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
 
 namespace tflite {
 namespace {
@@ -208,6 +209,103 @@ void PopulateCommonParams(TfLiteContext* context,
   }
 }
 
+// One int8 or int4 weight fully connected layer, run by FullyConnectedPart
+// in slices.
+struct FullyConnectedTask {
+  TfLiteType weights_type;
+  cmsis_nn_context ctx;
+  cmsis_nn_fc_params fc_params;
+  cmsis_nn_per_tensor_quant_params quant_params;
+  cmsis_nn_dims input_dims;
+  const int8_t* input;
+  cmsis_nn_dims filter_dims;
+  const int8_t* filter;
+  cmsis_nn_dims bias_dims;
+  const int32_t* bias;
+  cmsis_nn_dims output_dims;
+  int8_t* output;
+  // Result of every part, checked after the last one.
+  arm_cmsis_nn_status status[kMaxWorkerParts];
+};
+
+// Batches are split by rows. A single row is split by output channels, in
+// pairs so that the int4 weights of every slice start on a byte.
+void FullyConnectedPart(void* data, int part, int num_parts) {
+  FullyConnectedTask& task = *static_cast<FullyConnectedTask*>(data);
+  cmsis_nn_context ctx = task.ctx;
+  cmsis_nn_dims input_dims = task.input_dims;
+  cmsis_nn_dims filter_dims = task.filter_dims;
+  cmsis_nn_dims bias_dims = task.bias_dims;
+  cmsis_nn_dims output_dims = task.output_dims;
+  const int8_t* input = task.input;
+  const int8_t* filter = task.filter;
+  const int32_t* bias = task.bias;
+  int8_t* output = task.output;
+
+  int start;
+  int end;
+  if (input_dims.n > 1) {
+    PartitionRange(input_dims.n, 1, part, num_parts, &start, &end);
+    input += start * input_dims.c;
+    output += start * output_dims.c;
+    input_dims.n = end - start;
+    output_dims.n = end - start;
+  } else {
+    PartitionRange(output_dims.c, 2, part, num_parts, &start, &end);
+    const int weights_per_byte = task.weights_type == kTfLiteInt4 ? 2 : 1;
+    filter += start * filter_dims.n / weights_per_byte;
+    bias = bias != nullptr ? bias + start : nullptr;
+    output += start;
+    if (ctx.buf != nullptr) {
+      // kernel sums, one per output channel
+      ctx.buf = static_cast<int32_t*>(ctx.buf) + start;
+    }
+    filter_dims.c = end - start;
+    bias_dims.c = end - start;
+    output_dims.c = end - start;
+  }
+  if (end == start) {
+    task.status[part] = ARM_CMSIS_NN_SUCCESS;
+    return;
+  }
+
+  if (task.weights_type == kTfLiteInt4) {
+    task.status[part] =
+        arm_fully_connected_s4(&ctx, &task.fc_params, &task.quant_params,
+                               &input_dims, input, &filter_dims, filter,
+                               &bias_dims, bias, &output_dims, output);
+  } else {
+    task.status[part] =
+        arm_fully_connected_s8(&ctx, &task.fc_params, &task.quant_params,
+                               &input_dims, input, &filter_dims, filter,
+                               &bias_dims, bias, &output_dims, output);
+  }
+}
+
+// Runs the task on the worker pool when the layer is large enough, otherwise
+// on the calling core, and fails if any part did.
+TfLiteStatus RunFullyConnected(TfLiteContext* context,
+                               FullyConnectedTask* task) {
+  MicroWorkerPool* pool = GetMicroContext(context)->worker_pool();
+  const int rows = task->input_dims.n > 1 ? task->input_dims.n
+                                          : (task->output_dims.c + 1) / 2;
+  int num_parts = 1;
+  if (pool != nullptr) {
+    num_parts = pool->PartsFor(static_cast<int64_t>(task->input_dims.n) *
+                               task->filter_dims.n * task->output_dims.c);
+    num_parts = num_parts < rows ? num_parts : rows;
+  }
+  if (num_parts > 1) {
+    pool->Run(FullyConnectedPart, task, num_parts);
+  } else {
+    FullyConnectedPart(task, 0, 1);
+  }
+  for (int part = 0; part < num_parts; ++part) {
+    TF_LITE_ENSURE_EQ(context, task->status[part], ARM_CMSIS_NN_SUCCESS);
+  }
+  return kTfLiteOk;
+}
+
 TfLiteStatus EvalQuantizedInt4(TfLiteContext* context, TfLiteNode* node,
                                const OpData& data,
                                const TfLiteEvalTensor* input,
@@ -239,16 +337,19 @@ TfLiteStatus EvalQuantizedInt4(TfLiteContext* context, TfLiteNode* node,
   fc_params.activation.min = data.reference_op_data.output_activation_min;
   fc_params.activation.max = data.reference_op_data.output_activation_max;
 
-  TF_LITE_ENSURE_EQ(
-      context,
-      arm_fully_connected_s4(
-          &ctx, &fc_params, &quant_params, &input_dims,
-          tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
-          tflite::micro::GetTensorData<int8_t>(filter), &bias_dims, bias_data,
-          &output_dims, tflite::micro::GetTensorData<int8_t>(output)),
-      ARM_CMSIS_NN_SUCCESS);
-
-  return kTfLiteOk;
+  FullyConnectedTask task = {kTfLiteInt4,
+                             ctx,
+                             fc_params,
+                             quant_params,
+                             input_dims,
+                             tflite::micro::GetTensorData<int8_t>(input),
+                             filter_dims,
+                             tflite::micro::GetTensorData<int8_t>(filter),
+                             bias_dims,
+                             bias_data,
+                             output_dims,
+                             tflite::micro::GetTensorData<int8_t>(output)};
+  return RunFullyConnected(context, &task);
 }
 
 TfLiteStatus EvalQuantizedInt8(TfLiteContext* context, TfLiteNode* node,
@@ -324,14 +425,19 @@ TfLiteStatus EvalQuantizedInt8(TfLiteContext* context, TfLiteNode* node,
           tflite::micro::GetTensorData<int8_t>(filter), 1, nullptr);
     }
 
-    TF_LITE_ENSURE_EQ(
-        context,
-        arm_fully_connected_s8(
-            &ctx, &fc_params, &quant_params, &input_dims,
-            tflite::micro::GetTensorData<int8_t>(input), &filter_dims,
-            tflite::micro::GetTensorData<int8_t>(filter), &bias_dims, bias_data,
-            &output_dims, tflite::micro::GetTensorData<int8_t>(output)),
-        ARM_CMSIS_NN_SUCCESS);
+    FullyConnectedTask task = {kTfLiteInt8,
+                               ctx,
+                               fc_params,
+                               quant_params,
+                               input_dims,
+                               tflite::micro::GetTensorData<int8_t>(input),
+                               filter_dims,
+                               tflite::micro::GetTensorData<int8_t>(filter),
+                               bias_dims,
+                               bias_data,
+                               output_dims,
+                               tflite::micro::GetTensorData<int8_t>(output)};
+    TF_LITE_ENSURE_STATUS(RunFullyConnected(context, &task));
   }
   return kTfLiteOk;
 }
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/kernels/kernel_util.h"
 #include "tensorflow/lite/micro/kernels/pooling.h"
 #include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
 
 namespace tflite {
 
@@ -106,6 +107,59 @@ void AverageEvalQuantized(TfLiteContext* context, const TfLiteNode* node,
   }
 }
 
+// One max pooling, run by MaxPoolPart in slices of output rows.
+struct MaxPoolTask {
+  TfLiteType type;
+  cmsis_nn_context ctx;
+  cmsis_nn_pool_params pool_params;
+  cmsis_nn_dims input_dims;
+  const void* input;
+  cmsis_nn_dims filter_dims;
+  cmsis_nn_dims output_dims;
+  void* output;
+  // Result of every part, checked after the last one.
+  arm_cmsis_nn_status status[kMaxWorkerParts];
+};
+
+void MaxPoolPart(void* data, int part, int num_parts) {
+  MaxPoolTask& task = *static_cast<MaxPoolTask*>(data);
+  cmsis_nn_pool_params pool_params = task.pool_params;
+  cmsis_nn_dims input_dims = task.input_dims;
+  cmsis_nn_dims output_dims = task.output_dims;
+  int start;
+  int end;
+  PartitionRange(output_dims.h, 1, part, num_parts, &start, &end);
+  if (end == start) {
+    task.status[part] = ARM_CMSIS_NN_SUCCESS;
+    return;
+  }
+  int in_start;
+  int in_end;
+  int top_padding;
+  WindowInputRows(start, end, pool_params.stride.h, pool_params.padding.h,
+                  task.filter_dims.h, input_dims.h, &in_start, &in_end,
+                  &top_padding);
+  const int input_offset = in_start * input_dims.w * input_dims.c;
+  const int output_offset = start * output_dims.w * output_dims.c;
+  pool_params.padding.h = top_padding;
+  input_dims.h = in_end - in_start;
+  output_dims.h = end - start;
+
+  if (task.type == kTfLiteInt8) {
+    task.status[part] =
+        arm_max_pool_s8(&task.ctx, &pool_params, &input_dims,
+                        static_cast<const int8_t*>(task.input) + input_offset,
+                        &task.filter_dims, &output_dims,
+                        static_cast<int8_t*>(task.output) + output_offset);
+  } else {
+    task.status[part] = arm_max_pool_s16(
+        &task.ctx, &pool_params, &input_dims,
+        static_cast<const int16_t*>(task.input) + input_offset,
+        &task.filter_dims, &output_dims,
+        static_cast<int16_t*>(task.output) + output_offset);
+  }
+}
+
 TfLiteStatus MaxEvalQuantized(TfLiteContext* context, const TfLiteNode* node,
                               const TfLitePoolParams* params,
                               const OpData& data, const TfLiteEvalTensor* input,
@@ -118,27 +172,31 @@ TfLiteStatus MaxEvalQuantized(TfLiteContext* context, const TfLiteNode* node,
   RuntimeShape output_shape = micro::GetTensorShape(output);
   TFLITE_DCHECK_EQ(output_shape.DimensionsCount(), 4);
 
-  cmsis_nn_dims input_dims;
-  cmsis_nn_dims output_dims;
-  cmsis_nn_pool_params pool_params;
-  cmsis_nn_dims filter_dims;
-  cmsis_nn_context ctx;
-
-  PopulateCommonParams(context, &input_dims, &output_dims, &pool_params, &ctx,
-                       &filter_dims, data, input_shape, output_shape, params);
-
-  if (input->type == kTfLiteInt8) {
-    TFLITE_DCHECK_EQ(
-        arm_max_pool_s8(&ctx, &pool_params, &input_dims,
-                        micro::GetTensorData<int8_t>(input), &filter_dims,
-                        &output_dims, micro::GetTensorData<int8_t>(output)),
-        ARM_CMSIS_NN_SUCCESS);
+  MaxPoolTask task;
+  task.type = input->type;
+  task.input = input->data.data;
+  task.output = output->data.data;
+  PopulateCommonParams(context, &task.input_dims, &task.output_dims,
+                       &task.pool_params, &task.ctx, &task.filter_dims, data,
+                       input_shape, output_shape, params);
+
+  // Split the output rows over the worker pool when it is worth the hand-over
+  MicroWorkerPool* pool = GetMicroContext(context)->worker_pool();
+  int num_parts = 1;
+  if (pool != nullptr) {
+    num_parts = pool->PartsFor(
+        static_cast<int64_t>(task.output_dims.h) * task.output_dims.w *
+        task.output_dims.c * task.filter_dims.h * task.filter_dims.w);
+    num_parts =
+        num_parts < task.output_dims.h ? num_parts : task.output_dims.h;
+  }
+  if (num_parts > 1) {
+    pool->Run(MaxPoolPart, &task, num_parts);
   } else {
-    TFLITE_DCHECK_EQ(
-        arm_max_pool_s16(&ctx, &pool_params, &input_dims,
-                         micro::GetTensorData<int16_t>(input), &filter_dims,
-                         &output_dims, micro::GetTensorData<int16_t>(output)),
-        ARM_CMSIS_NN_SUCCESS);
+    MaxPoolPart(&task, 0, 1);
+  }
+  for (int part = 0; part < num_parts; ++part) {
+    TF_LITE_ENSURE_EQ(context, task.status[part], ARM_CMSIS_NN_SUCCESS);
   }
 
   return kTfLiteOk;
@@ -273,7 +331,8 @@ TfLiteStatus MaxEval(TfLiteContext* context, TfLiteNode* node) {
     MaxPoolingEvalFloat(context, node, params, &data.reference_op_data, input,
                         output);
   } else if (input->type == kTfLiteInt8 || input->type == kTfLiteInt16) {
-    MaxEvalQuantized(context, node, params, data, input, output);
+    TF_LITE_ENSURE_STATUS(
+        MaxEvalQuantized(context, node, params, data, input, output));
   } else {
     MicroPrintf("Input type %s is not currently supported",
                 TfLiteTypeGetName(input->type));
@@ -296,8 +355,7 @@ TfLiteStatus MaxEvalInt8(TfLiteContext* context, TfLiteNode* node) {
   TfLiteEvalTensor* output =
       micro::GetEvalOutput(context, node, kPoolingOutputTensor);
 
-  MaxEvalQuantized(context, node, params, data, input, output);
-  return kTfLiteOk;
+  return MaxEvalQuantized(context, node, params, data, input, output);
 }
 
 TfLiteStatus MaxEvalInt16(TfLiteContext* context, TfLiteNode* node) {
@@ -313,8 +371,7 @@ TfLiteStatus MaxEvalInt16(TfLiteContext* context, TfLiteNode* node) {
   TfLiteEvalTensor* output =
       micro::GetEvalOutput(context, node, kPoolingOutputTensor);
 
-  MaxEvalQuantized(context, node, params, data, input, output);
-  return kTfLiteOk;
+  return MaxEvalQuantized(context, node, params, data, input, output);
 }
 
 }  // namespace
@@ -63,6 +63,12 @@ class KernelRunner {
   // implemented for a given kernel kTfLiteError will be returned.
   TfLiteStatus Reset();
 
+  // Hands pool to the kernel through MicroContext::worker_pool(). Call before
+  // InitAndPrepare(), kernels plan their per-worker scratch in Prepare.
+  void SetWorkerPool(MicroWorkerPool* pool) {
+    fake_micro_context_.set_worker_pool(pool);
+  }
+
   // Returns a pointer to the internal MockMicroGraph which KernelRunner uses
   // to stub out MicroGraph methods and track invocations on each subgraph.
   MockMicroGraph* GetMockGraph() { return &mock_micro_graph_; }
@@ -50,7 +50,8 @@ TFLMRegistration RegisterOp(
           /*invoke=*/invoke,
           /*reset*/ reset,
           /*builtin_code=*/0,
-          /*custom_name=*/nullptr};
+          /*custom_name=*/nullptr,
+          /*in_place=*/TFLMInPlace::kNone};
 }
 
 TFLMInferenceRegistration RegisterOp(
@@ -163,7 +163,23 @@ TfLiteStatus PadPrepare(TfLiteContext* context, TfLiteNode* node) {
   // NOTE: This data is only available because the paddings buffer is stored in
   // the flatbuffer:
   TF_LITE_ENSURE(context, IsConstantTensor(paddings));
-  const int64_t* paddings_data = GetTensorData<int64_t>(paddings);
+  // The converter emits int32 paddings, int64 ones are narrowed on the way.
+  const int paddings_count = GetTensorShape(paddings).FlatSize();
+  TF_LITE_ENSURE(context,
+                 paddings_count <= 2 * reference_ops::PadKernelMaxDimensionCount());
+  int32_t paddings_data[2 * reference_ops::PadKernelMaxDimensionCount()];
+  if (paddings->type == kTfLiteInt32) {
+    const int32_t* data = GetTensorData<int32_t>(paddings);
+    for (int i = 0; i < paddings_count; i++) {
+      paddings_data[i] = data[i];
+    }
+  } else {
+    TF_LITE_ENSURE_TYPES_EQ(context, paddings->type, kTfLiteInt64);
+    const int64_t* data = GetTensorData<int64_t>(paddings);
+    for (int i = 0; i < paddings_count; i++) {
+      paddings_data[i] = static_cast<int32_t>(data[i]);
+    }
+  }
   for (int i = 0; i < output->dims->size; i++) {
     int output_dim = output->dims->data[i];
     int expected_dim =
@@ -173,8 +189,7 @@ TfLiteStatus PadPrepare(TfLiteContext* context, TfLiteNode* node) {
 
   // Calculate OpData:
   data->params.resizing_category = ResizingCategory::kGenericResize;
-  const int paddings_total = GetTensorShape(paddings).FlatSize();
-  if (paddings_total == 8 && (paddings_data[0] == 0 && paddings_data[1] == 0) &&
+  if (paddings_count == 8 && (paddings_data[0] == 0 && paddings_data[1] == 0) &&
       (paddings_data[6] == 0 && paddings_data[7] == 0)) {
     data->params.resizing_category = ResizingCategory::kImageStyle;
   }
@@ -218,12 +233,18 @@ TfLiteStatus PadPrepare(TfLiteContext* context, TfLiteNode* node) {
 }
 
 TFLMRegistration Register_PAD() {
-  return tflite::micro::RegisterOp(PadInit, PadPrepare, PadEval);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(PadInit, PadPrepare, PadEval);
+  registration.in_place = TFLMInPlace::kExpanding;
+  return registration;
 }
 
 // Also register Pad as PadV2.
 TFLMRegistration Register_PADV2() {
-  return tflite::micro::RegisterOp(PadInit, PadPrepare, PadEval);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(PadInit, PadPrepare, PadEval);
+  registration.in_place = TFLMInPlace::kExpanding;
+  return registration;
 }
 
 }  // namespace tflite
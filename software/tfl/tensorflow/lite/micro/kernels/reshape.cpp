@@ -52,8 +52,11 @@ TfLiteStatus EvalReshapeReference(TfLiteContext* context, TfLiteNode* node) {
 }  // namespace
 
 TFLMRegistration Register_RESHAPE() {
-  return tflite::micro::RegisterOp(nullptr, PrepareReshapeReference,
-                                   EvalReshapeReference);
+  TFLMRegistration registration = tflite::micro::RegisterOp(
+      nullptr, PrepareReshapeReference, EvalReshapeReference);
+  // Sharing the buffer turns the copy into nothing.
+  registration.in_place = TFLMInPlace::kElementwise;
+  return registration;
 }
 
 }  // namespace tflite
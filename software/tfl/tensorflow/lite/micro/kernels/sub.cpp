@@ -162,7 +162,10 @@ TfLiteStatus SubEval(TfLiteContext* context, TfLiteNode* node) {
 }
 
 TFLMRegistration Register_SUB() {
-  return tflite::micro::RegisterOp(SubInit, SubPrepare, SubEval);
+  TFLMRegistration registration =
+      tflite::micro::RegisterOp(SubInit, SubPrepare, SubEval);
+  registration.in_place = TFLMInPlace::kElementwise;
+  return registration;
 }
 
 }  // namespace tflite
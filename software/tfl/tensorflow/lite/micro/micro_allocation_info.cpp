@@ -199,6 +199,7 @@ TfLiteStatus AllocationInfoBuilder::InitializeAllocationInfo(
 
       current->first_created = kUninitializedLifetime;
       current->last_used = kUninitializedLifetime;
+      current->in_place_of = -1;
       current->needs_allocating =
           (eval_tensors[i].data.data == nullptr) &&
           (!subgraph->tensors()->Get(i)->is_variable()) &&
@@ -226,6 +227,7 @@ TfLiteStatus AllocationInfoBuilder::InitializeAllocationInfo(
     current->last_used = kUninitializedLifetime;
     current->needs_allocating = true;
     current->offline_offset = kOnlinePlannedBuffer;
+    current->in_place_of = -1;
   }
   return kTfLiteOk;
 }
@@ -333,6 +335,78 @@ TfLiteStatus AllocationInfoBuilder::MarkAllocationLifetimes(
   return kTfLiteOk;
 }
 
+int AllocationInfoBuilder::InPlaceRoot(int index) const {
+  while (info_.allocation_info[index].in_place_of >= 0) {
+    index = info_.allocation_info[index].in_place_of;
+  }
+  return index;
+}
+
+TfLiteStatus AllocationInfoBuilder::MarkInPlaceAllocations(
+    SubgraphAllocations* allocations) {
+  AllocationInfo* allocation_info = info_.allocation_info;
+  for (size_t subgraph_idx = 0; subgraph_idx < model_->subgraphs()->size();
+       subgraph_idx++) {
+    const SubGraph* subgraph = model_->subgraphs()->Get(subgraph_idx);
+    const int offset = info_.subgraph_offsets[subgraph_idx];
+    uint32_t operators_size = NumSubgraphOperators(subgraph);
+    for (uint32_t i = 0; i < operators_size; i++) {
+      const auto* op = subgraph->operators()->Get(i);
+      const TFLMRegistration* registration =
+          allocations[subgraph_idx].node_and_registrations[i].registration;
+      if (registration == nullptr ||
+          registration->in_place == TFLMInPlace::kNone ||
+          op->outputs() == nullptr || op->outputs()->size() != 1 ||
+          op->inputs() == nullptr) {
+        continue;
+      }
+      const int output_index = offset + op->outputs()->Get(0);
+      AllocationInfo* output = &allocation_info[output_index];
+      if (!output->needs_allocating ||
+          output->offline_offset != kOnlinePlannedBuffer) {
+        continue;
+      }
+      // An expanding operator only writes back to front over its first
+      // input, an elementwise one over any input of the output's size.
+      const size_t candidates =
+          registration->in_place == TFLMInPlace::kExpanding
+              ? 1
+              : op->inputs()->size();
+      for (size_t n = 0; n < candidates && n < op->inputs()->size(); ++n) {
+        const int tensor_index = op->inputs()->Get(n);
+        if (tensor_index < 0) {
+          continue;
+        }
+        bool is_subgraph_input = false;
+        for (size_t k = 0;
+             subgraph->inputs() != nullptr && k < subgraph->inputs()->size();
+             ++k) {
+          is_subgraph_input |= subgraph->inputs()->Get(k) == tensor_index;
+        }
+        const AllocationInfo* input = &allocation_info[offset + tensor_index];
+        const int root_index = InPlaceRoot(offset + tensor_index);
+        AllocationInfo* root = &allocation_info[root_index];
+        const bool fits =
+            registration->in_place == TFLMInPlace::kExpanding
+                ? input->bytes <= output->bytes
+                : input->bytes == output->bytes;
+        // The buffer must be free from this operator on, every earlier
+        // sharer included.
+        if (is_subgraph_input || !fits || !input->needs_allocating ||
+            input->offline_offset != kOnlinePlannedBuffer ||
+            root->last_used != output->first_created) {
+          continue;
+        }
+        output->in_place_of = root_index;
+        root->bytes = std::max(root->bytes, output->bytes);
+        root->last_used = std::max(root->last_used, output->last_used);
+        break;
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+
 // Get offline tensors allocation plan. See
 // micro/docs/memory_management.md for more info.
 TfLiteStatus AllocationInfoBuilder::GetOfflinePlannedOffsets(
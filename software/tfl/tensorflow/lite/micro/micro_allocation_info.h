@@ -31,6 +31,10 @@ struct AllocationInfo {
   int last_used;
   int32_t offline_offset;
   bool needs_allocating;
+  // Index of the allocation whose buffer this one shares, -1 for a buffer of
+  // its own. Only the shared buffer is planned, with the union of the
+  // lifetimes and the larger size.
+  int in_place_of;
 };
 
 // Used to hold the allocation info list and related metadata for the entire
@@ -92,6 +96,12 @@ class AllocationInfoBuilder {
       ScratchBufferHandle* scratch_buffer_handles,
       SubgraphAllocations* allocations);
 
+  // Let the output of every operator registered as in place share the buffer
+  // of an input whose lifetime ends at that operator, see TFLMInPlace. Inputs
+  // of a subgraph are written by the caller and never shared. Call after
+  // MarkAllocationLifetimes().
+  TfLiteStatus MarkInPlaceAllocations(SubgraphAllocations* allocations);
+
   // Identify control flow operators and recursively mark all subgraphs which
   // that operator can invoke. The lifetime of all tensors within a subgraph
   // can only be extended. The order of subgraph invocation does not matter
@@ -123,6 +133,9 @@ class AllocationInfoBuilder {
   // count monotonically increases through the lifetime marking process.
   void UpdateLastUsed(AllocationInfo* current, int allocation_scope_count);
 
+  // Index of the allocation that holds the buffer of allocation index.
+  int InPlaceRoot(int index) const;
+
   // Validate if a subgraph satisfies assumptions.
   TfLiteStatus ValidateSubgraph(const SubGraph* subgraph,
                                 TfLiteEvalTensor* eval_tensors);
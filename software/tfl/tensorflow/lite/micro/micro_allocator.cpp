@@ -100,7 +100,8 @@ TfLiteStatus CreatePlan(MicroMemoryPlanner* planner,
   // Add the tensors to our allocation plan.
   for (size_t i = 0; i < allocation_info_size; ++i) {
     const AllocationInfo* current = &allocation_info[i];
-    if (current->needs_allocating) {
+    // Buffers shared in place are planned once, by their first user.
+    if (current->needs_allocating && current->in_place_of < 0) {
       size_t aligned_bytes_required =
           AlignSizeUp(current->bytes, MicroArenaBufferAlignment());
       if (current->offline_offset == kOnlinePlannedBuffer) {
@@ -124,7 +125,7 @@ TfLiteStatus CommitPlan(MicroMemoryPlanner* planner, uint8_t* starting_point,
   int planner_index = 0;
   for (size_t i = 0; i < allocation_info_size; ++i) {
     const AllocationInfo* current = &allocation_info[i];
-    if (current->needs_allocating) {
+    if (current->needs_allocating && current->in_place_of < 0) {
       int offset = -1;
       TF_LITE_ENSURE_STATUS(
           planner->GetOffsetForBuffer(planner_index, &offset));
@@ -132,6 +133,13 @@ TfLiteStatus CommitPlan(MicroMemoryPlanner* planner, uint8_t* starting_point,
       ++planner_index;
     }
   }
+  for (size_t i = 0; i < allocation_info_size; ++i) {
+    const AllocationInfo* current = &allocation_info[i];
+    if (current->needs_allocating && current->in_place_of >= 0) {
+      *current->output_ptr =
+          *allocation_info[current->in_place_of].output_ptr;
+    }
+  }
   return kTfLiteOk;
 }
 
@@ -611,6 +619,14 @@ size_t MicroAllocator::used_bytes() const {
          persistent_buffer_allocator_->GetPersistentUsedBytes();
 }
 
+size_t MicroAllocator::persistent_used_bytes() const {
+  return persistent_buffer_allocator_->GetPersistentUsedBytes();
+}
+
+size_t MicroAllocator::non_persistent_used_bytes() const {
+  return non_persistent_buffer_allocator_->GetNonPersistentUsedBytes();
+}
+
 TfLiteStatus MicroAllocator::AllocateNodeAndRegistrations(
     const Model* model, SubgraphAllocations* subgraph_allocations) {
   TFLITE_DCHECK(subgraph_allocations != nullptr);
@@ -878,6 +894,10 @@ TfLiteStatus MicroAllocator::CommitStaticMemoryPlan(
       GetScratchBufferRequests();
   TF_LITE_ENSURE_STATUS(builder.MarkAllocationLifetimes(
       0, scratch_buffer_requests, scratch_buffer_handles, allocations));
+  // Tensors kept for inspection must not be overwritten by later operators.
+  if (in_place_ops_ && !memory_planner_->preserves_all_tensors()) {
+    TF_LITE_ENSURE_STATUS(builder.MarkInPlaceAllocations(allocations));
+  }
   int allocation_info_count = builder.AllocationCount();
   AllocationInfo* allocation_info = builder.Finish();
 
@@ -160,6 +160,11 @@ class MicroAllocator {
     return memory_planner_->preserves_all_tensors();
   };
 
+  // Lets operators registered as in place write their output over an input
+  // that is not used afterwards (see TFLMInPlace), on by default. Takes
+  // effect with the next memory plan.
+  void set_in_place_ops(bool enabled) { in_place_ops_ = enabled; }
+
   // Allocates internal resources required for model inference for each subgraph
   // from the arena.
   //
@@ -235,8 +240,9 @@ class MicroAllocator {
   // This method only requests a buffer with a given size to be used after a
   // model has finished allocation via FinishModelAllocation(). All requested
   // buffers will be accessible by the out-param in that method.
-  TfLiteStatus RequestScratchBufferInArena(size_t bytes, int subgraph_idx,
-                                           int* buffer_idx);
+  virtual TfLiteStatus RequestScratchBufferInArena(size_t bytes,
+                                                   int subgraph_idx,
+                                                   int* buffer_idx);
 
   // Finish allocating a specific NodeAndRegistration prepare block (kernel
   // entry for a model) with a given node ID. This call ensures that any scratch
@@ -248,6 +254,12 @@ class MicroAllocator {
   // `FinishModelAllocation`. Otherwise, it will return 0.
   size_t used_bytes() const;
 
+  // Split of used_bytes() into the tail (persistent) and head (non-persistent)
+  // sections. The head is reported at its largest extent, the memory plan or
+  // the temp allocations on top of it, whichever is larger.
+  size_t persistent_used_bytes() const;
+  size_t non_persistent_used_bytes() const;
+
   TfLiteBridgeBuiltinDataAllocator* GetBuiltinDataAllocator();
 
  protected:
@@ -342,6 +354,8 @@ class MicroAllocator {
   // to ensure that multi-tenant allocations can share the head for buffers.
   size_t max_head_buffer_usage_ = 0;
 
+  bool in_place_ops_ = true;
+
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
 
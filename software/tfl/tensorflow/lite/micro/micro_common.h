@@ -17,6 +17,22 @@ limitations under the License.
 
 #include "tensorflow/lite/c/common.h"
 
+// Whether the memory planner may give an operator's output the buffer of an
+// input that is not used after the operator, see
+// AllocationInfoBuilder::MarkInPlaceAllocations().
+enum class TFLMInPlace {
+  // The output always gets a buffer of its own.
+  kNone,
+  // Output element i only depends on element i of the inputs of the output's
+  // size, and the kernel reads it before it writes element i (ADD, SUB,
+  // RESHAPE).
+  kElementwise,
+  // The output is the first input with elements inserted, every input
+  // element moves to the same or a later position. The kernel writes back to
+  // front when input and output share the buffer (PAD).
+  kExpanding,
+};
+
 // TFLMRegistration defines the API that TFLM kernels need to implement.
 // This will be replacing the current TfLiteRegistration_V1 struct with
 // something more compatible Embedded enviroment TFLM is used in.
@@ -28,6 +44,7 @@ struct TFLMRegistration {
   void (*reset)(TfLiteContext* context, void* buffer);
   int32_t builtin_code;
   const char* custom_name;
+  TFLMInPlace in_place;
 };
 
 struct TFLMInferenceRegistration {
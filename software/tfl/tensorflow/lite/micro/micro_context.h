@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/micro/micro_graph.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
 
 #ifdef USE_TFLM_COMPRESSION
 
@@ -101,6 +102,15 @@ class MicroContext {
 
   virtual MicroGraph& graph() = 0;
 
+  // Pool that kernels may split an operator over, nullptr when everything
+  // runs on the calling core. Available in Prepare & Eval.
+  virtual MicroWorkerPool* worker_pool() { return nullptr; }
+
+  // True when kernels may keep the inputs and outputs of the last Eval and
+  // recompute only the part of the output that depends on changed inputs.
+  // Available in Prepare & Eval.
+  virtual bool incremental_invoke() { return false; }
+
 #ifdef USE_TFLM_COMPRESSION
 
   // Available during Prepare & Eval. Returns false if tensor is not
@@ -28,6 +28,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_op_resolver.h"
 #include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/micro/micro_time.h"
 #include "tensorflow/lite/micro/tflite_bridge/flatbuffer_conversions_bridge.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/schema/schema_utils.h"
@@ -219,6 +220,12 @@ TfLiteStatus MicroInterpreter::AllocateTensors() {
 
   TF_LITE_ENSURE_STATUS(graph_.PrepareSubgraphs());
 
+  if (graph_.op_costs() != nullptr) {
+    TF_LITE_ENSURE_STATUS(ComputeMicroOpCosts(model_, graph_.GetAllocations(),
+                                              graph_.op_costs(),
+                                              graph_.op_costs_count()));
+  }
+
   micro_context_.SetInterpreterState(
       MicroInterpreterContext::InterpreterState::kMemoryPlanning);
 
@@ -291,9 +298,60 @@ TfLiteStatus MicroInterpreter::Invoke() {
   if (!tensors_allocated_) {
     TF_LITE_ENSURE_OK(&context_, AllocateTensors());
   }
+  next_operator_index_ = 0;
   return graph_.InvokeSubgraph(0);
 }
 
+TfLiteStatus MicroInterpreter::InvokeUntil(uint32_t operator_index) {
+  if (initialization_status_ != kTfLiteOk) {
+    MicroPrintf("InvokeUntil() called after initialization failed\n");
+    return kTfLiteError;
+  }
+
+  if (!tensors_allocated_) {
+    TF_LITE_ENSURE_OK(&context_, AllocateTensors());
+  }
+
+  const uint32_t operators_count = operators_size();
+  if (operator_index > operators_count) {
+    operator_index = operators_count;
+  }
+  if (operator_index < next_operator_index_) {
+    MicroPrintf("InvokeUntil(%d) is behind the resume point %d",
+                operator_index, next_operator_index_);
+    return kTfLiteError;
+  }
+
+  TfLiteStatus status =
+      graph_.InvokeSubgraphRange(0, next_operator_index_, operator_index);
+  if (status != kTfLiteOk || operator_index == operators_count) {
+    next_operator_index_ = 0;
+  } else {
+    next_operator_index_ = operator_index;
+  }
+  return status;
+}
+
+TfLiteStatus MicroInterpreter::Resume() {
+  return InvokeUntil(operators_size());
+}
+
+TfLiteStatus MicroInterpreter::InvokeStep(uint32_t budget_ticks) {
+  const uint32_t start = GetCurrentTimeTicks();
+  do {
+    TfLiteStatus status = InvokeUntil(next_operator_index_ + 1);
+    if (status != kTfLiteOk) {
+      return status;
+    }
+  } while (invoke_in_progress() &&
+           GetCurrentTimeTicks() - start < budget_ticks);
+  return kTfLiteOk;
+}
+
+uint32_t MicroInterpreter::operators_size() const {
+  return NumSubgraphOperators(model_, 0);
+}
+
 TfLiteTensor* MicroInterpreter::input(size_t index) {
   const size_t length = inputs_size();
   if (index >= length) {
@@ -334,4 +392,43 @@ TfLiteStatus MicroInterpreter::SetMicroExternalContext(
   return micro_context_.set_external_context(external_context_payload);
 }
 
+TfLiteStatus MicroInterpreter::SetWorkerPool(MicroWorkerPool* pool) {
+  if (tensors_allocated_) {
+    MicroPrintf("SetWorkerPool() called after AllocateTensors()");
+    return kTfLiteError;
+  }
+  micro_context_.set_worker_pool(pool);
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::SetIncrementalInvoke(bool enabled) {
+  if (tensors_allocated_) {
+    MicroPrintf("SetIncrementalInvoke() called after AllocateTensors()");
+    return kTfLiteError;
+  }
+  micro_context_.set_incremental_invoke(enabled);
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::SetInPlaceOps(bool enabled) {
+  if (tensors_allocated_) {
+    MicroPrintf("SetInPlaceOps() called after AllocateTensors()");
+    return kTfLiteError;
+  }
+  allocator_.set_in_place_ops(enabled);
+  return kTfLiteOk;
+}
+
+TfLiteStatus MicroInterpreter::SetOpCosts(MicroOpCost* costs, size_t count) {
+  if (tensors_allocated_) {
+    MicroPrintf("SetOpCosts() called after AllocateTensors()");
+    return kTfLiteError;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    costs[i] = {};
+  }
+  graph_.SetOpCosts(costs, count);
+  return kTfLiteOk;
+}
+
 }  // namespace tflite
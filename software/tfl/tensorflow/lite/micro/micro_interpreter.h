@@ -28,6 +28,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_interpreter_graph.h"
 #include "tensorflow/lite/micro/micro_op_resolver.h"
 #include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/micro/micro_worker_pool.h"
 #include "tensorflow/lite/portable_type_to_tflitetype.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
@@ -74,12 +75,79 @@ class MicroInterpreter {
   // TODO(b/149795762): Add this to the TfLiteStatus enum.
   TfLiteStatus Invoke();
 
+  // Anytime inference: runs the operators of the primary subgraph up to, but
+  // not including, operator_index and returns. Outputs produced by the
+  // operators that ran (e.g. an auxiliary early-exit head exported as an
+  // additional model output) can be read before the rest of the graph runs.
+  // Calling InvokeUntil again with a larger index or calling Resume continues
+  // where the previous call stopped. The inputs must not be modified while an
+  // invocation is in progress. Invoke always starts from the first operator.
+  TfLiteStatus InvokeUntil(uint32_t operator_index);
+
+  // Runs the remaining operators of an invocation started with InvokeUntil.
+  TfLiteStatus Resume();
+
+  // Cooperative execution: runs operators of the invocation in progress, or
+  // of a new one if none is, until budget_ticks (see micro_time.h) have passed
+  // and returns between two operators. At least one operator runs per call.
+  // The invocation is complete once invoke_in_progress() is false.
+  TfLiteStatus InvokeStep(uint32_t budget_ticks);
+
+  // Drops an invocation in progress, the next InvokeUntil or Resume starts
+  // again from the first operator.
+  void Cancel() { next_operator_index_ = 0; }
+
+  // Optional token checked before every operator of Invoke, InvokeUntil,
+  // Resume and InvokeStep. Setting *token (e.g. from an interrupt handler)
+  // stops the invocation before the next operator: the call returns
+  // kTfLiteCancelled and the invocation is dropped as by Cancel. The caller
+  // clears the token before the next invocation.
+  void SetCancellationToken(const volatile bool* token) {
+    graph_.SetCancellationToken(token);
+  }
+
+  // True between an InvokeUntil call that stopped early and the call that runs
+  // the last operator.
+  bool invoke_in_progress() const { return next_operator_index_ != 0; }
+
+  // Operator where the next InvokeUntil or Resume call continues.
+  uint32_t next_operator_index() const { return next_operator_index_; }
+
+  // Number of operators in the primary subgraph.
+  uint32_t operators_size() const;
+
   // This is the recommended API for an application to pass an external payload
   // pointer as an external context to kernels. The life time of the payload
   // pointer should be at least as long as this interpreter. TFLM supports only
   // one external context.
   TfLiteStatus SetMicroExternalContext(void* external_context_payload);
 
+  // Lets kernels split operators over the workers of pool. Kernels plan
+  // per-worker scratch buffers in Prepare, so the pool has to be set before
+  // AllocateTensors(). The pool has to outlive this interpreter.
+  TfLiteStatus SetWorkerPool(MicroWorkerPool* pool);
+
+  // Lets kernels cache their last inputs and outputs and recompute only what
+  // depends on the inputs that changed since the previous Invoke(). The
+  // results stay bit-exact, the caches take extra persistent arena memory
+  // and are allocated in Prepare, so this has to be set before
+  // AllocateTensors().
+  TfLiteStatus SetIncrementalInvoke(bool enabled);
+
+  // Lets operators registered as in place (ADD, SUB, PAD, RESHAPE) write
+  // their output into the buffer of an input that no later operator reads,
+  // which lowers the peak arena use. On by default; the memory plan is made
+  // in AllocateTensors(), so this has to be set before.
+  TfLiteStatus SetInPlaceOps(bool enabled);
+
+  // Instrumentation: fills costs[i] for operator i of the first subgraph, up
+  // to count, with the work derived from the tensor shapes in
+  // AllocateTensors() and the scratch the kernel requests, then adds the
+  // ticks of every Invoke(). See LogMicroOpCostsCsv() for the roofline
+  // table. Set before AllocateTensors(); costs has to outlive this
+  // interpreter.
+  TfLiteStatus SetOpCosts(MicroOpCost* costs, size_t count);
+
   TfLiteTensor* input(size_t index);
   size_t inputs_size() const {
     return model_->subgraphs()->Get(0)->inputs()->size();
@@ -139,6 +207,15 @@ class MicroInterpreter {
   // arena_used_bytes() + 16.
   size_t arena_used_bytes() const { return allocator_.used_bytes(); }
 
+  // Split of arena_used_bytes() into the persistent (tail) and non-persistent
+  // (head) sections of the arena.
+  size_t arena_persistent_used_bytes() const {
+    return allocator_.persistent_used_bytes();
+  }
+  size_t arena_non_persistent_used_bytes() const {
+    return allocator_.non_persistent_used_bytes();
+  }
+
   // Returns True if all Tensors are being preserves
   // TODO(b/297106074) : revisit making C++ example or test for
   // preserve_all_tesnors
@@ -165,6 +242,10 @@ class MicroInterpreter {
   MicroInterpreterGraph graph_;
   bool tensors_allocated_;
 
+  // Operator of the primary subgraph where the next InvokeUntil or Resume
+  // continues; zero when no invocation is in progress.
+  uint32_t next_operator_index_ = 0;
+
   TfLiteStatus initialization_status_;
 
   ScratchBufferHandle* scratch_buffer_handles_ = nullptr;
@@ -39,6 +39,11 @@ void* MicroInterpreterContext::AllocatePersistentBuffer(size_t bytes) {
 TfLiteStatus MicroInterpreterContext::RequestScratchBufferInArena(
     size_t bytes, int* buffer_idx) {
   TFLITE_DCHECK(state_ == InterpreterState::kPrepare);
+  MicroOpCost* cost = graph_.GetOpCost(graph_.GetCurrentSubgraphIndex(),
+                                       graph_.GetCurrentOperatorIndex());
+  if (cost != nullptr) {
+    cost->scratch_bytes += bytes;
+  }
   return allocator_.RequestScratchBufferInArena(
       bytes, graph_.GetCurrentSubgraphIndex(), buffer_idx);
 }
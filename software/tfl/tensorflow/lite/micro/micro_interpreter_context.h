@@ -101,6 +101,15 @@ class MicroInterpreterContext : public MicroContext {
 
   MicroGraph& graph() override { return graph_; }
 
+  // Does not take ownership of the pool, which has to outlive this instance.
+  void set_worker_pool(MicroWorkerPool* pool) { worker_pool_ = pool; }
+
+  MicroWorkerPool* worker_pool() override { return worker_pool_; }
+
+  void set_incremental_invoke(bool enabled) { incremental_invoke_ = enabled; }
+
+  bool incremental_invoke() override { return incremental_invoke_; }
+
   // Sets the pointer to a list of ScratchBufferHandle instances.
   // Not API between TFLM and kernels. Primarily used by the framework for
   // housekeeping in MicroInterpreterContext.
@@ -139,6 +148,8 @@ class MicroInterpreterContext : public MicroContext {
 
   ScratchBufferHandle* scratch_buffer_handles_ = nullptr;
   void* external_context_payload_ = nullptr;
+  MicroWorkerPool* worker_pool_ = nullptr;
+  bool incremental_invoke_ = false;
 
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
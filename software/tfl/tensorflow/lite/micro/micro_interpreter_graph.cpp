@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/memory_helpers.h"
 #include "tensorflow/lite/micro/micro_log.h"
 #include "tensorflow/lite/micro/micro_profiler.h"
+#include "tensorflow/lite/micro/micro_time.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
 namespace tflite {
@@ -186,6 +187,17 @@ TfLiteStatus MicroInterpreterGraph::FreeSubgraphs() {
 }
 
 TfLiteStatus MicroInterpreterGraph::InvokeSubgraph(int subgraph_idx) {
+  if (static_cast<size_t>(subgraph_idx) >= subgraphs_->size()) {
+    MicroPrintf("Accessing subgraph %d but only %d subgraphs found",
+                subgraph_idx, subgraphs_->size());
+    return kTfLiteError;
+  }
+  return InvokeSubgraphRange(subgraph_idx, 0,
+                             NumSubgraphOperators(model_, subgraph_idx));
+}
+
+TfLiteStatus MicroInterpreterGraph::InvokeSubgraphRange(
+    int subgraph_idx, uint32_t first_operator_idx, uint32_t last_operator_idx) {
   int previous_subgraph_idx = current_subgraph_index_;
   uint32_t previous_operator_idx = current_operator_index_;
   current_subgraph_index_ = subgraph_idx;
@@ -196,8 +208,16 @@ TfLiteStatus MicroInterpreterGraph::InvokeSubgraph(int subgraph_idx) {
     return kTfLiteError;
   }
   uint32_t operators_size = NumSubgraphOperators(model_, subgraph_idx);
-  for (current_operator_index_ = 0; current_operator_index_ < operators_size;
-       ++current_operator_index_) {
+  if (last_operator_idx > operators_size) {
+    last_operator_idx = operators_size;
+  }
+  for (current_operator_index_ = first_operator_idx;
+       current_operator_index_ < last_operator_idx; ++current_operator_index_) {
+    if (cancellation_token_ != nullptr && *cancellation_token_) {
+      current_subgraph_index_ = previous_subgraph_idx;
+      current_operator_index_ = previous_operator_idx;
+      return kTfLiteCancelled;
+    }
     TfLiteNode* node = &(subgraph_allocations_[subgraph_idx]
                              .node_and_registrations[current_operator_index_]
                              .node);
@@ -215,9 +235,17 @@ TfLiteStatus MicroInterpreterGraph::InvokeSubgraph(int subgraph_idx) {
         reinterpret_cast<MicroProfilerInterface*>(context_->profiler));
 #endif
 
+    MicroOpCost* cost = GetOpCost(subgraph_idx, current_operator_index_);
+    const uint32_t start_ticks = cost != nullptr ? GetCurrentTimeTicks() : 0;
+
     TFLITE_DCHECK(registration->invoke);
     TfLiteStatus invoke_status = registration->invoke(context_, node);
 
+    if (cost != nullptr && invoke_status == kTfLiteOk) {
+      cost->ticks += GetCurrentTimeTicks() - start_ticks;
+      cost->invokes++;
+    }
+
     // All TfLiteTensor structs used in the kernel are allocated from temp
     // memory in the allocator. This creates a chain of allocations in the
     // temp section. The call below resets the chain of allocations to
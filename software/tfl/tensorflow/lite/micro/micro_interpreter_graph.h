@@ -19,6 +19,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/micro_allocator.h"
 #include "tensorflow/lite/micro/micro_common.h"
 #include "tensorflow/lite/micro/micro_graph.h"
+#include "tensorflow/lite/micro/micro_op_cost.h"
 #include "tensorflow/lite/micro/micro_resource_variable.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
@@ -59,9 +60,41 @@ class MicroInterpreterGraph : public MicroGraph {
   // in the model.
   virtual TfLiteStatus InvokeSubgraph(int subgraph_idx);
 
+  // Calls TFLMRegistration->Invoke for the operators [first_operator_idx,
+  // last_operator_idx) of a single subgraph in the model. Running consecutive
+  // ranges back to back is equivalent to a single InvokeSubgraph call.
+  virtual TfLiteStatus InvokeSubgraphRange(int subgraph_idx,
+                                           uint32_t first_operator_idx,
+                                           uint32_t last_operator_idx);
+
   // Zeros out all variable tensors in all subgraphs in the model.
   virtual TfLiteStatus ResetVariableTensors();
 
+  // Optional cancellation token, checked before every operator of
+  // InvokeSubgraphRange. Once *token is true the range stops before the next
+  // operator and returns kTfLiteCancelled. The token may be set from an
+  // interrupt handler or another thread; nullptr disables the check.
+  void SetCancellationToken(const volatile bool* token) {
+    cancellation_token_ = token;
+  }
+
+  // Optional cost table, one entry per operator of subgraph 0. Invoking an
+  // operator adds its ticks; nullptr disables the timing.
+  void SetOpCosts(MicroOpCost* costs, size_t count) {
+    op_costs_ = costs;
+    op_costs_count_ = count;
+  }
+
+  MicroOpCost* op_costs() { return op_costs_; }
+  size_t op_costs_count() const { return op_costs_count_; }
+
+  // Entry of the cost table for an operator, nullptr without one.
+  MicroOpCost* GetOpCost(int subgraph_idx, uint32_t operator_idx) {
+    return (subgraph_idx == 0 && operator_idx < op_costs_count_)
+               ? &op_costs_[operator_idx]
+               : nullptr;
+  }
+
   // Number of tensor inputs to a specified subgraph in the model.
   virtual size_t NumSubgraphInputs(int subgraph_idx);
 
@@ -101,6 +134,9 @@ class MicroInterpreterGraph : public MicroGraph {
  private:
   TfLiteContext* context_;
   const Model* model_;
+  const volatile bool* cancellation_token_ = nullptr;
+  MicroOpCost* op_costs_ = nullptr;
+  size_t op_costs_count_ = 0;
   MicroAllocator* allocator_;
   SubgraphAllocations* subgraph_allocations_ = nullptr;
   int current_subgraph_index_;
@@ -0,0 +1,189 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/lite/micro/micro_op_cost.h"
+
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/micro/flatbuffer_utils.h"
+#include "tensorflow/lite/micro/memory_helpers.h"
+#include "tensorflow/lite/micro/micro_log.h"
+#include "tensorflow/lite/micro/micro_utils.h"
+
+namespace tflite {
+
+namespace {
+
+// Size of a constant tensor in the flatbuffer, 0 for an activation.
+size_t ConstantBytes(const Model* model, const tflite::Tensor* tensor) {
+  const Buffer* buffer = model->buffers()->Get(tensor->buffer());
+  if (buffer == nullptr) {
+    return 0;
+  }
+  if (buffer->data() != nullptr) {
+    return buffer->data()->size();
+  }
+  // buffers of large models sit behind the flatbuffer
+  return buffer->offset() > 1 ? buffer->size() : 0;
+}
+
+uint32_t OperatorMacs(int32_t builtin_code, const TfLiteNode& node,
+                      const TfLiteEvalTensor* tensors) {
+  if (node.outputs->size < 1 || node.inputs->size < 1) {
+    return 0;
+  }
+  const uint32_t output_elements =
+      ElementCount(*tensors[node.outputs->data[0]].dims);
+  switch (builtin_code) {
+    case BuiltinOperator_CONV_2D: {
+      // filter [output channels, height, width, input channels]
+      const TfLiteIntArray* filter = tensors[node.inputs->data[1]].dims;
+      return output_elements * filter->data[1] * filter->data[2] *
+             filter->data[3];
+    }
+    case BuiltinOperator_DEPTHWISE_CONV_2D: {
+      // filter [1, height, width, output channels]
+      const TfLiteIntArray* filter = tensors[node.inputs->data[1]].dims;
+      return output_elements * filter->data[1] * filter->data[2];
+    }
+    case BuiltinOperator_FULLY_CONNECTED: {
+      // weights [outputs, inputs]
+      const TfLiteIntArray* weights = tensors[node.inputs->data[1]].dims;
+      return output_elements * weights->data[weights->size - 1];
+    }
+    case BuiltinOperator_AVERAGE_POOL_2D:
+    case BuiltinOperator_MAX_POOL_2D: {
+      const TfLitePoolParams* params =
+          static_cast<const TfLitePoolParams*>(node.builtin_data);
+      return params == nullptr ? 0
+                               : output_elements * params->filter_height *
+                                     params->filter_width;
+    }
+    case BuiltinOperator_ADD:
+    case BuiltinOperator_SUB:
+    case BuiltinOperator_MUL:
+      return output_elements;
+    default:
+      return 0;
+  }
+}
+
+// num / den with three decimals, as whole and thousandths for printf without
+// floating point support.
+void Milli(uint64_t num, uint64_t den, uint32_t* whole, uint32_t* thousandths) {
+  const uint64_t milli = den == 0 ? 0 : num * 1000 / den;
+  *whole = static_cast<uint32_t>(milli / 1000);
+  *thousandths = static_cast<uint32_t>(milli % 1000);
+}
+
+}  // namespace
+
+TfLiteStatus ComputeMicroOpCosts(const Model* model,
+                                 SubgraphAllocations* allocations,
+                                 MicroOpCost* costs, size_t count) {
+  const SubGraph* subgraph = model->subgraphs()->Get(0);
+  const TfLiteEvalTensor* tensors = allocations[0].tensors;
+  const uint32_t operators_size = NumSubgraphOperators(subgraph);
+  for (uint32_t i = 0; i < operators_size && i < count; ++i) {
+    const NodeAndRegistration& node_and_registration =
+        allocations[0].node_and_registrations[i];
+    const TFLMRegistration* registration = node_and_registration.registration;
+    const TfLiteNode& node = node_and_registration.node;
+    MicroOpCost* cost = &costs[i];
+
+    cost->name =
+        registration->builtin_code == BuiltinOperator_CUSTOM
+            ? registration->custom_name
+            : EnumNameBuiltinOperator(
+                  static_cast<BuiltinOperator>(registration->builtin_code));
+    cost->macs = OperatorMacs(registration->builtin_code, node, tensors);
+    cost->weight_bytes = 0;
+    cost->input_bytes = 0;
+    cost->output_bytes = 0;
+    for (int n = 0; n < node.inputs->size; ++n) {
+      const int tensor_index = node.inputs->data[n];
+      if (tensor_index < 0) {
+        continue;
+      }
+      const size_t constant_bytes =
+          ConstantBytes(model, subgraph->tensors()->Get(tensor_index));
+      if (constant_bytes > 0) {
+        cost->weight_bytes += constant_bytes;
+        continue;
+      }
+      size_t bytes = 0;
+      TF_LITE_ENSURE_STATUS(
+          TfLiteEvalTensorByteLength(&tensors[tensor_index], &bytes));
+      cost->input_bytes += bytes;
+    }
+    for (int n = 0; n < node.outputs->size; ++n) {
+      size_t bytes = 0;
+      TF_LITE_ENSURE_STATUS(TfLiteEvalTensorByteLength(
+          &tensors[node.outputs->data[n]], &bytes));
+      cost->output_bytes += bytes;
+    }
+  }
+  return kTfLiteOk;
+}
+
+const char* MicroOpCostCsvHeader() {
+  return "op,name,macs,weight_bytes,input_bytes,output_bytes,scratch_bytes,"
+         "cycles,macs_per_cycle,bytes_per_cycle,macs_per_byte";
+}
+
+int FormatMicroOpCostCsv(const MicroOpCost& cost, int index,
+                         uint32_t cycles_per_tick, char* buffer, size_t size) {
+  const uint64_t cycles =
+      cost.invokes == 0 ? 0
+                        : static_cast<uint64_t>(cost.ticks) * cycles_per_tick /
+                              cost.invokes;
+  const uint64_t bytes = static_cast<uint64_t>(cost.weight_bytes) +
+                         cost.input_bytes + cost.output_bytes;
+  uint32_t macs_per_cycle[2];
+  uint32_t bytes_per_cycle[2];
+  uint32_t macs_per_byte[2];
+  Milli(cost.macs, cycles, &macs_per_cycle[0], &macs_per_cycle[1]);
+  Milli(bytes, cycles, &bytes_per_cycle[0], &bytes_per_cycle[1]);
+  Milli(cost.macs, bytes, &macs_per_byte[0], &macs_per_byte[1]);
+  return MicroSnprintf(
+      buffer, size,
+      "%d,%s,%lu,%ld,%ld,%ld,%ld,%lu,%lu.%03lu,%lu.%03lu,%lu.%03lu", index,
+      cost.name != nullptr ? cost.name : "",
+      static_cast<unsigned long>(cost.macs),
+      static_cast<long>(cost.weight_bytes), static_cast<long>(cost.input_bytes),
+      static_cast<long>(cost.output_bytes),
+      static_cast<long>(cost.scratch_bytes), static_cast<unsigned long>(cycles),
+      static_cast<unsigned long>(macs_per_cycle[0]),
+      static_cast<unsigned long>(macs_per_cycle[1]),
+      static_cast<unsigned long>(bytes_per_cycle[0]),
+      static_cast<unsigned long>(bytes_per_cycle[1]),
+      static_cast<unsigned long>(macs_per_byte[0]),
+      static_cast<unsigned long>(macs_per_byte[1]));
+}
+
+void LogMicroOpCostsCsv(const MicroOpCost* costs, size_t count,
+                        uint32_t cycles_per_tick) {
+  MicroPrintf("%s", MicroOpCostCsvHeader());
+  char row[160];
+  for (size_t i = 0; i < count; ++i) {
+    // entries past the last operator stay empty
+    if (costs[i].name == nullptr) {
+      break;
+    }
+    FormatMicroOpCostCsv(costs[i], i, cycles_per_tick, row, sizeof(row));
+    MicroPrintf("%s", row);
+  }
+}
+
+}  // namespace tflite
@@ -0,0 +1,73 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_OP_COST_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_OP_COST_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "tensorflow/lite/c/common.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+namespace tflite {
+
+// Work and measured time of one operator of the first subgraph, for a
+// roofline view: an operator whose MACs per cycle stay far below the kernel's
+// peak while its bytes per cycle are high waits on memory (on an XIP target
+// mostly on the weights in flash), the opposite one on arithmetic.
+struct MicroOpCost {
+  const char* name;
+  // Multiply-accumulates per Invoke() of convolutions and fully connected
+  // layers. Pooling counts one per window element, elementwise ADD, SUB and
+  // MUL one per output element, all other operators none.
+  uint32_t macs;
+  // Constant inputs, read from the flatbuffer.
+  int32_t weight_bytes;
+  // Activations read from and written to the arena.
+  int32_t input_bytes;
+  int32_t output_bytes;
+  // Scratch buffers the kernel requested in Prepare.
+  int32_t scratch_bytes;
+  // GetCurrentTimeTicks() spent in the kernel, summed over `invokes` runs.
+  uint32_t ticks;
+  uint32_t invokes;
+};
+
+// Fills the shape-derived fields of costs[i] for operator i of subgraph 0,
+// up to count operators. Needs prepared nodes (builtin data and tensor
+// shapes), so call after the kernels' Prepare.
+TfLiteStatus ComputeMicroOpCosts(const Model* model,
+                                 SubgraphAllocations* allocations,
+                                 MicroOpCost* costs, size_t count);
+
+// Column names of the rows FormatMicroOpCostCsv() writes.
+const char* MicroOpCostCsvHeader();
+
+// Writes one CSV row, without line end, into buffer and returns its length
+// as snprintf does. Times are per Invoke() in clock cycles,
+// cycles_per_tick = clock / ticks_per_second().
+int FormatMicroOpCostCsv(const MicroOpCost& cost, int index,
+                         uint32_t cycles_per_tick, char* buffer, size_t size);
+
+// Prints the header and a row per operator through MicroPrintf. count may
+// exceed the number of operators.
+void LogMicroOpCostsCsv(const MicroOpCost* costs, size_t count,
+                        uint32_t cycles_per_tick);
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_MICRO_OP_COST_H_
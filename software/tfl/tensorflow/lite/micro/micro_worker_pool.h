@@ -0,0 +1,101 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_LITE_MICRO_MICRO_WORKER_POOL_H_
+#define TENSORFLOW_LITE_MICRO_MICRO_WORKER_POOL_H_
+
+#include <cstdint>
+
+namespace tflite {
+
+// Upper bound of the parts an operator is split into. A task keeps the status
+// of every part in an array of this size and the kernel checks them after
+// Run().
+constexpr int kMaxWorkerParts = 8;
+
+// Interface class for intra-operator parallelism. Kernels reach the pool
+// through MicroContext::worker_pool() and split the output of an operator into
+// disjoint parts, one per worker. Run() is a barrier: it returns once every
+// part is done, so the next operator sees the whole output.
+class MicroWorkerPool {
+ public:
+  // Runs one part of an operator. worker is in [0, num_parts).
+  typedef void (*Task)(void* data, int worker, int num_parts);
+
+  explicit MicroWorkerPool(int32_t min_work_per_worker)
+      : min_work_per_worker_(min_work_per_worker) {}
+  virtual ~MicroWorkerPool() {}
+
+  // Workers including the calling one. Kernels plan per-worker scratch
+  // buffers for this many in Prepare.
+  virtual int num_workers() const = 0;
+
+  // Calls task(data, w, num_parts) for every w in [0, num_parts), part 0 on
+  // the calling core, and returns after the last one. num_parts is at most
+  // num_workers() and kMaxWorkerParts.
+  virtual void Run(Task task, void* data, int num_parts) = 0;
+
+  // Number of parts worth splitting an operator of `work` multiply-accumulates
+  // (or comparable inner-loop steps) into, at least 1. Below
+  // min_work_per_worker per part the hand-over costs more than it saves.
+  // Never more than kMaxWorkerParts.
+  int PartsFor(int64_t work) const {
+    int64_t parts = work / min_work_per_worker_;
+    if (parts < 1) {
+      return 1;
+    }
+    int workers = num_workers() < kMaxWorkerParts ? num_workers()
+                                                  : kMaxWorkerParts;
+    return parts < workers ? static_cast<int>(parts) : workers;
+  }
+
+ private:
+  const int32_t min_work_per_worker_;
+};
+
+// Splits [0, count) into num_parts contiguous ranges that differ by at most
+// one granule and returns the range of `part` in [*start, *end). Every start
+// but the last range's end is a multiple of granule.
+inline void PartitionRange(int count, int granule, int part, int num_parts,
+                           int* start, int* end) {
+  const int granules = (count + granule - 1) / granule;
+  const int per_part = granules / num_parts;
+  const int extra = granules % num_parts;
+  const int first = part * per_part + (part < extra ? part : extra);
+  const int last = first + per_part + (part < extra ? 1 : 0);
+  *start = first * granule < count ? first * granule : count;
+  *end = last * granule < count ? last * granule : count;
+}
+
+// Input rows [*in_start, *in_end) that output rows [out_start, out_end) of a
+// sliding window operator (convolution, pooling) read, and the padding rows
+// above *in_start. extent is the height of the dilated window. The rows below
+// *in_end are outside the input and count as padding as before.
+inline void WindowInputRows(int out_start, int out_end, int stride,
+                            int padding, int extent, int input_height,
+                            int* in_start, int* in_end, int* top_padding) {
+  const int first = out_start * stride - padding;
+  const int last = (out_end - 1) * stride - padding + extent;
+  *in_start = first > 0 ? first : 0;
+  *in_end = last < input_height ? last : input_height;
+  *top_padding = *in_start - first;
+  if (*in_end < *in_start) {
+    *in_end = *in_start;
+  }
+}
+
+}  // namespace tflite
+
+#endif  // TENSORFLOW_LITE_MICRO_MICRO_WORKER_POOL_H_
@@ -20,6 +20,7 @@ limitations under the License.
 #include "tensorflow/lite/micro/compatibility.h"
 #include "tensorflow/lite/micro/memory_helpers.h"
 #include "tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
 #include "tensorflow/lite/micro/micro_allocator.h"
 #include "tensorflow/lite/micro/micro_log.h"
 
@@ -78,6 +79,8 @@ RecordedAllocation RecordingMicroAllocator::GetRecordedAllocation(
       return recorded_node_and_registration_array_data_;
     case RecordedAllocationType::kOpData:
       return recorded_op_data_;
+    case RecordedAllocationType::kScratchBufferData:
+      return recorded_scratch_buffer_data_;
     // the function MicroPrintf was never reached outside the switch, because
     // each case has a return. As the intention of the MicroPrintf is to be
     // called when no matching case is found, a default case was added to
@@ -117,6 +120,8 @@ void RecordingMicroAllocator::PrintAllocations() const {
                           "NodeAndRegistration structs");
   PrintRecordedAllocation(RecordedAllocationType::kOpData,
                           "Operator runtime data", "OpData structs");
+  PrintRecordedAllocation(RecordedAllocationType::kScratchBufferData,
+                          "Scratch buffer data", "scratch buffers");
 }
 
 void* RecordingMicroAllocator::AllocatePersistentBuffer(size_t bytes) {
@@ -127,6 +132,19 @@ void* RecordingMicroAllocator::AllocatePersistentBuffer(size_t bytes) {
   return buffer;
 }
 
+TfLiteStatus RecordingMicroAllocator::RequestScratchBufferInArena(
+    size_t bytes, int subgraph_idx, int* buffer_idx) {
+  TF_LITE_ENSURE_STATUS(MicroAllocator::RequestScratchBufferInArena(
+      bytes, subgraph_idx, buffer_idx));
+  // Scratch buffers only take space once the memory plan is committed, so the
+  // request is recorded directly instead of diffing the arena usage.
+  recorded_scratch_buffer_data_.requested_bytes += bytes;
+  recorded_scratch_buffer_data_.used_bytes +=
+      AlignSizeUp(bytes, MicroArenaBufferAlignment());
+  recorded_scratch_buffer_data_.count++;
+  return kTfLiteOk;
+}
+
 void RecordingMicroAllocator::PrintRecordedAllocation(
     RecordedAllocationType allocation_type, const char* allocation_name,
     const char* allocation_description) const {
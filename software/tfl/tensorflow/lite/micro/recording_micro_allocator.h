@@ -24,7 +24,6 @@ namespace tflite {
 
 // List of buckets currently recorded by this class. Each type keeps a list of
 // allocated information during model initialization.
-// TODO(b/169834511): Add tracking for scratch buffer allocations.
 enum class RecordedAllocationType {
   kTfLiteEvalTensorData,
   kPersistentTfLiteTensorData,
@@ -33,6 +32,10 @@ enum class RecordedAllocationType {
   kTfLiteTensorVariableBufferData,
   kNodeAndRegistrationArray,
   kOpData,
+  // Requested scratch buffer bytes. These are planned into the head section
+  // together with the activations, used_bytes is the requested size aligned
+  // to MicroArenaBufferAlignment().
+  kScratchBufferData,
 };
 
 // Container for holding information about allocation recordings by a given
@@ -72,6 +75,9 @@ class RecordingMicroAllocator : public MicroAllocator {
 
   void* AllocatePersistentBuffer(size_t bytes) override;
 
+  TfLiteStatus RequestScratchBufferInArena(size_t bytes, int subgraph_idx,
+                                           int* buffer_idx) override;
+
  protected:
   TfLiteStatus AllocateNodeAndRegistrations(
       const Model* model, SubgraphAllocations* subgraph_allocations) override;
@@ -116,6 +122,7 @@ class RecordingMicroAllocator : public MicroAllocator {
 
   // TODO(b/187993291): Re-enable OpData allocating tracking.
   RecordedAllocation recorded_op_data_ = {};
+  RecordedAllocation recorded_scratch_buffer_data_ = {};
 
   TF_LITE_REMOVE_VIRTUAL_DELETE
 };
@@ -0,0 +1,85 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* ----------------------------------------------------------------------
+ * Title:        arm_nn_x86.h
+ * Description:  SSE4.1 / AVX2 inner loops for host builds of the s8 kernels
+ *
+ * Only compiled when ARM_NN_X86_SIMD is defined (host tools on x86). The
+ * kernels keep their scalar requantization epilogue and only hand the
+ * integer dot products and the max pooling comparisons to these functions,
+ * so the results are bit-exact with the portable C path.
+ * -------------------------------------------------------------------- */
+
+#ifndef ARM_NN_X86_H
+#define ARM_NN_X86_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARM_NN_X86_NONE (0)
+#define ARM_NN_X86_SSE41 (1)
+#define ARM_NN_X86_AVX2 (2)
+
+/**
+ * @brief Instruction set used by the kernels: the best one the CPU supports, limited by arm_nn_x86_set_level().
+ */
+int32_t arm_nn_x86_level(void);
+
+/**
+ * @brief Limits the instruction set, ARM_NN_X86_NONE selects the portable C path. A negative level restores
+ *        the detected one.
+ */
+void arm_nn_x86_set_level(int32_t level);
+
+/**
+ * @brief sum((lhs[i] + lhs_offset) * (rhs[i] + rhs_offset)) over length elements. The offsets are in [-255, 255].
+ */
+int32_t arm_nn_x86_dot_s8(const int8_t *lhs, const int8_t *rhs, int32_t lhs_offset, int32_t rhs_offset, int32_t length);
+
+/**
+ * @brief sum(lhs[i] * rhs[i]) over length elements, rhs is an im2col column in [-255, 255].
+ */
+int32_t arm_nn_x86_dot_s8_s16(const int8_t *lhs, const int16_t *rhs, int32_t length);
+
+/**
+ * @brief The dot products of the filter rows lhs_0, lhs_1 with the im2col columns rhs_0, rhs_1 over length
+ *        elements, sum[2 * row + column].
+ */
+void arm_nn_x86_dot_s8_s16_2x2(const int8_t *lhs_0,
+                               const int8_t *lhs_1,
+                               const int16_t *rhs_0,
+                               const int16_t *rhs_1,
+                               int32_t length,
+                               int32_t *sum);
+
+/**
+ * @brief base[i] = max(base[i], target[i]) over length elements.
+ */
+void arm_nn_x86_max_s8(int8_t *base, const int8_t *target, int32_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARM_NN_X86_H */
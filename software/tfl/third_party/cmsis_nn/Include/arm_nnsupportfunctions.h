@@ -1313,6 +1313,40 @@ __STATIC_FORCEINLINE int32_t arm_nn_doubling_high_mult(const int32_t m1, const i
     return result;
 }
 
+/**
+ * @brief           Doubling high multiply without saturation using only 32x32->32
+ *                  multiplications on 16-bit halves. Same result as
+ *                  arm_nn_doubling_high_mult_no_sat for cores that lack a long
+ *                  multiply (e.g. Cortex-M0+), where the 64-bit product is a
+ *                  library call. Selected by defining CMSIS_NN_USE_REQUANTIZE_32BIT.
+ *
+ * @param[in]       m1        Multiplicand. Range: {NN_Q31_MIN, NN_Q31_MAX}
+ * @param[in]       m2        Multiplier Range: {NN_Q31_MIN, NN_Q31_MAX}
+ * @return          Result of multiplication.
+ *
+ */
+__STATIC_FORCEINLINE int32_t arm_nn_doubling_high_mult_no_sat_32x32(const int32_t m1, const int32_t m2)
+{
+    const int32_t m1_hi = m1 >> 16;
+    const int32_t m2_hi = m2 >> 16;
+    const int32_t m1_lo = m1 & 0xFFFF;
+    const int32_t m2_lo = m2 & 0xFFFF;
+
+    // High and low word of the 64-bit product
+    const uint32_t lo_lo = (uint32_t)m1_lo * (uint32_t)m2_lo;
+    const int32_t cross1 = m1_hi * m2_lo + (int32_t)(lo_lo >> 16);
+    const int32_t cross2 = m1_lo * m2_hi + (cross1 & 0xFFFF);
+    int32_t high = m1_hi * m2_hi + (cross1 >> 16) + (cross2 >> 16);
+    const uint32_t low = (uint32_t)m1 * (uint32_t)m2;
+
+    // Rounding offset to add for a right shift of 31
+    const uint32_t sum = low + (1U << 30);
+    high += (sum < low);
+
+    // Bits 31 to 62 of the sum. This is the doubling step as well.
+    return (int32_t)(((uint32_t)high << 1) | (sum >> 31));
+}
+
 /**
  * @brief           Doubling high multiply without saturation. This is intended
  *                  for requantization where the scale is a positive integer
@@ -1329,6 +1363,9 @@ __STATIC_FORCEINLINE int32_t arm_nn_doubling_high_mult(const int32_t m1, const i
  */
 __STATIC_FORCEINLINE int32_t arm_nn_doubling_high_mult_no_sat(const int32_t m1, const int32_t m2)
 {
+#ifdef CMSIS_NN_USE_REQUANTIZE_32BIT
+    return arm_nn_doubling_high_mult_no_sat_32x32(m1, m2);
+#else
     int32_t result = 0;
     union arm_nn_long_long mult;
 
@@ -1344,6 +1381,7 @@ __STATIC_FORCEINLINE int32_t arm_nn_doubling_high_mult_no_sat(const int32_t m1,
     result = (int32_t)(mult.long_long >> 31);
 
     return result;
+#endif
 }
 
 /**
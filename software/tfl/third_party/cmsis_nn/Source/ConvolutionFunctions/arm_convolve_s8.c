@@ -30,6 +30,9 @@
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+#if defined(ARM_NN_X86_SIMD)
+    #include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#endif
 /**
  *  @ingroup Public
  */
@@ -283,7 +286,15 @@ arm_cmsis_nn_status arm_convolve_s8(const cmsis_nn_context *ctx,
 
                     const int16_t *ip_as_col = buffer_a;
 
-    #if defined(ARM_MATH_DSP)
+    #if defined(ARM_NN_X86_SIMD)
+                    uint16_t col_count = rhs_cols;
+                    if (arm_nn_x86_level() != ARM_NN_X86_NONE)
+                    {
+                        sum += arm_nn_x86_dot_s8_s16(ker_a, ip_as_col, rhs_cols);
+                        ker_a += rhs_cols;
+                        col_count = 0;
+                    }
+    #elif defined(ARM_MATH_DSP)
                     /* 4 multiply and accumulates are done in one loop. */
                     uint16_t col_count = rhs_cols / 4;
                     while (col_count)
@@ -29,6 +29,9 @@
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+#if defined(ARM_NN_X86_SIMD)
+    #include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#endif
 
 /*
  * Matrix-multiplication function for convolution with per-channel requantization.
@@ -51,6 +54,51 @@ int8_t *arm_nn_mat_mult_kernel_s8_s16(const int8_t *input_a,
                                       int8_t *out_0)
 {
 #if !defined(ARM_MATH_MVEI)
+    #if defined(ARM_NN_X86_SIMD)
+    if (arm_nn_x86_level() != ARM_NN_X86_NONE)
+    {
+        int8_t *out_1 = out_0 + output_ch;
+        for (int32_t i = 0; i < output_ch; i += 2)
+        {
+            /* an odd last row is computed twice and stored once */
+            const int32_t i_1 = i + 1 < output_ch ? i + 1 : i;
+            int32_t sum[4];
+            arm_nn_x86_dot_s8_s16_2x2(input_a + i * num_col_a,
+                                      input_a + i_1 * num_col_a,
+                                      input_b,
+                                      input_b + aligned_num_col_a,
+                                      num_col_a,
+                                      sum);
+
+            for (int32_t row = i; row <= i_1; row++)
+            {
+                int32_t ch_out_0 = sum[2 * (row - i)];
+                int32_t ch_out_1 = sum[2 * (row - i) + 1];
+                if (output_bias)
+                {
+                    ch_out_0 += output_bias[row];
+                    ch_out_1 += output_bias[row];
+                }
+
+                ch_out_0 = arm_nn_requantize(ch_out_0, out_mult[row], out_shift[row]);
+                ch_out_0 += out_offset;
+                ch_out_0 = MAX(ch_out_0, activation_min);
+                ch_out_0 = MIN(ch_out_0, activation_max);
+                out_0[row] = (int8_t)ch_out_0;
+
+                ch_out_1 = arm_nn_requantize(ch_out_1, out_mult[row], out_shift[row]);
+                ch_out_1 += out_offset;
+                ch_out_1 = MAX(ch_out_1, activation_min);
+                ch_out_1 = MIN(ch_out_1, activation_max);
+                out_1[row] = (int8_t)ch_out_1;
+            }
+        }
+
+        /* return the new output pointer with offset */
+        return out_1 + output_ch;
+    }
+    #endif
+
     /* set up the second output pointers */
     int8_t *out_1 = out_0 + output_ch;
     const int32_t *bias = output_bias;
@@ -31,6 +31,8 @@
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
 
+#define FC_WEIGHT_STATIONARY_ROWS (6)
+
 /**
  *  @ingroup Public
  */
@@ -72,6 +74,47 @@ arm_cmsis_nn_status arm_fully_connected_s8(const cmsis_nn_context *ctx,
 
     const int32_t *kernel_sum = (const int32_t *)ctx->buf;
 
+#if !defined(ARM_MATH_MVEI)
+    if (batch_cnt > 1)
+    {
+        /* Weight-stationary loop order: a small block of filter rows is applied to every batch row before moving on,
+         * so each weight byte is fetched from (XIP) memory once per block instead of once per batch row. The block
+         * size is a multiple of the 2 and 3 row unroll factors of arm_nn_vec_mat_mult_t_s8(). */
+        const int32_t rhs_cols = filter_dims->n;
+        const int32_t rhs_rows = output_dims->c;
+
+        for (int32_t row = 0; row < rhs_rows; row += FC_WEIGHT_STATIONARY_ROWS)
+        {
+            const int32_t block_rows = MIN(FC_WEIGHT_STATIONARY_ROWS, rhs_rows - row);
+            const int8_t *lhs = input;
+            int8_t *dst = output + row;
+
+            for (int32_t i_batch = 0; i_batch < batch_cnt; i_batch++)
+            {
+                arm_nn_vec_mat_mult_t_s8(lhs,
+                                         kernel + row * rhs_cols,
+                                         kernel_sum,
+                                         bias ? bias + row : NULL,
+                                         dst,
+                                         fc_params->input_offset,
+                                         fc_params->output_offset,
+                                         quant_params->multiplier,
+                                         quant_params->shift,
+                                         rhs_cols,
+                                         block_rows,
+                                         fc_params->activation.min,
+                                         fc_params->activation.max,
+                                         1L,
+                                         fc_params->filter_offset);
+
+                lhs += rhs_cols;
+                dst += rhs_rows;
+            }
+        }
+        return (ARM_CMSIS_NN_SUCCESS);
+    }
+#endif
+
     while (batch_cnt)
     {
 
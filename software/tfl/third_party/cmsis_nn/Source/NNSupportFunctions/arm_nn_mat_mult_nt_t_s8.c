@@ -40,7 +40,9 @@
  */
 
 // Uncomment this to try the experimental dual core support on the RP2040.
-#define TF_LITE_PICO_MULTICORE
+// It relaunches core 1 on every call, so it cannot be combined with the
+// worker pool (micro_worker_pool.h) that the kernels split operators over.
+// #define TF_LITE_PICO_MULTICORE
 
 #ifdef TF_LITE_PICO_MULTICORE
 
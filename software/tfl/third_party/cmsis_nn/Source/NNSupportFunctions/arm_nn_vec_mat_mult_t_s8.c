@@ -29,6 +29,9 @@
  * -------------------------------------------------------------------- */
 
 #include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+#if defined(ARM_NN_X86_SIMD)
+    #include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#endif
 
 /**
  * @ingroup groupSupport
@@ -71,6 +74,38 @@ arm_cmsis_nn_status arm_nn_vec_mat_mult_t_s8(const int8_t *lhs,
                                              const int32_t address_offset,
                                              const int32_t rhs_offset)
 {
+#if defined(ARM_NN_X86_SIMD)
+    if (arm_nn_x86_level() != ARM_NN_X86_NONE)
+    {
+        (void)kernel_sum;
+
+        for (int32_t i_row = 0; i_row < rhs_rows; i_row++)
+        {
+            int32_t res00 = 0;
+            if (bias)
+            {
+                res00 = *bias++;
+            }
+            res00 += arm_nn_x86_dot_s8(lhs, rhs, lhs_offset, rhs_offset, rhs_cols);
+
+            // Quantize down
+            res00 = arm_nn_requantize(res00, dst_multiplier, dst_shift);
+
+            // Add offset
+            res00 += dst_offset;
+
+            // Clamp the result
+            res00 = MAX(res00, activation_min);
+            res00 = MIN(res00, activation_max);
+
+            *dst = (int8_t)res00;
+            dst += address_offset;
+            rhs += rhs_cols;
+        }
+        return ARM_CMSIS_NN_SUCCESS;
+    }
+#endif
+
     if (rhs_offset)
     {
 #if defined(ARM_MATH_MVEI)
@@ -0,0 +1,334 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/* ----------------------------------------------------------------------
+ * Title:        arm_nn_x86.c
+ * Description:  SSE4.1 / AVX2 inner loops for host builds of the s8 kernels
+ *
+ * The functions are compiled for their instruction set with the target
+ * attribute, the rest of the library keeps the baseline x86 flags. The
+ * 8-bit operands are widened to 16 bits and multiplied with pmaddwd: with
+ * both factors in [-255, 255] no product pair overflows, and the int32 sums
+ * wrap like the scalar loop.
+ * -------------------------------------------------------------------- */
+
+#if defined(ARM_NN_X86_SIMD)
+
+    #include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+
+    #include <immintrin.h>
+
+static int32_t detected_level = -1;
+static int32_t level_limit = ARM_NN_X86_AVX2;
+
+int32_t arm_nn_x86_level(void)
+{
+    if (detected_level < 0)
+    {
+        __builtin_cpu_init();
+        detected_level = ARM_NN_X86_NONE;
+        if (__builtin_cpu_supports("sse4.1"))
+        {
+            detected_level = ARM_NN_X86_SSE41;
+        }
+        if (__builtin_cpu_supports("avx2"))
+        {
+            detected_level = ARM_NN_X86_AVX2;
+        }
+    }
+    return detected_level < level_limit ? detected_level : level_limit;
+}
+
+void arm_nn_x86_set_level(int32_t level)
+{
+    level_limit = level < 0 ? ARM_NN_X86_AVX2 : level;
+}
+
+__attribute__((target("avx2"))) static int32_t hsum_avx2(__m256i acc)
+{
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("sse4.1"))) static int32_t hsum_sse41(__m128i sum)
+{
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(sum);
+}
+
+__attribute__((target("avx2"))) static int32_t
+dot_s8_avx2(const int8_t *lhs, const int8_t *rhs, int32_t lhs_offset, int32_t rhs_offset, int32_t length)
+{
+    const __m256i lhs_off = _mm256_set1_epi16((int16_t)lhs_offset);
+    const __m256i rhs_off = _mm256_set1_epi16((int16_t)rhs_offset);
+    __m256i acc = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m256i a = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        __m256i b = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(rhs + i)));
+        a = _mm256_add_epi16(a, lhs_off);
+        b = _mm256_add_epi16(b, rhs_off);
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+    }
+    if (i + 8 <= length)
+    {
+        __m128i a = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs + i)));
+        __m128i b = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(rhs + i)));
+        a = _mm_add_epi16(a, _mm256_castsi256_si128(lhs_off));
+        b = _mm_add_epi16(b, _mm256_castsi256_si128(rhs_off));
+        acc = _mm256_add_epi32(acc, _mm256_zextsi128_si256(_mm_madd_epi16(a, b)));
+        i += 8;
+    }
+    int32_t sum = hsum_avx2(acc);
+    for (; i < length; i++)
+    {
+        sum += (lhs[i] + lhs_offset) * (rhs[i] + rhs_offset);
+    }
+    return sum;
+}
+
+__attribute__((target("sse4.1"))) static int32_t
+dot_s8_sse41(const int8_t *lhs, const int8_t *rhs, int32_t lhs_offset, int32_t rhs_offset, int32_t length)
+{
+    const __m128i lhs_off = _mm_set1_epi16((int16_t)lhs_offset);
+    const __m128i rhs_off = _mm_set1_epi16((int16_t)rhs_offset);
+    __m128i acc = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        __m128i a = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs + i)));
+        __m128i b = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(rhs + i)));
+        a = _mm_add_epi16(a, lhs_off);
+        b = _mm_add_epi16(b, rhs_off);
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(a, b));
+    }
+    int32_t sum = hsum_sse41(acc);
+    for (; i < length; i++)
+    {
+        sum += (lhs[i] + lhs_offset) * (rhs[i] + rhs_offset);
+    }
+    return sum;
+}
+
+int32_t arm_nn_x86_dot_s8(const int8_t *lhs, const int8_t *rhs, int32_t lhs_offset, int32_t rhs_offset, int32_t length)
+{
+    if (arm_nn_x86_level() == ARM_NN_X86_AVX2)
+    {
+        return dot_s8_avx2(lhs, rhs, lhs_offset, rhs_offset, length);
+    }
+    return dot_s8_sse41(lhs, rhs, lhs_offset, rhs_offset, length);
+}
+
+__attribute__((target("avx2"))) static int32_t dot_s8_s16_avx2(const int8_t *lhs, const int16_t *rhs, int32_t length)
+{
+    __m256i acc = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m256i a = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs + i)));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(rhs + i));
+        acc = _mm256_add_epi32(acc, _mm256_madd_epi16(a, b));
+    }
+    if (i + 8 <= length)
+    {
+        __m128i a = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs + i)));
+        __m128i b = _mm_loadu_si128((const __m128i *)(rhs + i));
+        acc = _mm256_add_epi32(acc, _mm256_zextsi128_si256(_mm_madd_epi16(a, b)));
+        i += 8;
+    }
+    int32_t sum = hsum_avx2(acc);
+    for (; i < length; i++)
+    {
+        sum += lhs[i] * rhs[i];
+    }
+    return sum;
+}
+
+__attribute__((target("sse4.1"))) static int32_t dot_s8_s16_sse41(const int8_t *lhs, const int16_t *rhs, int32_t length)
+{
+    __m128i acc = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        __m128i a = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs + i)));
+        __m128i b = _mm_loadu_si128((const __m128i *)(rhs + i));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(a, b));
+    }
+    int32_t sum = hsum_sse41(acc);
+    for (; i < length; i++)
+    {
+        sum += lhs[i] * rhs[i];
+    }
+    return sum;
+}
+
+int32_t arm_nn_x86_dot_s8_s16(const int8_t *lhs, const int16_t *rhs, int32_t length)
+{
+    if (arm_nn_x86_level() == ARM_NN_X86_AVX2)
+    {
+        return dot_s8_s16_avx2(lhs, rhs, length);
+    }
+    return dot_s8_s16_sse41(lhs, rhs, length);
+}
+
+__attribute__((target("avx2"))) static void dot_s8_s16_2x2_avx2(
+    const int8_t *lhs_0, const int8_t *lhs_1, const int16_t *rhs_0, const int16_t *rhs_1, int32_t length, int32_t *sum)
+{
+    __m256i acc_00 = _mm256_setzero_si256();
+    __m256i acc_01 = _mm256_setzero_si256();
+    __m256i acc_10 = _mm256_setzero_si256();
+    __m256i acc_11 = _mm256_setzero_si256();
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m256i a0 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs_0 + i)));
+        __m256i a1 = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i *)(lhs_1 + i)));
+        __m256i b0 = _mm256_loadu_si256((const __m256i *)(rhs_0 + i));
+        __m256i b1 = _mm256_loadu_si256((const __m256i *)(rhs_1 + i));
+        acc_00 = _mm256_add_epi32(acc_00, _mm256_madd_epi16(a0, b0));
+        acc_01 = _mm256_add_epi32(acc_01, _mm256_madd_epi16(a0, b1));
+        acc_10 = _mm256_add_epi32(acc_10, _mm256_madd_epi16(a1, b0));
+        acc_11 = _mm256_add_epi32(acc_11, _mm256_madd_epi16(a1, b1));
+    }
+    /* 8 more columns in the low lanes, the filters have multiples of 8 columns for 3x3 kernels of 8 channels */
+    if (i + 8 <= length)
+    {
+        __m128i a0 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs_0 + i)));
+        __m128i a1 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs_1 + i)));
+        __m128i b0 = _mm_loadu_si128((const __m128i *)(rhs_0 + i));
+        __m128i b1 = _mm_loadu_si128((const __m128i *)(rhs_1 + i));
+        acc_00 = _mm256_add_epi32(acc_00, _mm256_zextsi128_si256(_mm_madd_epi16(a0, b0)));
+        acc_01 = _mm256_add_epi32(acc_01, _mm256_zextsi128_si256(_mm_madd_epi16(a0, b1)));
+        acc_10 = _mm256_add_epi32(acc_10, _mm256_zextsi128_si256(_mm_madd_epi16(a1, b0)));
+        acc_11 = _mm256_add_epi32(acc_11, _mm256_zextsi128_si256(_mm_madd_epi16(a1, b1)));
+        i += 8;
+    }
+    /* the four horizontal sums in one vector */
+    __m256i sums = _mm256_hadd_epi32(_mm256_hadd_epi32(acc_00, acc_01), _mm256_hadd_epi32(acc_10, acc_11));
+    __m128i total = _mm_add_epi32(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+    _mm_storeu_si128((__m128i *)sum, total);
+    for (; i < length; i++)
+    {
+        sum[0] += lhs_0[i] * rhs_0[i];
+        sum[1] += lhs_0[i] * rhs_1[i];
+        sum[2] += lhs_1[i] * rhs_0[i];
+        sum[3] += lhs_1[i] * rhs_1[i];
+    }
+}
+
+__attribute__((target("sse4.1"))) static void dot_s8_s16_2x2_sse41(
+    const int8_t *lhs_0, const int8_t *lhs_1, const int16_t *rhs_0, const int16_t *rhs_1, int32_t length, int32_t *sum)
+{
+    __m128i acc_00 = _mm_setzero_si128();
+    __m128i acc_01 = _mm_setzero_si128();
+    __m128i acc_10 = _mm_setzero_si128();
+    __m128i acc_11 = _mm_setzero_si128();
+    int32_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        __m128i a0 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs_0 + i)));
+        __m128i a1 = _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i *)(lhs_1 + i)));
+        __m128i b0 = _mm_loadu_si128((const __m128i *)(rhs_0 + i));
+        __m128i b1 = _mm_loadu_si128((const __m128i *)(rhs_1 + i));
+        acc_00 = _mm_add_epi32(acc_00, _mm_madd_epi16(a0, b0));
+        acc_01 = _mm_add_epi32(acc_01, _mm_madd_epi16(a0, b1));
+        acc_10 = _mm_add_epi32(acc_10, _mm_madd_epi16(a1, b0));
+        acc_11 = _mm_add_epi32(acc_11, _mm_madd_epi16(a1, b1));
+    }
+    _mm_storeu_si128((__m128i *)sum, _mm_hadd_epi32(_mm_hadd_epi32(acc_00, acc_01), _mm_hadd_epi32(acc_10, acc_11)));
+    for (; i < length; i++)
+    {
+        sum[0] += lhs_0[i] * rhs_0[i];
+        sum[1] += lhs_0[i] * rhs_1[i];
+        sum[2] += lhs_1[i] * rhs_0[i];
+        sum[3] += lhs_1[i] * rhs_1[i];
+    }
+}
+
+void arm_nn_x86_dot_s8_s16_2x2(const int8_t *lhs_0,
+                               const int8_t *lhs_1,
+                               const int16_t *rhs_0,
+                               const int16_t *rhs_1,
+                               int32_t length,
+                               int32_t *sum)
+{
+    if (arm_nn_x86_level() == ARM_NN_X86_AVX2)
+    {
+        dot_s8_s16_2x2_avx2(lhs_0, lhs_1, rhs_0, rhs_1, length, sum);
+    }
+    else
+    {
+        dot_s8_s16_2x2_sse41(lhs_0, lhs_1, rhs_0, rhs_1, length, sum);
+    }
+}
+
+__attribute__((target("avx2"))) static void max_s8_avx2(int8_t *base, const int8_t *target, int32_t length)
+{
+    int32_t i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(base + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(target + i));
+        _mm256_storeu_si256((__m256i *)(base + i), _mm256_max_epi8(a, b));
+    }
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(base + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(target + i));
+        _mm_storeu_si128((__m128i *)(base + i), _mm_max_epi8(a, b));
+    }
+    for (; i < length; i++)
+    {
+        base[i] = target[i] > base[i] ? target[i] : base[i];
+    }
+}
+
+__attribute__((target("sse4.1"))) static void max_s8_sse41(int8_t *base, const int8_t *target, int32_t length)
+{
+    int32_t i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i *)(base + i));
+        __m128i b = _mm_loadu_si128((const __m128i *)(target + i));
+        _mm_storeu_si128((__m128i *)(base + i), _mm_max_epi8(a, b));
+    }
+    for (; i < length; i++)
+    {
+        base[i] = target[i] > base[i] ? target[i] : base[i];
+    }
+}
+
+void arm_nn_x86_max_s8(int8_t *base, const int8_t *target, int32_t length)
+{
+    if (arm_nn_x86_level() == ARM_NN_X86_AVX2)
+    {
+        max_s8_avx2(base, target, length);
+    }
+    else
+    {
+        max_s8_sse41(base, target, length);
+    }
+}
+
+#endif /* ARM_NN_X86_SIMD */
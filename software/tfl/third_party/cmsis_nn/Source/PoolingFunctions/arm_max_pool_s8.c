@@ -30,6 +30,9 @@
 
 #include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
 #include "third_party/cmsis_nn/Include/arm_nnsupportfunctions.h"
+#if defined(ARM_NN_X86_SIMD)
+    #include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#endif
 
 static void compare_and_replace_if_larger_q7(int8_t *base, const int8_t *target, int32_t length)
 {
@@ -47,6 +50,13 @@ static void compare_and_replace_if_larger_q7(int8_t *base, const int8_t *target,
         length -= 16;
     }
 #else
+    #if defined(ARM_NN_X86_SIMD)
+    if (arm_nn_x86_level() != ARM_NN_X86_NONE)
+    {
+        arm_nn_x86_max_s8(base, target, length);
+        return;
+    }
+    #endif
     int8_t *dst = base;
     const int8_t *src = target;
     union arm_nnword ref_max;
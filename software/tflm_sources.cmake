@@ -0,0 +1,576 @@
+# TFLM sources shared by the firmware and the host tools. The target specific
+# parts (micro/system_setup.cpp, micro/micro_time.cpp) are added by each build.
+set(TFLM_SOURCES
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/delay.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/delay_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/energy.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/energy_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/fft_auto_scale_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/fft_auto_scale_kernel.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/fft_auto_scale_kernel.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/fft_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_log.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_log_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_spectral_subtraction.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_spectral_subtraction_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_square_root.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_square_root.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/filter_bank_square_root_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/framer.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/framer_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/irfft.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/irfft.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/overlap_add.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/overlap_add_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/pcan.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/pcan_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/rfft.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/rfft.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/stacker.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/stacker_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/window.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/micro/kernels/window_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/circular_buffer.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/circular_buffer.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/complex.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/energy.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/energy.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/fft_auto_scale.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/fft_auto_scale.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_log.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_log.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_spectral_subtraction.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_spectral_subtraction.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_square_root.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/filter_bank_square_root.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/irfft.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/irfft_float.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/irfft_int16.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/irfft_int32.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_common.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_float.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_float.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_int16.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_int16.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_int32.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/kiss_fft_wrappers/kiss_fft_int32.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/log.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/log.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/max_abs.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/max_abs.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/msb.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/msb_32.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/msb_64.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/overlap_add.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/overlap_add.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/pcan_argc_fixed.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/pcan_argc_fixed.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/rfft.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/rfft_float.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/rfft_int16.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/rfft_int32.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/square_root.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/square_root_32.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/square_root_64.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/window.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/signal/src/window.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/builtin_op_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/builtin_ops.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/c/builtin_op_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/c/c_api_types.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/c/common.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/context_util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/error_reporter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/error_reporter.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/flatbuffer_conversions.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/flatbuffer_conversions.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/tensor_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/api/tensor_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/c/builtin_op_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/c/c_api_types.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/c/common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/c/common.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/core/macros.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/common.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/compatibility.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/cppmath.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/max.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/min.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/optimized/neon_check.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/portable_tensor.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/portable_tensor_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/portable_tensor_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/quantization_util.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/quantization_util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/add.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/add_n.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/arg_min_max.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/batch_matmul.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/batch_to_space_nd.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/binary_function.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/broadcast_args.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/broadcast_to.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/ceil.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/comparisons.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/comparisons.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/concatenation.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/cumsum.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/depth_to_space.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/depthwiseconv_float.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/depthwiseconv_uint8.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/dequantize.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/div.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/elu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/exp.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/fill.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/floor.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/floor_div.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/floor_mod.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/fully_connected.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/hard_swish.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/add.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/depthwise_conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/fully_connected.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/l2normalization.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/logistic.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/mean.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/mul.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/pooling.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/tanh.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/integer_ops/transpose_conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/l2normalization.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/leaky_relu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/log_softmax.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/logistic.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/lstm_cell.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/maximum_minimum.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/mul.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/neg.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/pad.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/pooling.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/portable_tensor_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/portable_tensor_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/portable_tensor_utils_impl.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/prelu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/process_broadcast_shapes.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/quantize.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/reduce.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/requantize.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/resize_bilinear.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/resize_nearest_neighbor.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/round.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/select.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/slice.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/softmax.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/space_to_batch_nd.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/space_to_depth.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/strided_slice.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/sub.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/tanh.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/transpose.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/reference/transpose_conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/runtime_shape.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/runtime_shape.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/strided_slice_logic.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/tensor_ctypes.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/tensor_ctypes.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/tensor_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/internal/types.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/kernel_util.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/kernel_util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/op_macros.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/kernels/padding.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/ibuffer_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/non_persistent_arena_buffer_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/non_persistent_arena_buffer_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/persistent_arena_buffer_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/persistent_arena_buffer_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/recording_single_arena_buffer_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/recording_single_arena_buffer_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/single_arena_buffer_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/arena_allocator/single_arena_buffer_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/benchmarks/micro_benchmark.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/compatibility.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/debug_log.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/debug_log.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/fake_micro_context.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/fake_micro_context.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/flatbuffer_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/flatbuffer_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/activation_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/activations.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/activations.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/activations_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/add.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/add_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/add_n.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/arg_min_max.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/assign_variable.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/batch_matmul.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/batch_to_space_nd.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/broadcast_args.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/broadcast_to.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/call_once.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cast.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/ceil.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/circular_buffer.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/circular_buffer.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/circular_buffer_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/circular_buffer_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/add.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/conv.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/depthwise_conv.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/fully_connected.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/mul.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/pooling.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/softmax.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/svdf.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/transpose_conv.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cmsis_nn/unidirectional_sequence_lstm.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/comparisons.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/concatenation.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/conv_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/conv_test.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/cumsum.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/depth_to_space.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/depthwise_conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/depthwise_conv_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/dequantize.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/dequantize.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/dequantize_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/detection_postprocess.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/detection_postprocess_flexbuffers_generated_data.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/div.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/elementwise.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/elu.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/embedding_lookup.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/ethosu.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/ethosu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/exp.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/expand_dims.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/fill.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/floor.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/floor_div.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/floor_mod.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/fully_connected.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/fully_connected_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/gather.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/gather_nd.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/hard_swish.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/hard_swish.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/hard_swish_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/if.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/kernel_runner.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/kernel_runner.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/kernel_util.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/kernel_util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/l2_pool_2d.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/l2norm.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/leaky_relu.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/leaky_relu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/leaky_relu_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/log_softmax.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logical.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logical.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logical_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logistic.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logistic.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/logistic_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/lstm_eval.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/lstm_eval.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/lstm_eval_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/lstm_eval_test.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/lstm_shared.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/maximum_minimum.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/micro_ops.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/micro_tensor_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/micro_tensor_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/mirror_pad.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/mul.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/mul_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/neg.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/pack.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/pad.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/pad.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/pooling.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/pooling_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/prelu.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/prelu.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/prelu_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/quantize.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/quantize.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/quantize_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/read_variable.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reduce.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reduce.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reduce_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reshape.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reshape.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/reshape_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/resize_bilinear.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/resize_nearest_neighbor.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/round.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/select.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/shape.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/slice.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/softmax.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/softmax_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/space_to_batch_nd.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/space_to_depth.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/split.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/split_v.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/squared_difference.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/squeeze.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/strided_slice.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/strided_slice.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/strided_slice_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/sub.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/sub.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/sub_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/svdf.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/svdf_common.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/tanh.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/transpose.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/transpose_conv.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/unidirectional_sequence_lstm.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/unpack.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/var_handle.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/while.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/kernels/zeros_like.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_helpers.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_helpers.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/greedy_memory_planner.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/greedy_memory_planner.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/linear_memory_planner.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/linear_memory_planner.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/memory_plan_struct.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/micro_memory_planner.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/non_persistent_buffer_planner_shim.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/memory_planner/non_persistent_buffer_planner_shim.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_allocation_info.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_allocation_info.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_arena_constants.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_common.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_context.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_context.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_graph.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter_context.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter_context.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter_graph.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_interpreter_graph.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_log.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_log.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_mutable_op_resolver.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_op_cost.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_op_cost.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_op_resolver.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_op_resolver.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_profiler.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_profiler.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_profiler_interface.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_resource_variable.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_resource_variable.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_time.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_utils.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/micro_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/mock_micro_graph.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/mock_micro_graph.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/recording_micro_allocator.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/recording_micro_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/recording_micro_interpreter.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/system_setup.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/test_helper_custom_ops.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/test_helper_custom_ops.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/test_helpers.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/test_helpers.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/testing/micro_test.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/tflite_bridge/flatbuffer_conversions_bridge.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/tflite_bridge/flatbuffer_conversions_bridge.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/tflite_bridge/micro_error_reporter.cpp
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/micro/tflite_bridge/micro_error_reporter.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/portable_type_to_tflitetype.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/schema/schema_generated.h
+  # ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/schema/schema_utils.cpp
+  # ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/lite/schema/schema_utils.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cachel1_armv7.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_armcc.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_armclang.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_armclang_ltm.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_compiler.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_gcc.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_iccarm.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_tiarmclang.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/cmsis_version.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_armv81mml.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_armv8mbl.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_armv8mml.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm0.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm0plus.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm1.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm23.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm3.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm33.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm35p.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm4.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm55.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm7.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_cm85.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_sc000.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_sc300.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/core_starmc1.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/mpu_armv7.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/mpu_armv8.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/pac_armv81.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/pmu_armv8.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis/CMSIS/Core/Include/tz_context.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/Internal/arm_nn_compiler.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/arm_nn_math_types.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/arm_nn_tables.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/arm_nn_types.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1_x_n_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/arm_nnfunctions.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Include/arm_nnsupportfunctions.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ActivationFunctions/arm_nn_activation_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ActivationFunctions/arm_relu6_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ActivationFunctions/arm_relu_q15.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ActivationFunctions/arm_relu_q7.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_add_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_add_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_mul_acc_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_mul_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_mul_s16_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/BasicMathFunctions/arm_elementwise_mul_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConcatenationFunctions/arm_concatenation_s8_w.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConcatenationFunctions/arm_concatenation_s8_x.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConcatenationFunctions/arm_concatenation_s8_y.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConcatenationFunctions/arm_concatenation_s8_z.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1_x_n_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1x1_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1x1_s4_fast.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1x1_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_1x1_s8_fast.c
+  # ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_fast_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_get_buffer_sizes_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_get_buffer_sizes_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_wrapper_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_wrapper_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_convolve_wrapper_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_3x3_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_fast_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_get_buffer_sizes_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_get_buffer_sizes_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_s4_opt.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_s8_opt.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_wrapper_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_wrapper_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_depthwise_conv_wrapper_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_depthwise_conv_s8_core.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_row_offset_s8_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s4_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_mat_mult_kernel_s8_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_nn_mat_mult_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_transpose_conv_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ConvolutionFunctions/arm_transpose_conv_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_fully_connected_get_buffer_sizes_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_fully_connected_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_fully_connected_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_fully_connected_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_fully_connected_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/FullyConnectedFunctions/arm_vector_sum_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/LSTMFunctions/arm_lstm_unidirectional_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_depthwise_conv_nt_t_padded_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_depthwise_conv_nt_t_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_depthwise_conv_nt_t_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_lstm_calculate_gate_s8_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_lstm_step_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mul_core_1x_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mul_core_4x_s8.c
+  # ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mul_kernel_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_mat_mult_nt_t_s8_s32.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_vec_mat_mul_result_acc_s8_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_vec_mat_mult_t_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_vec_mat_mult_t_s4.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_vec_mat_mult_t_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nn_vec_mat_mult_t_svdf_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_nntables.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_q7_to_q15_with_offset.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/NNSupportFunctions/arm_s8_to_s16_unordered_with_offset.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_avgpool_get_buffer_sizes_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_avgpool_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_avgpool_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_avgpool_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_max_pool_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/PoolingFunctions/arm_max_pool_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/ReshapeFunctions/arm_reshape_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SVDFunctions/arm_svdf_get_buffer_sizes_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SVDFunctions/arm_svdf_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SVDFunctions/arm_svdf_state_s16_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SoftmaxFunctions/arm_nn_softmax_common_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SoftmaxFunctions/arm_softmax_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SoftmaxFunctions/arm_softmax_s8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SoftmaxFunctions/arm_softmax_s8_s16.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/cmsis_nn/Source/SoftmaxFunctions/arm_softmax_u8.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/array.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/base.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/buffer.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/buffer_ref.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/code_generator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/code_generators.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/default_allocator.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/detached_buffer.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/file_manager.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/flatbuffer_builder.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/flatbuffers.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/flex_flat_util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/flexbuffers.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/grpc.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/hash.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/idl.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/minireflect.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/reflection.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/reflection_generated.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/registry.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/stl_emulation.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/string.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/struct.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/table.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/util.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/vector.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/vector_downward.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/flatbuffers/include/flatbuffers/verifier.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/gemmlowp/fixedpoint/fixedpoint.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/gemmlowp/fixedpoint/fixedpoint_neon.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/gemmlowp/fixedpoint/fixedpoint_sse.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/gemmlowp/internal/detect_platform.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/kissfft/_kiss_fft_guts.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/kissfft/kiss_fft.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/kissfft/kiss_fft.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/kissfft/tools/kiss_fftr.c
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/kissfft/tools/kiss_fftr.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/third_party/ruy/ruy/profiler/instrumentation.h
+  ${CMAKE_CURRENT_LIST_DIR}/tfl/tensorflow/compiler/mlir/lite/schema/schema_utils.cpp
+)
@@ -0,0 +1,262 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: checks the cooperative inference of the firmware. Every board is
+// scored by Invoke() and again by begin() and refine() slices of 0, 5 and
+// 20 us, the logits must match. A model with an early-exit head has to stop
+// exactly once after it with the same provisional logits in every slicing,
+// the shipped model has one. A timer signal, standing in for the input
+// interrupt, then sets the cancellation token at a random time during a
+// whole-inference refine(); the time from setting the token to the return of
+// refine() is the time to abort, reported next to the slowest operator (the
+// worst case the token has to wait for). Exits with 1 on a mismatch or an
+// abort that was not reported.
+//
+//   aborttime [boards] [aborts]
+
+#include <signal.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+
+#define ABORT_ARENA_SIZE (32 * 1024)
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile bool cancel = false;
+static volatile sig_atomic_t fired = 0;
+static struct timespec fired_at;
+
+static void on_timer(int)
+{
+    clock_gettime(CLOCK_MONOTONIC, &fired_at);
+    cancel = true;
+    fired = 1;
+}
+
+static double us_between(Clock::time_point start, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::micro>(end - start).count();
+}
+
+static double us_between(const struct timespec &start, const struct timespec &end)
+{
+    return (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+}
+
+// refine() slices of budget_us until the final logits are in scores, the
+// logits of the early-exit head in provisional; false on a missing or
+// repeated provisional stop
+static bool stepped_scores(Inference &inference, const Board board, uint32_t budget_us, int8_t scores[NUM_SWITCHES],
+                           int8_t provisional[NUM_SWITCHES])
+{
+    if (inference.begin(board) == false)
+    {
+        return false;
+    }
+    uint8_t provisional_stops = 0;
+    InferenceState state;
+    while ((state = inference.refine(scores, budget_us)) != INFERENCE_DONE)
+    {
+        if (state == INFERENCE_PROVISIONAL)
+        {
+            memcpy(provisional, scores, NUM_SWITCHES);
+            provisional_stops++;
+        }
+        else if (state != INFERENCE_RUNNING)
+        {
+            return false;
+        }
+    }
+    return provisional_stops == (inference.has_provisional_head() ? 1 : 0);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t num_boards = argc > 1 ? atoi(argv[1]) : 1000;
+    uint32_t num_aborts = argc > 2 ? atoi(argv[2]) : 20000;
+
+    alignas(16) static uint8_t arena[ABORT_ARENA_SIZE];
+    Inference inference = Inference(COLORDOT_MODEL, arena, sizeof(arena));
+    inference.set_cancellation_token(&cancel);
+    if (inference.init() == false)
+    {
+        return 1;
+    }
+
+    std::vector<Board> boards(num_boards);
+    Game game = Game();
+    srand(1);
+    for (uint32_t b = 0; b < num_boards; b++)
+    {
+        game.init();
+        for (uint8_t i = 0; i < 1 + b % 20; i++)
+        {
+            game.toggle_switch(rand() % NUM_SWITCHES);
+        }
+        memcpy(boards[b], game.maze, sizeof(Board));
+    }
+
+    // stepped runs give the logits of Invoke(); the mean time of every
+    // operator, the slowest bounds the abort
+    printf("model: %s early-exit head\n", inference.has_provisional_head() ? "with" : "without");
+    const uint32_t budgets[] = {0, 5, 20};
+    uint32_t mismatches = 0;
+    double invoke_us = 0.0;
+    std::vector<double> op_us;
+    for (uint32_t b = 0; b < num_boards; b++)
+    {
+        int8_t expected[NUM_SWITCHES];
+        int8_t scores[NUM_SWITCHES];
+        int8_t first_provisional[NUM_SWITCHES] = {};
+        int8_t provisional[NUM_SWITCHES] = {};
+        Clock::time_point start = Clock::now();
+        if (inference.score_board(boards[b], expected) == false)
+        {
+            return 1;
+        }
+        invoke_us += us_between(start, Clock::now());
+        for (uint32_t budget : budgets)
+        {
+            if ((stepped_scores(inference, boards[b], budget, scores, provisional) == false) ||
+                (memcmp(scores, expected, sizeof(scores)) != 0))
+            {
+                mismatches++;
+            }
+            if (budget == budgets[0])
+            {
+                memcpy(first_provisional, provisional, sizeof(provisional));
+            }
+            else if (memcmp(provisional, first_provisional, sizeof(provisional)) != 0)
+            {
+                mismatches++;
+            }
+        }
+        // begin() runs the first operator, every refine() the next one
+        start = Clock::now();
+        inference.begin(boards[b]);
+        bool done = false;
+        for (size_t op = 0; done == false; op++)
+        {
+            if (op > 0)
+            {
+                done = inference.refine(scores) == INFERENCE_DONE;
+            }
+            Clock::time_point end = Clock::now();
+            if (op == op_us.size())
+            {
+                op_us.push_back(0.0);
+            }
+            op_us[op] += us_between(start, end);
+            start = end;
+        }
+    }
+    size_t slowest_op = std::max_element(op_us.begin(), op_us.end()) - op_us.begin();
+    printf("stepped: %u boards x %zu slice budgets, %u mismatches\n", num_boards,
+           sizeof(budgets) / sizeof(budgets[0]), mismatches);
+    printf("invoke: %.2f us mean, slowest operator #%zu %.2f us mean\n", invoke_us / num_boards, slowest_op,
+           op_us[slowest_op] / num_boards);
+
+    // the token is set at a random point of a whole-inference refine(), which
+    // has to return early with the run dropped
+    struct sigaction action = {};
+    action.sa_handler = on_timer;
+    sigaction(SIGALRM, &action, nullptr);
+    timer_t timer;
+    struct sigevent event = {};
+    event.sigev_notify = SIGEV_SIGNAL;
+    event.sigev_signo = SIGALRM;
+    timer_create(CLOCK_MONOTONIC, &event, &timer);
+    double delay_span_ns = 1000.0 * invoke_us / num_boards;
+
+    std::vector<double> latencies;
+    uint32_t completed = 0;
+    uint32_t unreported = 0;
+    for (uint32_t r = 0; r < num_aborts; r++)
+    {
+        int8_t scores[NUM_SWITCHES];
+        inference.begin(boards[r % num_boards]);
+        fired = 0;
+        struct itimerspec delay = {};
+        delay.it_value.tv_nsec = 1 + rand() % (long)delay_span_ns;
+        timer_settime(timer, 0, &delay, nullptr);
+        InferenceState state;
+        do
+        {
+            state = inference.refine(scores, UINT32_MAX);
+        } while (state == INFERENCE_PROVISIONAL);
+        struct timespec end;
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        while (fired == 0)
+        {
+        }
+        if (state == INFERENCE_DONE)
+        {
+            // finished before the token was set
+            completed++;
+        }
+        else if ((state != INFERENCE_CANCELLED) || (inference.cancelled() == false))
+        {
+            unreported++;
+        }
+        else
+        {
+            latencies.push_back(us_between(fired_at, end));
+        }
+    }
+    timer_delete(timer);
+    cancel = false;
+
+    // the dropped runs leave nothing behind
+    for (uint32_t b = 0; b < num_boards; b++)
+    {
+        int8_t expected[NUM_SWITCHES];
+        int8_t scores[NUM_SWITCHES];
+        int8_t provisional[NUM_SWITCHES];
+        inference.score_board(boards[b], expected);
+        if ((stepped_scores(inference, boards[b], 0, scores, provisional) == false) ||
+            (memcmp(scores, expected, sizeof(scores)) != 0))
+        {
+            mismatches++;
+        }
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    if (latencies.empty() == false)
+    {
+        size_t n = latencies.size();
+        printf("abort: %zu cancelled, %u completed first, time to abort median %.2f us, p99 %.2f us, max %.2f us\n", n,
+               completed, latencies[n / 2], latencies[n * 99 / 100], latencies[n - 1]);
+    }
+    if ((mismatches > 0) || (unreported > 0))
+    {
+        fprintf(stderr, "%u mismatches, %u aborts not reported\n", mismatches, unreported);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: plays the firmware's effects on a virtual clock and checks the
+// composited frames, the reported frame changes and the layer order. The
+// clock starts just before the 32-bit millisecond wrap-around. Exits with 1
+// on the first mismatch.
+//
+//   animcheck
+
+#include <cstdio>
+
+#include "animation.h"
+#include "game.h"
+
+static const uint32_t clock_start = 0xFFFFFF00u;
+static int failures = 0;
+
+// number of lit cells of the composited frame
+static int lit_cells(Animator &animator, const Board base)
+{
+    Board frame;
+    animator.compose(base, frame);
+    int lit = 0;
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        lit += frame[i / 6][i % 6] != 0 ? 1 : 0;
+    }
+    return lit;
+}
+
+static void expect(const char *what, uint32_t t, int actual, int expected)
+{
+    if (actual != expected)
+    {
+        fprintf(stderr, "%s at %u ms: %d, expected %d\n", what, t, actual, expected);
+        failures++;
+    }
+}
+
+int main()
+{
+    Game game = Game();
+    Animator animator = Animator();
+    int board_lit = lit_cells(animator, game.maze);
+
+    // finish sweep: dark, inner 2x2, middle 4x4, full board, then again
+    struct
+    {
+        uint32_t t;
+        bool changed;
+        int lit;
+    } sweep[] = {
+        {0, false, 0}, {149, false, 0}, {150, true, 4}, {299, false, 4}, {300, true, 16},
+        {450, true, board_lit}, {849, false, board_lit}, {850, true, 0}, {1000, true, 4},
+    };
+    animator.start(LAYER_FINISH, finish_sweep, finish_sweep_len, true, clock_start);
+    for (const auto &step : sweep)
+    {
+        expect("sweep change", step.t, animator.tick(clock_start + step.t), step.changed);
+        expect("sweep lit cells", step.t, lit_cells(animator, game.maze), step.lit);
+    }
+
+    // a tick late by several keyframes catches up without drifting
+    animator.start(LAYER_FINISH, finish_sweep, finish_sweep_len, true, clock_start);
+    expect("catch-up change", 2 * 850 + 300, animator.tick(clock_start + 2 * 850 + 300), true);
+    expect("catch-up lit cells", 2 * 850 + 300, lit_cells(animator, game.maze), 16);
+
+    // the hint is composited over the sweep and ends on its own
+    Keyframe hint[] = {{250, ROW_MASK(1), palette_off}};
+    animator.start(LAYER_FINISH, finish_sweep, finish_sweep_len, true, clock_start);
+    animator.tick(clock_start + 450);
+    animator.start(LAYER_HINT, hint, 1, false, clock_start + 450);
+    expect("hint lit cells", 450, lit_cells(animator, game.maze), board_lit - 5);
+    expect("hint change", 699, animator.tick(clock_start + 699), false);
+    expect("hint active", 699, animator.active(LAYER_HINT), true);
+    expect("hint end change", 700, animator.tick(clock_start + 700), true);
+    expect("hint active", 700, animator.active(LAYER_HINT), false);
+    expect("after hint lit cells", 700, lit_cells(animator, game.maze), board_lit);
+
+    // brightness preview turns every dot white, empty cells stay dark
+    animator.stop(LAYER_FINISH);
+    animator.start(LAYER_BRIGHTNESS, brightness_preview, brightness_preview_len, false, clock_start);
+    Board frame;
+    animator.compose(game.maze, frame);
+    int white = 0;
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        white += frame[i / 6][i % 6] == 1 ? 1 : 0;
+    }
+    expect("preview white cells", 0, white, board_lit);
+
+    if (failures > 0)
+    {
+        return 1;
+    }
+    printf("animations ok\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: allocates and runs the colordot model with a
+// RecordingMicroInterpreter and writes the tensor arena requirement as a
+// header for the firmware. With an expected size (the device constant) it
+// fails if the requirement differs, so a model change cannot silently
+// overflow or waste the arena. Also reports what the in-place operators
+// save against a plan that gives every output a buffer of its own.
+//
+//   arenasize <output.h> [expected bytes]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/micro_arena_constants.h"
+#include "tensorflow/lite/micro/recording_micro_interpreter.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+#include "game.h"
+#include "host_worker_pool.h"
+#include "inference.h"
+#include "model_data.h"
+
+// large enough for any model that fits the RP2040
+#define ARENASIZE_RECORDING_ARENA (256 * 1024)
+
+alignas(16) static uint8_t recording_arena[ARENASIZE_RECORDING_ARENA];
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 && argc != 3)
+    {
+        fprintf(stderr, "usage: %s <output.h> [expected bytes]\n", argv[0]);
+        return 1;
+    }
+
+    const tflite::Model *model = tflite::GetModel(COLORDOT_MODEL);
+    static OpResolver resolver;
+    if (register_ops(resolver) == false)
+    {
+        return 1;
+    }
+
+    // the kernels plan a scratch buffer per core of the device; every operator
+    // that can be split is, so the check below runs in each of them. The
+    // firmware runs incrementally, the convolution caches count as well
+    HostWorkerPool pool(INFERENCE_WORKERS, 1);
+
+    // the plan without in-place operators, only for the report
+    size_t separate_non_persistent = 0;
+    {
+        tflite::RecordingMicroInterpreter separate(model, resolver, recording_arena, sizeof(recording_arena));
+        separate.SetWorkerPool(&pool);
+        separate.SetIncrementalInvoke(true);
+        separate.SetInPlaceOps(false);
+        if (separate.AllocateTensors() != kTfLiteOk)
+        {
+            fprintf(stderr, "AllocateTensors() without in-place operators failed\n");
+            return 1;
+        }
+        separate_non_persistent = separate.GetMicroAllocator().GetSimpleMemoryAllocator()->GetNonPersistentUsedBytes();
+    }
+
+    tflite::RecordingMicroInterpreter interpreter(model, resolver, recording_arena, sizeof(recording_arena));
+    interpreter.SetWorkerPool(&pool);
+    interpreter.SetIncrementalInvoke(true);
+    if (interpreter.AllocateTensors() != kTfLiteOk)
+    {
+        fprintf(stderr, "AllocateTensors() failed\n");
+        return 1;
+    }
+    // kernels may still take temp memory on their first Eval, run it on the solved board
+    Game game;
+    TfLiteTensor *input = interpreter.input(0);
+    for (size_t i = 0; i < input->bytes / sizeof(int32_t); i++)
+    {
+        input->data.i32[i] = game.maze[(i % 36) / 6][i % 6];
+    }
+    if (interpreter.Invoke() != kTfLiteOk)
+    {
+        fprintf(stderr, "Invoke() failed\n");
+        return 1;
+    }
+
+    const tflite::RecordingMicroAllocator &allocator = interpreter.GetMicroAllocator();
+    allocator.PrintAllocations();
+
+    // the recording allocator and planner sit in the tail like the plain ones, only larger
+    size_t persistent = allocator.GetSimpleMemoryAllocator()->GetPersistentUsedBytes() -
+                        tflite::RecordingMicroAllocator::GetDefaultTailUsage() +
+                        tflite::MicroAllocator::GetDefaultTailUsage(false);
+    size_t non_persistent = allocator.GetSimpleMemoryAllocator()->GetNonPersistentUsedBytes();
+    size_t scratch = allocator.GetRecordedAllocation(tflite::RecordedAllocationType::kScratchBufferData).used_bytes;
+    // an unaligned arena loses up to alignment - 1 bytes at the head and at the tail
+    size_t slack = 2 * (tflite::MicroArenaBufferAlignment() - 1);
+    size_t total = persistent + non_persistent + slack;
+
+    // the firmware's plain interpreter must run in exactly that much, also from an unaligned start
+    static uint8_t check_arena[ARENASIZE_RECORDING_ARENA + 1];
+    Inference check(COLORDOT_MODEL, check_arena + 1, total);
+    check.set_worker_pool(&pool);
+    check.set_incremental(true);
+    int8_t scores[NUM_SWITCHES];
+    if ((check.init() == false) || (check.score_board(game.maze, scores) == false))
+    {
+        fprintf(stderr, "error: the model does not run in %zu bytes\n", total);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (out == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    fprintf(out, "// Generated by tools/arenasize, do not edit.\n\n");
+    fprintf(out, "#ifndef ARENA_SIZE_H\n#define ARENA_SIZE_H\n\n");
+    fprintf(out, "#define TENSOR_ARENA_PERSISTENT_BYTES %zu\n", persistent);
+    fprintf(out, "#define TENSOR_ARENA_NON_PERSISTENT_BYTES %zu\n", non_persistent);
+    fprintf(out, "// part of the non-persistent bytes, planned together with the activations\n");
+    fprintf(out, "#define TENSOR_ARENA_SCRATCH_BYTES %zu\n", scratch);
+    fprintf(out, "#define TENSOR_ARENA_ALIGNMENT_SLACK %zu\n", slack);
+    fprintf(out, "#define TENSOR_ARENA_SIZE %zu\n\n", total);
+    fprintf(out, "#endif // ARENA_SIZE_H\n");
+    fclose(out);
+
+    printf("tensor arena: %zu bytes (persistent %zu, non-persistent %zu incl. scratch %zu, slack %zu)\n", total,
+           persistent, non_persistent, scratch, slack);
+    printf("in-place operators: non-persistent %zu bytes, %zu with a buffer per output (%zd saved)\n", non_persistent,
+           separate_non_persistent, (ssize_t)separate_non_persistent - (ssize_t)non_persistent);
+
+    if (argc == 3)
+    {
+        size_t expected = strtoul(argv[2], nullptr, 0);
+        if (expected != total)
+        {
+            fprintf(stderr, "error: tensor arena is %zu bytes, the model needs %zu\n", expected, total);
+            remove(argv[1]);
+            return 1;
+        }
+    }
+    return 0;
+}
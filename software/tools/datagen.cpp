@@ -0,0 +1,538 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: generates (board, optimal move, distance) training samples from
+// shuffle_dots games of every difficulty level on all cores and writes them
+// as a memory mappable dataset (see dataset.h).
+//
+// Labels: a breadth-first search from the solved board to table_depth is
+// shared by all threads. A forward search of forward_depth moves from the
+// sample that meets it gives the exact distance of boards up to
+// table_depth + forward_depth moves away. Farther boards are labelled by a
+// beam search on the number of misplaced dots, an upper bound of the
+// distance. Boards are deduplicated up to symmetry, within a chunk by the
+// thread that generates it and across chunks in chunk order when they are
+// written, so the output does not depend on the thread count or timing.
+//
+//   datagen <output> [samples per level] [threads] [table depth] [forward depth]
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "board.h"
+#include "dataset.h"
+#include "game.h"
+#include "symmetry.h"
+
+#define NUM_LEVELS 8
+#define CHUNK_SAMPLES 4096
+#define SHUFFLES_PER_SAMPLE 4 // attempts per chunk slot before a level counts as exhausted
+#define BEAM_WIDTH 16
+#define BEAM_STEPS 32
+#define VERIFY_SAMPLES 2000
+
+struct PackedBoardHash
+{
+    size_t operator()(const PackedBoard &packed) const
+    {
+        return hash_board(packed, 0x5EED);
+    }
+};
+
+// distance (bits 3..7) and optimal move (bits 0..2) of every board near the solution
+typedef std::unordered_map<PackedBoard, uint8_t, PackedBoardHash> DistanceTable;
+
+struct Label
+{
+    uint8_t move;
+    uint8_t depth;
+    bool exact;
+};
+
+static PackedBoard apply_move(Game &game, const PackedBoard &packed, uint8_t sw)
+{
+    Board maze;
+    unpack_board(packed, maze);
+    game.load(maze);
+    game.toggle_switch(sw);
+    return pack_board(game.maze);
+}
+
+static DistanceTable build_table(uint8_t depth)
+{
+    // every move is its own inverse, so the move leading back to the parent is optimal
+    DistanceTable table;
+    Game game = Game();
+    std::vector<PackedBoard> frontier = {pack_board(game.maze)};
+    std::vector<PackedBoard> next;
+    table[frontier[0]] = 0;
+    for (uint8_t d = 1; d <= depth; d++)
+    {
+        next.clear();
+        for (const PackedBoard &parent : frontier)
+        {
+            for (uint8_t sw = 0; sw < 8; sw++)
+            {
+                PackedBoard child = apply_move(game, parent, sw);
+                if (table.emplace(child, (d << 3) | sw).second)
+                {
+                    next.push_back(child);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return table;
+}
+
+class Labeler
+{
+public:
+    Labeler(const DistanceTable &table, uint8_t table_depth, uint8_t forward_depth)
+        : table(table), table_depth(table_depth), forward_depth(forward_depth)
+    {
+        this->solved = pack_board(this->game.maze);
+    }
+
+    Label label(const PackedBoard &board)
+    {
+        Label label;
+        if ((this->exact(board, label) == false) && (this->beam(board, label) == false))
+        {
+            label = {0, 0xFF, false};
+        }
+        return label;
+    }
+
+private:
+    struct Node
+    {
+        PackedBoard board;
+        uint8_t first_move;
+        uint8_t misplaced;
+    };
+
+    const DistanceTable &table;
+    uint8_t table_depth;
+    uint8_t forward_depth;
+    Game game;
+    PackedBoard solved;
+    std::vector<Node> frontier;
+    std::vector<Node> next;
+    std::unordered_set<PackedBoard, PackedBoardHash> seen;
+
+    // lowest steps + table distance over the frontier, false if no board is in the table
+    bool meet(uint8_t steps, uint8_t &best_depth, uint8_t &best_move)
+    {
+        bool found = false;
+        for (const Node &node : this->frontier)
+        {
+            auto hit = this->table.find(node.board);
+            if (hit == this->table.end())
+            {
+                continue;
+            }
+            uint8_t depth = steps + (hit->second >> 3);
+            if ((found == false) || (depth < best_depth))
+            {
+                best_depth = depth;
+                best_move = steps == 0 ? (hit->second & 0x7) : node.first_move;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    void expand(uint8_t steps)
+    {
+        this->next.clear();
+        for (const Node &node : this->frontier)
+        {
+            for (uint8_t sw = 0; sw < 8; sw++)
+            {
+                PackedBoard child = apply_move(this->game, node.board, sw);
+                if (this->seen.insert(child).second)
+                {
+                    this->next.push_back({child, steps == 1 ? sw : node.first_move, 0});
+                }
+            }
+        }
+        this->frontier.swap(this->next);
+    }
+
+    // A shortest path of length L <= table_depth + forward_depth passes a
+    // board at forward depth max(0, L - table_depth) that is in the table, so
+    // the first hit is exact once the forward depth reaches it.
+    bool exact(const PackedBoard &board, Label &label)
+    {
+        this->frontier = {{board, 0, 0}};
+        this->seen.clear();
+        this->seen.insert(board);
+        bool found = false;
+        uint8_t best_depth = 0;
+        uint8_t best_move = 0;
+        for (uint8_t steps = 0; steps <= this->forward_depth; steps++)
+        {
+            if ((found == true) && (steps >= best_depth))
+            {
+                break;
+            }
+            if (steps > 0)
+            {
+                this->expand(steps);
+            }
+            uint8_t depth;
+            uint8_t move;
+            if ((this->meet(steps, depth, move) == true) && ((found == false) || (depth < best_depth)))
+            {
+                best_depth = depth;
+                best_move = move;
+                found = true;
+            }
+        }
+        label = {best_move, best_depth, true};
+        return found;
+    }
+
+    uint8_t misplaced(const PackedBoard &board)
+    {
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < 18; i++)
+        {
+            count += ((board.lo ^ this->solved.lo) >> (3 * i) & 0x7) != 0;
+            count += ((board.hi ^ this->solved.hi) >> (3 * i) & 0x7) != 0;
+        }
+        return count;
+    }
+
+    // keeps the BEAM_WIDTH boards with the fewest misplaced dots per step
+    bool beam(const PackedBoard &board, Label &label)
+    {
+        this->frontier = {{board, 0, 0}};
+        this->seen.clear();
+        this->seen.insert(board);
+        for (uint8_t steps = 1; steps <= BEAM_STEPS; steps++)
+        {
+            this->expand(steps);
+            uint8_t depth;
+            uint8_t move;
+            if (this->meet(steps, depth, move) == true)
+            {
+                label = {move, depth, false};
+                return true;
+            }
+            for (Node &node : this->frontier)
+            {
+                node.misplaced = this->misplaced(node.board);
+            }
+            if (this->frontier.size() > BEAM_WIDTH)
+            {
+                std::nth_element(this->frontier.begin(), this->frontier.begin() + BEAM_WIDTH, this->frontier.end(),
+                                 [](const Node &a, const Node &b)
+                                 { return a.misplaced < b.misplaced; });
+                this->frontier.resize(BEAM_WIDTH);
+            }
+        }
+        return false;
+    }
+};
+
+struct Counters
+{
+    std::atomic<uint64_t> exact{0};
+    std::atomic<uint64_t> bounded{0};
+    std::atomic<uint64_t> duplicates{0};
+    std::atomic<uint64_t> unlabelled{0};
+};
+
+struct Chunk
+{
+    uint8_t level;
+    std::vector<PackedBoard> boards;
+    std::vector<uint8_t> moves;
+    std::vector<uint8_t> depths;
+    std::vector<uint8_t> flags;
+};
+
+// Appends chunks to the file in item order and collects the index. A chunk
+// finished ahead of its turn waits in memory; boards already written by an
+// earlier chunk are dropped.
+class DatasetWriter
+{
+public:
+    DatasetWriter(FILE *file, Counters &counters) : file(file), counters(counters)
+    {
+        DatasetHeader header = {};
+        fwrite(&header, sizeof(header), 1, file);
+        this->offset = sizeof(header);
+    }
+
+    void submit(uint32_t item, Chunk &&chunk)
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->pending.emplace(item, std::move(chunk));
+        for (auto next = this->pending.begin(); (next != this->pending.end()) && (next->first == this->next_item);
+             next = this->pending.begin())
+        {
+            this->write(next->second);
+            this->pending.erase(next);
+            this->next_item++;
+        }
+    }
+
+    void finish(uint8_t table_depth, uint8_t forward_depth)
+    {
+        DatasetHeader header = {};
+        header.magic = DATASET_MAGIC;
+        header.version = DATASET_VERSION;
+        header.samples = this->samples;
+        header.index_offset = this->offset;
+        header.chunks = this->index.size();
+        header.chunk_capacity = CHUNK_SAMPLES;
+        header.table_depth = table_depth;
+        header.forward_depth = forward_depth;
+        fwrite(this->index.data(), sizeof(DatasetChunk), this->index.size(), this->file);
+        fseek(this->file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, this->file);
+    }
+
+    uint64_t samples = 0;
+
+private:
+    FILE *file;
+    Counters &counters;
+    std::mutex mutex;
+    uint64_t offset;
+    std::vector<DatasetChunk> index;
+    std::map<uint32_t, Chunk> pending;
+    uint32_t next_item = 0;
+    std::unordered_set<PackedBoard, PackedBoardHash> seen;
+
+    void write(const Chunk &chunk)
+    {
+        Chunk kept;
+        kept.level = chunk.level;
+        for (size_t i = 0; i < chunk.boards.size(); i++)
+        {
+            if (this->seen.insert(chunk.boards[i]).second == false)
+            {
+                this->counters.duplicates++;
+                continue;
+            }
+            ((chunk.flags[i] & DATASET_EXACT) ? this->counters.exact : this->counters.bounded)++;
+            kept.boards.push_back(chunk.boards[i]);
+            kept.moves.push_back(chunk.moves[i]);
+            kept.depths.push_back(chunk.depths[i]);
+            kept.flags.push_back(chunk.flags[i]);
+        }
+
+        uint32_t count = kept.boards.size();
+        if (count == 0)
+        {
+            return;
+        }
+        std::vector<uint8_t> bytes(dataset_chunk_bytes(count), 0);
+        memcpy(bytes.data(), kept.boards.data(), count * sizeof(PackedBoard));
+        memcpy(bytes.data() + dataset_moves_offset(count), kept.moves.data(), count);
+        memcpy(bytes.data() + dataset_depths_offset(count), kept.depths.data(), count);
+        memcpy(bytes.data() + dataset_flags_offset(count), kept.flags.data(), count);
+
+        fwrite(bytes.data(), 1, bytes.size(), this->file);
+        DatasetChunk entry = {this->offset, count, kept.level, {0, 0, 0}};
+        this->index.push_back(entry);
+        this->offset += bytes.size();
+        this->samples += count;
+    }
+};
+
+// seed of the shuffle of attempt i, independent of the thread that runs it
+static uint32_t shuffle_seed(uint8_t level, uint64_t i)
+{
+    PackedBoard key = {i, level};
+    return (uint32_t)hash_board(key, 0xDA7A);
+}
+
+static std::mutex shuffle_mutex;
+
+static void generate(uint32_t item, uint8_t level, uint32_t chunk_index, uint32_t samples, Labeler &labeler,
+                     Counters &counters, DatasetWriter &writer)
+{
+    Game game = Game();
+    std::unordered_set<PackedBoard, PackedBoardHash> seen;
+    Chunk chunk;
+    chunk.level = level;
+    uint64_t first = (uint64_t)chunk_index * CHUNK_SAMPLES * SHUFFLES_PER_SAMPLE;
+    for (uint64_t i = first; (i < first + samples * SHUFFLES_PER_SAMPLE) && (chunk.boards.size() < samples); i++)
+    {
+        uint32_t seed = shuffle_seed(level, i);
+        uint8_t switch_state[8];
+        for (uint8_t sw = 0; sw < 8; sw++)
+        {
+            switch_state[sw] = (seed >> (24 + sw)) & 1;
+        }
+        {
+            // shuffle_dots() draws from the process-wide rand(), one thread at a time
+            std::lock_guard<std::mutex> lock(shuffle_mutex);
+            game.shuffle_dots(level, seed, switch_state);
+        }
+        CanonicalBoard canonical = canonicalize(game.maze);
+        if (seen.insert(canonical.packed).second == false)
+        {
+            counters.duplicates++;
+            continue;
+        }
+        Label label = labeler.label(canonical.packed);
+        if (label.depth == 0xFF)
+        {
+            counters.unlabelled++;
+            continue;
+        }
+        chunk.boards.push_back(canonical.packed);
+        chunk.moves.push_back(label.move);
+        chunk.depths.push_back(label.depth);
+        chunk.flags.push_back(label.exact ? DATASET_EXACT : 0);
+    }
+    writer.submit(item, std::move(chunk));
+}
+
+// maps the file and checks the index and the exact labels of some samples
+static bool verify(const char *path, Labeler &labeler)
+{
+    FILE *file = fopen(path, "rb");
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    const uint8_t *data = (const uint8_t *)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    fclose(file);
+    if (data == MAP_FAILED)
+    {
+        perror("mmap");
+        return false;
+    }
+    const DatasetHeader *header = (const DatasetHeader *)data;
+    const DatasetChunk *index = (const DatasetChunk *)(data + header->index_offset);
+    bool ok = (header->magic == DATASET_MAGIC) && (header->version == DATASET_VERSION);
+    uint64_t samples = 0;
+    uint32_t checked = 0;
+    Game game = Game();
+    for (uint32_t c = 0; ok && (c < header->chunks); c++)
+    {
+        const DatasetChunk &chunk = index[c];
+        const PackedBoard *boards = (const PackedBoard *)(data + chunk.offset);
+        const uint8_t *moves = data + chunk.offset + dataset_moves_offset(chunk.count);
+        const uint8_t *depths = data + chunk.offset + dataset_depths_offset(chunk.count);
+        const uint8_t *flags = data + chunk.offset + dataset_flags_offset(chunk.count);
+        samples += chunk.count;
+        for (uint32_t i = 0; (i < chunk.count) && (checked < VERIFY_SAMPLES); i += 97)
+        {
+            if ((flags[i] & DATASET_EXACT) == 0)
+            {
+                continue;
+            }
+            // the optimal move brings the board one move closer
+            Label after = labeler.label(apply_move(game, boards[i], moves[i]));
+            if ((after.exact == false) || (after.depth + 1 != depths[i]))
+            {
+                fprintf(stderr, "chunk %u sample %u: depth %u, after move %u: %u\n", c, i, depths[i], moves[i],
+                        after.depth);
+                ok = false;
+            }
+            checked++;
+        }
+    }
+    ok = ok && (samples == header->samples);
+    munmap((void *)data, size);
+    printf("verified %u exact labels, %s\n", checked, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <output> [samples per level] [threads] [table depth] [forward depth]\n", argv[0]);
+        return 1;
+    }
+    uint32_t per_level = argc > 2 ? atoi(argv[2]) : 4096;
+    uint32_t threads = argc > 3 ? atoi(argv[3]) : std::thread::hardware_concurrency();
+    uint8_t table_depth = argc > 4 ? atoi(argv[4]) : 9;
+    uint8_t forward_depth = argc > 5 ? atoi(argv[5]) : 4;
+    threads = threads > 0 ? threads : 1;
+
+    auto start = std::chrono::steady_clock::now();
+    DistanceTable table = build_table(table_depth);
+    double table_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("table: %zu boards up to %u moves in %.2f s\n", table.size(), table_depth, table_s);
+
+    FILE *file = fopen(argv[1], "wb");
+    if (file == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    Counters counters;
+    DatasetWriter writer(file, counters);
+
+    // work items are (level, chunk) pairs, taken in order by the threads
+    uint32_t chunks_per_level = (per_level + CHUNK_SAMPLES - 1) / CHUNK_SAMPLES;
+    std::atomic<uint32_t> next_item{0};
+    start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&]()
+                             {
+            Labeler labeler(table, table_depth, forward_depth);
+            uint32_t item;
+            while ((item = next_item++) < NUM_LEVELS * chunks_per_level)
+            {
+                uint32_t chunk_index = item % chunks_per_level;
+                uint32_t samples = std::min<uint32_t>(CHUNK_SAMPLES, per_level - chunk_index * CHUNK_SAMPLES);
+                generate(item, item / chunks_per_level, chunk_index, samples, labeler, counters, writer);
+            } });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    writer.finish(table_depth, forward_depth);
+    fclose(file);
+
+    printf("%lu samples (%lu exact, %lu upper bounds), %lu duplicates, %lu unlabelled\n",
+           (unsigned long)writer.samples, (unsigned long)counters.exact.load(), (unsigned long)counters.bounded.load(),
+           (unsigned long)counters.duplicates.load(), (unsigned long)counters.unlabelled.load());
+    printf("%.2f s on %u threads: %.0f samples/s, %.0f samples/s per thread\n", seconds, threads,
+           writer.samples / seconds, writer.samples / seconds / threads);
+
+    Labeler labeler(table, table_depth, forward_depth);
+    return verify(argv[1], labeler) ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef DATASET_H
+#define DATASET_H
+
+#include <cstdint>
+
+#include "board.h"
+
+// Training set written by tools/datagen, laid out to be memory mapped:
+//
+//   DatasetHeader
+//   chunks, each DATASET_ALIGN aligned and column by column:
+//     PackedBoard boards[count]   canonical board (see symmetry.h)
+//     uint8_t moves[count]        optimal switch in the canonical frame
+//     uint8_t depths[count]       moves to the solution
+//     uint8_t flags[count]        DATASET_EXACT if depth is the optimum
+//   DatasetChunk index[chunks] at index_offset
+//
+// All samples of a chunk come from one shuffle_dots level.
+
+#define DATASET_MAGIC 0x5344444Eu // "NDDS"
+#define DATASET_VERSION 1
+#define DATASET_ALIGN 64
+#define DATASET_EXACT 0x01
+
+struct DatasetHeader
+{
+  uint32_t magic;
+  uint32_t version;
+  uint64_t samples;
+  uint64_t index_offset;
+  uint32_t chunks;
+  uint32_t chunk_capacity;
+  uint8_t table_depth;   // backward search depth of the labels
+  uint8_t forward_depth; // forward search depth of the labels
+  uint8_t reserved[30];
+};
+static_assert(sizeof(DatasetHeader) == DATASET_ALIGN, "the header fills one alignment block");
+
+struct DatasetChunk
+{
+  uint64_t offset;
+  uint32_t count;
+  uint8_t level;
+  uint8_t reserved[3];
+};
+
+// column offsets of a chunk of count samples, relative to its offset
+inline uint64_t dataset_moves_offset(uint32_t count)
+{
+  return (uint64_t)count * sizeof(PackedBoard);
+}
+
+inline uint64_t dataset_depths_offset(uint32_t count)
+{
+  return dataset_moves_offset(count) + count;
+}
+
+inline uint64_t dataset_flags_offset(uint32_t count)
+{
+  return dataset_depths_offset(count) + count;
+}
+
+inline uint64_t dataset_chunk_bytes(uint32_t count)
+{
+  uint64_t bytes = dataset_flags_offset(count) + count;
+  return (bytes + DATASET_ALIGN - 1) / DATASET_ALIGN * DATASET_ALIGN;
+}
+
+#endif // DATASET_H
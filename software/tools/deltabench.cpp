@@ -0,0 +1,148 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: plays random games and scores the board after every move twice,
+// with a plain and with an incremental interpreter, like the hints of the
+// firmware. Checks that the logits are bit-exact and reports the hints per
+// second of both, then does the same for unrelated boards in a row, where
+// the incremental run has nothing to reuse and falls back to the full
+// convolution. Both interpreters take turns on blocks of boards and every
+// block counts with its fastest of a few rounds, so the host's load hits
+// both alike.
+//
+//   deltabench [moves]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+
+#define DELTABENCH_ARENA_SIZE (32 * 1024)
+// moves of a random game before it starts over from the solved board
+#define DELTABENCH_GAME_MOVES 30
+// boards scored by one interpreter before the other takes its turn
+#define DELTABENCH_BLOCK 500
+#define DELTABENCH_ROUNDS 5
+
+typedef int8_t Scores[NUM_SWITCHES];
+
+static void setup(Inference &inference, bool incremental)
+{
+    inference.set_incremental(incremental);
+    if (inference.init() == false)
+    {
+        exit(1);
+    }
+}
+
+// seconds to score boards [first, last) one at a time
+static double run(Inference &inference, const std::vector<Board> &boards, std::vector<Scores> &scores, size_t first,
+                  size_t last)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = first; b < last; b++)
+    {
+        if (inference.score_board(boards[b], scores[b]) == false)
+        {
+            exit(1);
+        }
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void compare(const char *name, const std::vector<Board> &boards)
+{
+    alignas(16) static uint8_t full_arena[DELTABENCH_ARENA_SIZE];
+    alignas(16) static uint8_t delta_arena[DELTABENCH_ARENA_SIZE];
+    Inference plain = Inference(COLORDOT_MODEL, full_arena, sizeof(full_arena));
+    Inference incremental = Inference(COLORDOT_MODEL, delta_arena, sizeof(delta_arena));
+    setup(plain, false);
+    setup(incremental, true);
+
+    std::vector<Scores> full(boards.size());
+    std::vector<Scores> delta(boards.size());
+    double full_seconds = 0;
+    double delta_seconds = 0;
+    for (size_t first = 0; first < boards.size(); first += DELTABENCH_BLOCK)
+    {
+        size_t last = first + DELTABENCH_BLOCK < boards.size() ? first + DELTABENCH_BLOCK : boards.size();
+        double full_best = 1e9;
+        double delta_best = 1e9;
+        for (uint32_t round = 0; round < DELTABENCH_ROUNDS; round++)
+        {
+            double seconds = run(plain, boards, full, first, last);
+            full_best = seconds < full_best ? seconds : full_best;
+            seconds = run(incremental, boards, delta, first, last);
+            delta_best = seconds < delta_best ? seconds : delta_best;
+        }
+        full_seconds += full_best;
+        delta_seconds += delta_best;
+    }
+    double full_rate = boards.size() / full_seconds;
+    double delta_rate = boards.size() / delta_seconds;
+    uint32_t mismatches = 0;
+    for (size_t b = 0; b < boards.size(); b++)
+    {
+        mismatches += memcmp(full[b], delta[b], sizeof(Scores)) != 0;
+    }
+    printf("%s: full %.0f hints/s, incremental %.0f hints/s (%.2fx), %u mismatches\n", name, full_rate, delta_rate,
+           delta_rate / full_rate, mismatches);
+    if (mismatches > 0)
+    {
+        exit(1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t num_moves = argc > 1 ? atoi(argv[1]) : 20000;
+
+    // one board per move, a move toggles one row or column
+    std::vector<Board> moves(num_moves);
+    Game game = Game();
+    for (uint32_t m = 0; m < num_moves; m++)
+    {
+        if (m % DELTABENCH_GAME_MOVES == 0)
+        {
+            game.init();
+        }
+        game.toggle_switch(rand() % NUM_SWITCHES);
+        memcpy(moves[m], game.maze, sizeof(Board));
+    }
+    compare("one move apart", moves);
+
+    // the same boards shuffled, consecutive boards are unrelated
+    std::vector<Board> shuffled(num_moves);
+    memcpy(shuffled.data(), moves.data(), num_moves * sizeof(Board));
+    for (uint32_t m = num_moves - 1; m > 0; m--)
+    {
+        Board swap;
+        uint32_t other = rand() % (m + 1);
+        memcpy(swap, shuffled[m], sizeof(Board));
+        memcpy(shuffled[m], shuffled[other], sizeof(Board));
+        memcpy(shuffled[other], swap, sizeof(Board));
+    }
+    compare("unrelated", shuffled);
+    return 0;
+}
@@ -0,0 +1,105 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILE_FLASH_H
+#define FILE_FLASH_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "store.h"
+
+// Flash image in a file, memory mapped like the XIP flash of the Pico: the
+// data() pointers read the file in place and programming writes through to
+// it. A new or short file grows to size bytes of erased flash.
+class FileFlash : public FlashDriver
+{
+public:
+  FileFlash(const char *path, size_t size) : size(size)
+  {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+    struct stat st;
+    if ((fd < 0) || (fstat(fd, &st) != 0))
+    {
+      perror(path);
+      return;
+    }
+    size_t old_size = st.st_size;
+    if ((old_size < size) && (ftruncate(fd, size) != 0))
+    {
+      perror(path);
+      close(fd);
+      return;
+    }
+    void *mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+      perror("mmap");
+      return;
+    }
+    this->memory = (uint8_t *)mapped;
+    if (old_size < size)
+    {
+      memset(this->memory + old_size, 0xFF, size - old_size);
+    }
+  }
+
+  ~FileFlash()
+  {
+    if (this->memory != nullptr)
+    {
+      munmap(this->memory, this->size);
+    }
+  }
+
+  bool mapped()
+  {
+    return this->memory != nullptr;
+  }
+
+  const uint8_t *data(uint32_t offset) override
+  {
+    return this->memory + offset;
+  }
+
+  void program(uint32_t offset, const uint8_t *bytes, size_t len) override
+  {
+    for (size_t i = 0; i < len; i++)
+    {
+      this->memory[offset + i] &= bytes[i];
+    }
+  }
+
+  void erase(uint32_t offset) override
+  {
+    memset(this->memory + offset, 0xFF, STORE_SECTOR_SIZE);
+  }
+
+private:
+  uint8_t *memory = nullptr;
+  size_t size;
+};
+
+#endif // FILE_FLASH_H
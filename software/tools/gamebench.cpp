@@ -0,0 +1,133 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+// Host tool: move throughput of every compiled game variant. Checks that each
+// move is undone by its second toggle, that load() recovers the switches of a
+// shuffled board and that the lower bound stays within the scramble, then
+// reports moves, finish checks, lower bounds and level 7 shuffles per second.
+//
+//   gamebench [million moves]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "game.h"
+
+#define GAMEBENCH_BOARDS 2000
+#define GAMEBENCH_SEQUENCE 4096
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename G>
+static void bench(const char *name, uint32_t num_moves)
+{
+    G game = G();
+    G loaded = G();
+    uint32_t failed = 0;
+
+    // every move is its own inverse
+    for (uint8_t sw = 0; sw < G::NUM_SWITCHES; sw++)
+    {
+        game.toggle_switch(sw);
+        failed += game.check_finish() == true;
+        game.toggle_switch(sw);
+        failed += game.check_finish() == false;
+    }
+
+    // shuffled boards for the checks and the lower bound timing
+    std::vector<G> boards;
+    uint8_t switch_state[G::NUM_SWITCHES];
+    for (uint32_t b = 0; b < GAMEBENCH_BOARDS; b++)
+    {
+        for (uint8_t sw = 0; sw < G::NUM_SWITCHES; sw++)
+        {
+            switch_state[sw] = (b >> (sw % 16)) & 1;
+        }
+        game.shuffle_dots(b % 8, 1 + b, switch_state);
+        loaded.load(game.maze);
+        for (uint8_t sw = 0; sw < G::NUM_SWITCHES; sw++)
+        {
+            failed += loaded.switches[sw] != switch_state[sw];
+        }
+        failed += game.moves_lower_bound() > game.scramble_moves;
+        boards.push_back(game);
+    }
+
+    uint8_t sequence[GAMEBENCH_SEQUENCE];
+    srand(1);
+    for (uint32_t i = 0; i < GAMEBENCH_SEQUENCE; i++)
+    {
+        sequence[i] = rand() % G::NUM_SWITCHES;
+    }
+    game.init();
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_moves; i++)
+    {
+        game.toggle_switch(sequence[i % GAMEBENCH_SEQUENCE]);
+    }
+    double move_s = seconds_since(start);
+
+    uint32_t finished = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_moves / 16; i++)
+    {
+        finished += boards[i % GAMEBENCH_BOARDS].check_finish();
+    }
+    double finish_s = seconds_since(start);
+
+    uint32_t bounds = 0;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_moves / 64; i++)
+    {
+        bounds += boards[i % GAMEBENCH_BOARDS].moves_lower_bound();
+    }
+    double bound_s = seconds_since(start);
+
+    uint32_t num_shuffles = num_moves / 2000;
+    start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < num_shuffles; i++)
+    {
+        game.shuffle_dots(7, 1 + i, switch_state);
+    }
+    double shuffle_s = seconds_since(start);
+
+    // keeps the loops from being optimized away
+    if (finished + bounds + game.maze[1][1] == 0)
+    {
+        printf("\n");
+    }
+    printf("%-6s %8u %10.1f %12.1f %12.2f %12.0f\n", name, failed, num_moves / move_s / 1e6,
+           num_moves / 16 / finish_s / 1e6, num_moves / 64 / bound_s / 1e6, num_shuffles / shuffle_s);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t num_moves = (argc > 1 ? atoi(argv[1]) : 20) * 1000000;
+
+    printf("board  failures  Mmoves/s  Mfinish/s  Mbounds/s  shuffles/s\n");
+    bench<BasicGame<3, 3, 6>>("3x3", num_moves);
+    bench<Game>("4x4", num_moves);
+    bench<BasicGame<5, 5, 6>>("5x5", num_moves);
+    bench<BasicGame<6, 6, 6>>("6x6", num_moves);
+    return 0;
+}
@@ -0,0 +1,220 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: breadth-first search from the solved board to a given depth,
+// writes the optimal move of every reached board, one per symmetry class, as
+// a minimal perfect hash table (see hint_cache.h) to a C++ source file linked
+// into the firmware.
+//
+//   hintgen <depth> <output.cpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+#include "board.h"
+#include "game.h"
+#include "hint_cache.h"
+#include "symmetry.h"
+
+// bit array size per remaining key, trades table size against levels
+#define HINTGEN_GAMMA 2.0
+
+struct PackedBoardHash
+{
+    size_t operator()(const PackedBoard &packed) const
+    {
+        return hash_board(packed, 0x5EED);
+    }
+};
+
+int main(int argc, char **argv)
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <depth> <output.cpp>\n", argv[0]);
+        return 1;
+    }
+    uint8_t depth = atoi(argv[1]);
+
+    // every move is its own inverse, so the move leading back to the parent is optimal
+    std::unordered_map<PackedBoard, uint8_t, PackedBoardHash> moves;
+    std::vector<PackedBoard> frontier;
+    std::vector<PackedBoard> next;
+    std::vector<PackedBoard> boards;
+
+    Game game = Game();
+    frontier.push_back(pack_board(game.maze));
+    moves[frontier[0]] = 0;
+
+    for (uint8_t d = 1; d <= depth; d++)
+    {
+        next.clear();
+        for (const PackedBoard &parent : frontier)
+        {
+            for (uint8_t sw = 0; sw < 8; sw++)
+            {
+                Board maze;
+                unpack_board(parent, maze);
+                game.load(maze);
+                game.toggle_switch(sw);
+                PackedBoard child = pack_board(game.maze);
+                if (moves.emplace(child, sw).second)
+                {
+                    next.push_back(child);
+                }
+            }
+        }
+        printf("depth %d: %zu boards\n", d, next.size());
+        frontier.swap(next);
+    }
+
+    // store one board per symmetry class, with its move in the canonical frame
+    std::unordered_map<PackedBoard, uint8_t, PackedBoardHash> canonical_moves;
+    for (const auto &board_move : moves)
+    {
+        if (board_move.first == pack_board(Game().maze))
+        {
+            continue;
+        }
+        CanonicalBoard canonical = canonicalize(board_move.first);
+        uint8_t sw = switch_to_canonical(canonical.transform, board_move.second);
+        if (canonical_moves.emplace(canonical.packed, sw).second)
+        {
+            boards.push_back(canonical.packed);
+        }
+    }
+    moves.swap(canonical_moves);
+
+    // cascade of bit arrays, boards colliding on one level move on to the next
+    std::vector<uint32_t> level_words;
+    std::vector<uint32_t> bits;
+    std::vector<PackedBoard> remaining = boards;
+    std::vector<PackedBoard> collided;
+
+    for (uint8_t level = 0; remaining.size() > 0; level++)
+    {
+        // at least one word, hint_cache_index() hashes modulo the level size
+        uint32_t words = std::max((uint32_t)(remaining.size() * HINTGEN_GAMMA + 31) / 32, 1u);
+        uint32_t nbits = words * 32;
+        std::vector<uint8_t> hits(nbits, 0);
+
+        for (const PackedBoard &packed : remaining)
+        {
+            uint32_t pos = (uint32_t)hash_board(packed, level) % nbits;
+            if (hits[pos] < 2)
+            {
+                hits[pos]++;
+            }
+        }
+
+        size_t offset = bits.size();
+        bits.resize(offset + words, 0);
+        collided.clear();
+        for (const PackedBoard &packed : remaining)
+        {
+            uint32_t pos = (uint32_t)hash_board(packed, level) % nbits;
+            if (hits[pos] == 1)
+            {
+                bits[offset + pos / 32] |= 1u << (pos % 32);
+            }
+            else
+            {
+                collided.push_back(packed);
+            }
+        }
+        level_words.push_back(words);
+        remaining.swap(collided);
+    }
+
+    // pad to whole rank blocks
+    while (bits.size() % HINT_CACHE_BLOCK_WORDS != 0)
+    {
+        bits.push_back(0);
+    }
+    std::vector<uint32_t> rank;
+    uint32_t count = 0;
+    for (size_t i = 0; i < bits.size(); i++)
+    {
+        if (i % HINT_CACHE_BLOCK_WORDS == 0)
+        {
+            rank.push_back(count);
+        }
+        count += __builtin_popcount(bits[i]);
+    }
+
+    HintCacheTable table;
+    table.depth = depth;
+    table.levels = level_words.size();
+    table.size = boards.size();
+    table.level_words = level_words.data();
+    table.bits = bits.data();
+    table.rank = rank.data();
+
+    std::vector<uint8_t> entries((boards.size() + 1) / 2, 0);
+    for (const PackedBoard &packed : boards)
+    {
+        int32_t slot = hint_cache_index(table, packed);
+        if ((slot < 0) || (slot >= (int32_t)boards.size()))
+        {
+            fprintf(stderr, "board without slot\n");
+            return 1;
+        }
+        uint8_t entry = moves[packed] | hint_cache_fingerprint(packed);
+        entries[slot / 2] |= entry << ((slot % 2) * HINT_CACHE_ENTRY_BITS);
+    }
+
+    FILE *f = fopen(argv[2], "w");
+    if (f == nullptr)
+    {
+        perror(argv[2]);
+        return 1;
+    }
+    fprintf(f, "// Generated by tools/hintgen, do not edit.\n\n#include \"hint_cache.h\"\n\n");
+    fprintf(f, "static const uint32_t level_words[] = {");
+    for (size_t i = 0; i < level_words.size(); i++)
+    {
+        fprintf(f, "%s%u", i ? ", " : "", level_words[i]);
+    }
+    fprintf(f, "};\n\nstatic const uint32_t bits[] = {");
+    for (size_t i = 0; i < bits.size(); i++)
+    {
+        fprintf(f, "%s0x%08x", i % 8 ? ", " : (i ? ",\n    " : "\n    "), bits[i]);
+    }
+    fprintf(f, "};\n\nstatic const uint32_t rank[] = {");
+    for (size_t i = 0; i < rank.size(); i++)
+    {
+        fprintf(f, "%s%u", i % 8 ? ", " : (i ? ",\n    " : "\n    "), rank[i]);
+    }
+    fprintf(f, "};\n\nstatic const uint8_t entries[] = {");
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        fprintf(f, "%s0x%02x", i % 12 ? ", " : (i ? ",\n    " : "\n    "), entries[i]);
+    }
+    fprintf(f, "};\n\nconst HintCacheTable hint_cache_table = {%u, %u, %u, level_words, bits, rank, entries};\n",
+            table.depth, table.levels, table.size);
+    fclose(f);
+
+    size_t bytes = level_words.size() * 4 + bits.size() * 4 + rank.size() * 4 + entries.size();
+    printf("%u boards, %u levels, %zu bytes (%.2f bits per board)\n",
+           table.size, table.levels, bytes, 8.0 * bytes / table.size);
+    return 0;
+}
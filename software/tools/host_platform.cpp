@@ -0,0 +1,60 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host counterpart of tfl/tensorflow/lite/micro/system_setup.cpp and
+// micro_time.cpp: logs to stderr and counts microseconds of a steady clock.
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+#include "tensorflow/lite/micro/debug_log.h"
+#include "tensorflow/lite/micro/micro_time.h"
+#include "tensorflow/lite/micro/system_setup.h"
+
+namespace tflite
+{
+
+void InitializeTarget()
+{
+}
+
+uint32_t ticks_per_second()
+{
+    return 1000000;
+}
+
+uint32_t GetCurrentTimeTicks()
+{
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(now).count());
+}
+
+} // namespace tflite
+
+extern "C" void DebugLog(const char *format, va_list args)
+{
+    vfprintf(stderr, format, args);
+}
+
+int DebugVsnprintf(char *buffer, size_t buf_size, const char *format, va_list vlist)
+{
+    return vsnprintf(buffer, buf_size, format, vlist);
+}
@@ -0,0 +1,102 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "host_worker_pool.h"
+
+HostWorkerPool::HostWorkerPool(int num_workers, int32_t min_work_per_worker)
+    : tflite::MicroWorkerPool(min_work_per_worker)
+{
+    this->workers = num_workers > 1 ? num_workers : 1;
+    for (int worker = 1; worker < this->workers; worker++)
+    {
+        this->threads.emplace_back(&HostWorkerPool::worker_loop, this, worker);
+    }
+}
+
+HostWorkerPool::~HostWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopping = true;
+    }
+    this->started.notify_all();
+    for (std::thread &thread : this->threads)
+    {
+        thread.join();
+    }
+}
+
+int HostWorkerPool::num_workers() const
+{
+    return this->workers;
+}
+
+void HostWorkerPool::Run(Task task, void *data, int num_parts)
+{
+    if (num_parts < 2)
+    {
+        task(data, 0, num_parts);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->task = task;
+        this->data = data;
+        this->num_parts = num_parts;
+        this->pending = num_parts - 1;
+        this->generation++;
+    }
+    this->started.notify_all();
+    task(data, 0, num_parts);
+
+    // barrier: the next operator reads the output of every part
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->finished.wait(lock, [this]() { return this->pending == 0; });
+}
+
+void HostWorkerPool::worker_loop(int worker)
+{
+    uint64_t seen = 0;
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->started.wait(lock, [&]() { return this->stopping || this->generation != seen; });
+        if (this->stopping == true)
+        {
+            return;
+        }
+        seen = this->generation;
+        if (worker >= this->num_parts)
+        {
+            continue;
+        }
+        Task task = this->task;
+        void *data = this->data;
+        int num_parts = this->num_parts;
+        lock.unlock();
+
+        task(data, worker, num_parts);
+
+        lock.lock();
+        if (--this->pending == 0)
+        {
+            this->finished.notify_one();
+        }
+    }
+}
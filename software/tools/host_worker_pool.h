@@ -0,0 +1,62 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef HOST_WORKER_POOL_H
+#define HOST_WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/lite/micro/micro_worker_pool.h"
+
+// waking a sleeping thread costs microseconds, a few hundred thousand
+// multiply-accumulates on a host core
+#define HOST_MIN_WORK_PER_THREAD (64 * 1024)
+
+// MicroWorkerPool over host threads: part 0 runs on the calling thread, the
+// other parts on num_workers - 1 threads started by the constructor.
+class HostWorkerPool : public tflite::MicroWorkerPool
+{
+public:
+  HostWorkerPool(int num_workers, int32_t min_work_per_worker = HOST_MIN_WORK_PER_THREAD);
+  ~HostWorkerPool();
+  int num_workers() const override;
+  void Run(Task task, void *data, int num_parts) override;
+
+private:
+  int workers;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable started;
+  std::condition_variable finished;
+  // bumped by every Run(), the threads wait for the next value
+  uint64_t generation = 0;
+  int pending = 0;
+  bool stopping = false;
+  Task task = nullptr;
+  void *data = nullptr;
+  int num_parts = 0;
+
+  void worker_loop(int worker);
+};
+
+#endif // HOST_WORKER_POOL_H
@@ -0,0 +1,210 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: compares the int4 weight model from tools/int4pack with the
+// int8 model on boards scrambled by random moves from the solution. Reports
+// how often both pick the same hint, how often each hint is optimal (exact
+// distances from a breadth-first search up to COMPARE_BFS_DEPTH), the weight
+// bytes streamed from flash per inference and the host time per inference.
+//
+//   int4compare [boards per scramble depth]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
+
+#include "board.h"
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+
+#define COMPARE_BFS_DEPTH 6
+#define COMPARE_MAX_SCRAMBLE 12
+#define COMPARE_ARENA_SIZE (32 * 1024)
+
+struct PackedBoardHash
+{
+    size_t operator()(const PackedBoard &packed) const
+    {
+        return hash_board(packed, 0x5EED);
+    }
+};
+
+struct ModelStats
+{
+    const char *name;
+    Inference *inference;
+    size_t weight_bytes;
+    uint32_t optimal;
+    double seconds;
+};
+
+alignas(16) static uint8_t arena_s8[COMPARE_ARENA_SIZE];
+alignas(16) static uint8_t arena_s4[COMPARE_ARENA_SIZE];
+
+// bytes of the FULLY_CONNECTED and CONV_2D filters, read once per inference
+static size_t weight_bytes(const unsigned char *model_data)
+{
+    const tflite::Model *model = tflite::GetModel(model_data);
+    size_t bytes = 0;
+    for (const tflite::SubGraph *subgraph : *model->subgraphs())
+    {
+        for (const tflite::Operator *op : *subgraph->operators())
+        {
+            tflite::BuiltinOperator code = tflite::GetBuiltinCode(model->operator_codes()->Get(op->opcode_index()));
+            if ((code == tflite::BuiltinOperator_FULLY_CONNECTED) || (code == tflite::BuiltinOperator_CONV_2D))
+            {
+                const tflite::Tensor *filter = subgraph->tensors()->Get(op->inputs()->Get(1));
+                bytes += model->buffers()->Get(filter->buffer())->data()->size();
+            }
+        }
+    }
+    return bytes;
+}
+
+static uint8_t best_switch(const int8_t scores[NUM_SWITCHES])
+{
+    uint8_t best = 0;
+    for (uint8_t i = 1; i < NUM_SWITCHES; i++)
+    {
+        if (scores[i] > scores[best])
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t boards_per_depth = argc > 1 ? atoi(argv[1]) : 200;
+
+    // exact distances near the solution
+    std::unordered_map<PackedBoard, uint8_t, PackedBoardHash> distance;
+    std::vector<PackedBoard> frontier;
+    std::vector<PackedBoard> next;
+    Game game = Game();
+    frontier.push_back(pack_board(game.maze));
+    distance[frontier[0]] = 0;
+    for (uint8_t d = 1; d <= COMPARE_BFS_DEPTH; d++)
+    {
+        next.clear();
+        for (const PackedBoard &parent : frontier)
+        {
+            for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
+            {
+                Board maze;
+                unpack_board(parent, maze);
+                game.load(maze);
+                game.toggle_switch(sw);
+                PackedBoard child = pack_board(game.maze);
+                if (distance.emplace(child, d).second)
+                {
+                    next.push_back(child);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+
+    Inference inference_s8 = Inference(colordot_q_tfl_tflite, arena_s8, sizeof(arena_s8));
+    Inference inference_s4 = Inference(colordot_q_tfl_s4_tflite, arena_s4, sizeof(arena_s4));
+    if ((inference_s8.init() == false) || (inference_s4.init() == false))
+    {
+        return 1;
+    }
+    ModelStats models[2] = {
+        {"int8", &inference_s8, weight_bytes(colordot_q_tfl_tflite), 0, 0.0},
+        {"int4", &inference_s4, weight_bytes(colordot_q_tfl_s4_tflite), 0, 0.0},
+    };
+
+    uint32_t boards = 0;
+    uint32_t known = 0;
+    uint32_t agree = 0;
+    uint64_t score_diff = 0;
+    srand(1);
+
+    for (uint8_t depth = 1; depth <= COMPARE_MAX_SCRAMBLE; depth++)
+    {
+        for (uint32_t n = 0; n < boards_per_depth; n++)
+        {
+            game.init();
+            for (uint8_t i = 0; i < depth; i++)
+            {
+                game.toggle_switch(rand() % NUM_SWITCHES);
+            }
+            if (game.check_finish() == true)
+            {
+                continue;
+            }
+            Board maze;
+            memcpy(maze, game.maze, sizeof(maze));
+            auto dist = distance.find(pack_board(maze));
+
+            int8_t scores[2][NUM_SWITCHES];
+            uint8_t hint[2];
+            for (uint8_t m = 0; m < 2; m++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                if (models[m].inference->score_board(maze, scores[m]) == false)
+                {
+                    fprintf(stderr, "%s: Invoke() failed\n", models[m].name);
+                    return 1;
+                }
+                models[m].seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                hint[m] = best_switch(scores[m]);
+
+                if (dist != distance.end())
+                {
+                    game.load(maze);
+                    game.toggle_switch(hint[m]);
+                    auto child = distance.find(pack_board(game.maze));
+                    if ((child != distance.end()) && (child->second + 1 == dist->second))
+                    {
+                        models[m].optimal++;
+                    }
+                }
+            }
+
+            boards++;
+            known += dist != distance.end() ? 1 : 0;
+            agree += hint[0] == hint[1] ? 1 : 0;
+            for (uint8_t i = 0; i < NUM_SWITCHES; i++)
+            {
+                score_diff += abs(scores[0][i] - scores[1][i]);
+            }
+        }
+    }
+
+    printf("%u boards, %u within %d moves of the solution\n", boards, known, COMPARE_BFS_DEPTH);
+    printf("same hint: %.1f%%, mean score difference %.2f\n", 100.0 * agree / boards,
+           (double)score_diff / (boards * NUM_SWITCHES));
+    for (const ModelStats &model : models)
+    {
+        printf("%s: %zu weight bytes, optimal hint %.1f%%, %.1f us per inference on the host\n", model.name,
+               model.weight_bytes, known > 0 ? 100.0 * model.optimal / known : 0.0, 1e6 * model.seconds / boards);
+    }
+    return 0;
+}
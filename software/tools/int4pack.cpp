@@ -0,0 +1,193 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: requantizes the int8 weights of every FULLY_CONNECTED and
+// CONV_2D operator of the colordot model to int4 and writes the model with
+// the packed weights (two per byte, even element in the low nibble) as a C
+// array. CONV_2D keeps its per-channel scales, FULLY_CONNECTED gets a single
+// scale as arm_fully_connected_s4 only takes per-tensor parameters. The
+// biases are rescaled to the new filter scales.
+//
+//   int4pack <output.cpp>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
+
+#include "model_data.h"
+
+static int8_t quantize_int4(float value, float scale)
+{
+    if (scale == 0.0f)
+    {
+        return 0;
+    }
+    long q = lroundf(value / scale);
+    return (int8_t)(q < -8 ? -8 : (q > 7 ? 7 : q));
+}
+
+// requantizes the filter of one operator and its bias in place, returns the saved bytes or -1
+static long pack_operator(tflite::ModelT *model, tflite::SubGraphT *subgraph, const tflite::OperatorT *op,
+                          bool per_channel)
+{
+    tflite::TensorT *filter = subgraph->tensors[op->inputs[1]].get();
+    tflite::QuantizationParametersT *quant = filter->quantization.get();
+    if ((filter->type != tflite::TensorType_INT8) || (quant == nullptr) || (quant->scale.empty() == true) ||
+        (quant->quantized_dimension != 0))
+    {
+        fprintf(stderr, "error: filter %s is not int8 quantized along its first dimension\n", filter->name.c_str());
+        return -1;
+    }
+    // the buffer is rewritten, no other tensor may read it as int8
+    for (const auto &tensor : subgraph->tensors)
+    {
+        if ((tensor.get() != filter) && (tensor->buffer == filter->buffer))
+        {
+            fprintf(stderr, "error: filter %s shares its buffer\n", filter->name.c_str());
+            return -1;
+        }
+    }
+
+    std::vector<uint8_t> &data = model->buffers[filter->buffer]->data;
+    size_t count = data.size();
+    size_t channels = filter->shape[0];
+    size_t per_channel_count = count / channels;
+    std::vector<float> old_scale(channels);
+    for (size_t c = 0; c < channels; c++)
+    {
+        old_scale[c] = quant->scale.size() == 1 ? quant->scale[0] : quant->scale[c];
+    }
+
+    // symmetric int4 range [-7, 7] per output channel, or over the whole tensor
+    std::vector<float> new_scale(channels, 0.0f);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t c = i / per_channel_count;
+        float value = fabsf((int8_t)data[i] * old_scale[c]) / 7.0f;
+        size_t group = per_channel ? c : 0;
+        new_scale[group] = value > new_scale[group] ? value : new_scale[group];
+    }
+    if (per_channel == false)
+    {
+        for (size_t c = 1; c < channels; c++)
+        {
+            new_scale[c] = new_scale[0];
+        }
+    }
+
+    std::vector<uint8_t> packed((count + 1) / 2, 0);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t c = i / per_channel_count;
+        int8_t q = quantize_int4((int8_t)data[i] * old_scale[c], new_scale[c]);
+        packed[i / 2] |= (uint8_t)((q & 0x0F) << (4 * (i % 2)));
+    }
+    data.swap(packed);
+    filter->type = tflite::TensorType_INT4;
+    quant->scale.assign(new_scale.begin(), new_scale.begin() + (per_channel ? channels : 1));
+    quant->zero_point.assign(quant->scale.size(), 0);
+
+    // the bias is quantized with input scale * filter scale
+    if ((op->inputs.size() > 2) && (op->inputs[2] >= 0))
+    {
+        tflite::TensorT *bias = subgraph->tensors[op->inputs[2]].get();
+        int32_t *values = (int32_t *)model->buffers[bias->buffer]->data.data();
+        for (size_t c = 0; c < channels; c++)
+        {
+            float ratio = new_scale[c] == 0.0f ? 0.0f : old_scale[c] / new_scale[c];
+            values[c] = (int32_t)lroundf(values[c] * ratio);
+        }
+        if (bias->quantization != nullptr)
+        {
+            std::vector<float> &bias_scale = bias->quantization->scale;
+            for (size_t c = 0; c < bias_scale.size(); c++)
+            {
+                bias_scale[c] *= new_scale[c] / old_scale[c];
+            }
+        }
+    }
+
+    printf("%-40s %zu channels, %zu -> %zu bytes\n", filter->name.c_str(), channels, count, data.size());
+    return (long)(count - data.size());
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s <output.cpp>\n", argv[0]);
+        return 1;
+    }
+
+    std::unique_ptr<tflite::ModelT> model(tflite::GetModel(colordot_q_tfl_tflite)->UnPack());
+    long saved = 0;
+
+    for (auto &subgraph : model->subgraphs)
+    {
+        for (const auto &op : subgraph->operators)
+        {
+            tflite::BuiltinOperator code = tflite::GetBuiltinCode(model->operator_codes[op->opcode_index].get());
+            long bytes = 0;
+            if (code == tflite::BuiltinOperator_CONV_2D)
+            {
+                bytes = pack_operator(model.get(), subgraph.get(), op.get(), true);
+            }
+            else if (code == tflite::BuiltinOperator_FULLY_CONNECTED)
+            {
+                bytes = pack_operator(model.get(), subgraph.get(), op.get(), false);
+            }
+            if (bytes < 0)
+            {
+                return 1;
+            }
+            saved += bytes;
+        }
+    }
+
+    // the vendored flatbuffers has no fallback for a null allocator
+    flatbuffers::DefaultAllocator allocator;
+    flatbuffers::FlatBufferBuilder builder(colordot_q_tfl_tflite_len, &allocator);
+    builder.Finish(tflite::Model::Pack(builder, model.get()), tflite::ModelIdentifier());
+
+    FILE *f = fopen(argv[1], "w");
+    if (f == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    fprintf(f, "// Generated by tools/int4pack, do not edit.\n\n#include \"model_data.h\"\n\n");
+    fprintf(f, "alignas(16) const unsigned char colordot_q_tfl_s4_tflite[] = {");
+    for (uint32_t i = 0; i < builder.GetSize(); i++)
+    {
+        fprintf(f, "%s%u", (i % 32) == 0 ? "\n    " : "", builder.GetBufferPointer()[i]);
+        if (i + 1 < builder.GetSize())
+        {
+            fprintf(f, ",");
+        }
+    }
+    fprintf(f, "};\nconst unsigned int colordot_q_tfl_s4_tflite_len = %u;\n", builder.GetSize());
+    fclose(f);
+
+    printf("model: %u -> %u bytes, %ld weight bytes saved\n", colordot_q_tfl_tflite_len, builder.GetSize(), saved);
+    return 0;
+}
@@ -0,0 +1,260 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+// Host tool: runs the CMSIS-NN s8 kernels at the layer shapes of the model
+// with the portable C loops, SSE4.1 and AVX2 (as far as the CPU supports
+// them), checks that every instruction set gives the bytes of the C loops
+// and reports the time per call and the multiply-accumulates per second.
+// Then scores the same boards with the whole model at every instruction set.
+// Exits with 1 on the first mismatch.
+//
+//   kernelbench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#include "third_party/cmsis_nn/Include/arm_nnfunctions.h"
+
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+
+#define BENCH_ARENA_SIZE (32 * 1024)
+#define BENCH_BOARDS 2000
+
+static const char *level_names[] = {"C", "SSE4.1", "AVX2"};
+
+struct Kernel
+{
+    const char *name;
+    uint64_t macs; // multiply-accumulates (comparisons for pooling) per call
+    std::function<void(int8_t *)> run;
+    size_t output_bytes;
+};
+
+static int8_t random_s8()
+{
+    return (int8_t)(rand() & 0xFF);
+}
+
+static std::vector<int8_t> random_s8(size_t count)
+{
+    std::vector<int8_t> data(count);
+    for (int8_t &value : data)
+    {
+        value = random_s8();
+    }
+    return data;
+}
+
+// multipliers in [2^30, 2^31) and right shifts as produced by the TFLite converter
+static void random_quant(int32_t *multiplier, int32_t *shift, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        multiplier[i] = (1 << 30) + (rand() & 0x3FFFFFFF);
+        shift[i] = -(rand() % 10) - 1;
+    }
+}
+
+static std::vector<int32_t> random_bias(size_t count)
+{
+    std::vector<int32_t> bias(count);
+    for (int32_t &value : bias)
+    {
+        value = (rand() % 8192) - 4096;
+    }
+    return bias;
+}
+
+// FULLY_CONNECTED with batch rows of in_features
+static Kernel fully_connected(const char *name, int32_t batch, int32_t in_features, int32_t out_features)
+{
+    auto input = std::make_shared<std::vector<int8_t>>(random_s8(batch * in_features));
+    auto filter = std::make_shared<std::vector<int8_t>>(random_s8(out_features * in_features));
+    auto bias = std::make_shared<std::vector<int32_t>>(random_bias(out_features));
+    int32_t multiplier;
+    int32_t shift;
+    random_quant(&multiplier, &shift, 1);
+    int32_t input_offset = 128 - (rand() & 0xFF);
+    int32_t output_offset = -128 + (rand() & 0xFF);
+
+    auto run = [=](int8_t *output)
+    {
+        cmsis_nn_context ctx = {nullptr, 0};
+        cmsis_nn_fc_params fc_params = {input_offset, 0, output_offset, {-128, 127}};
+        cmsis_nn_per_tensor_quant_params quant_params = {multiplier, shift};
+        cmsis_nn_dims input_dims = {batch, 1, 1, in_features};
+        cmsis_nn_dims filter_dims = {in_features, 1, 1, out_features};
+        cmsis_nn_dims bias_dims = {1, 1, 1, out_features};
+        cmsis_nn_dims output_dims = {batch, 1, 1, out_features};
+        arm_fully_connected_s8(&ctx, &fc_params, &quant_params, &input_dims, input->data(), &filter_dims,
+                               filter->data(), &bias_dims, bias->data(), &output_dims, output);
+    };
+    return {name, (uint64_t)batch * in_features * out_features, run, (size_t)(batch * out_features)};
+}
+
+// CONV_2D, stride 1 without padding (the model pads with a separate PAD)
+static Kernel conv(const char *name, int32_t size, int32_t in_ch, int32_t kernel, int32_t out_ch)
+{
+    int32_t out_size = size - kernel + 1;
+    auto input = std::make_shared<std::vector<int8_t>>(random_s8(size * size * in_ch));
+    auto filter = std::make_shared<std::vector<int8_t>>(random_s8(out_ch * kernel * kernel * in_ch));
+    auto bias = std::make_shared<std::vector<int32_t>>(random_bias(out_ch));
+    auto multiplier = std::make_shared<std::vector<int32_t>>(out_ch);
+    auto shift = std::make_shared<std::vector<int32_t>>(out_ch);
+    random_quant(multiplier->data(), shift->data(), out_ch);
+    int32_t input_offset = 128 - (rand() & 0xFF);
+    int32_t output_offset = -128 + (rand() & 0xFF);
+    cmsis_nn_dims input_dims = {1, size, size, in_ch};
+    cmsis_nn_dims filter_dims = {out_ch, kernel, kernel, in_ch};
+    auto buffer = std::make_shared<std::vector<int8_t>>(arm_convolve_s8_get_buffer_size(&input_dims, &filter_dims));
+
+    auto run = [=](int8_t *output)
+    {
+        cmsis_nn_context ctx = {buffer->data(), (int32_t)buffer->size()};
+        cmsis_nn_conv_params conv_params = {input_offset, output_offset, {1, 1}, {0, 0}, {1, 1}, {0, 127}};
+        cmsis_nn_per_channel_quant_params quant_params = {multiplier->data(), shift->data()};
+        cmsis_nn_dims bias_dims = {1, 1, 1, out_ch};
+        cmsis_nn_dims output_dims = {1, out_size, out_size, out_ch};
+        arm_convolve_s8(&ctx, &conv_params, &quant_params, &input_dims, input->data(), &filter_dims, filter->data(),
+                        &bias_dims, bias->data(), &output_dims, output);
+    };
+    return {name, (uint64_t)out_size * out_size * out_ch * kernel * kernel * in_ch, run,
+            (size_t)(out_size * out_size * out_ch)};
+}
+
+// MAX_POOL_2D with a 2x2 window and stride 2
+static Kernel max_pool(const char *name, int32_t size, int32_t channels)
+{
+    auto input = std::make_shared<std::vector<int8_t>>(random_s8(size * size * channels));
+    int32_t out_size = size / 2;
+
+    auto run = [=](int8_t *output)
+    {
+        cmsis_nn_context ctx = {nullptr, 0};
+        cmsis_nn_pool_params pool_params = {{2, 2}, {0, 0}, {-128, 127}};
+        cmsis_nn_dims input_dims = {1, size, size, channels};
+        cmsis_nn_dims filter_dims = {1, 2, 2, 1};
+        cmsis_nn_dims output_dims = {1, out_size, out_size, channels};
+        arm_max_pool_s8(&ctx, &pool_params, &input_dims, input->data(), &filter_dims, &output_dims, output);
+    };
+    return {name, (uint64_t)out_size * out_size * channels * 3, run, (size_t)(out_size * out_size * channels)};
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    int32_t detected = arm_nn_x86_level();
+    printf("CPU: %s\n", level_names[detected]);
+    srand(1);
+
+    std::vector<Kernel> kernels = {
+        conv("CONV_2D 8x8x8 3x3 -> 16", 8, 8, 3, 16),
+        max_pool("MAX_POOL_2D 6x6x16", 6, 16),
+        fully_connected("FULLY_CONNECTED 144 -> 64", 1, 144, 64),
+        fully_connected("FULLY_CONNECTED 64 -> 8", 1, 64, 8),
+        fully_connected("FULLY_CONNECTED 8x144 -> 64", 8, 144, 64),
+    };
+    int failures = 0;
+    for (Kernel &kernel : kernels)
+    {
+        std::vector<int8_t> expected(kernel.output_bytes);
+        std::vector<int8_t> output(kernel.output_bytes);
+        double c_seconds = 0.0;
+        printf("%s\n", kernel.name);
+        for (int32_t level = ARM_NN_X86_NONE; level <= detected; level++)
+        {
+            arm_nn_x86_set_level(level);
+            memset(output.data(), 0x55, output.size());
+            kernel.run(output.data());
+            if (level == ARM_NN_X86_NONE)
+            {
+                expected = output;
+            }
+            bool exact = output == expected;
+            failures += exact ? 0 : 1;
+
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < iterations; i++)
+            {
+                kernel.run(output.data());
+            }
+            double seconds = seconds_since(start);
+            c_seconds = level == ARM_NN_X86_NONE ? seconds : c_seconds;
+            printf("  %-7s %8.1f ns/call %8.2f GMAC/s  %5.2fx  %s\n", level_names[level], 1e9 * seconds / iterations,
+                   kernel.macs * iterations / seconds / 1e9, c_seconds / seconds, exact ? "bit-exact" : "MISMATCH");
+        }
+    }
+
+    // whole model on boards scrambled by random moves
+    alignas(16) static uint8_t arena[BENCH_ARENA_SIZE];
+    Inference inference = Inference(COLORDOT_MODEL, arena, sizeof(arena));
+    if (inference.init() == false)
+    {
+        return 1;
+    }
+    static Board boards[BENCH_BOARDS];
+    Game game = Game();
+    for (uint32_t b = 0; b < BENCH_BOARDS; b++)
+    {
+        game.init();
+        for (uint8_t i = 0; i < 1 + b % 20; i++)
+        {
+            game.toggle_switch(rand() % NUM_SWITCHES);
+        }
+        memcpy(boards[b], game.maze, sizeof(Board));
+    }
+    static int8_t expected[BENCH_BOARDS][NUM_SWITCHES];
+    static int8_t scores[BENCH_BOARDS][NUM_SWITCHES];
+    double c_seconds = 0.0;
+    printf("model\n");
+    for (int32_t level = ARM_NN_X86_NONE; level <= detected; level++)
+    {
+        arm_nn_x86_set_level(level);
+        auto start = std::chrono::steady_clock::now();
+        if (inference.score_boards(boards, BENCH_BOARDS, scores) == false)
+        {
+            return 1;
+        }
+        double seconds = seconds_since(start);
+        if (level == ARM_NN_X86_NONE)
+        {
+            memcpy(expected, scores, sizeof(scores));
+            c_seconds = seconds;
+        }
+        bool exact = memcmp(scores, expected, sizeof(scores)) == 0;
+        failures += exact ? 0 : 1;
+        printf("  %-7s %8.0f inferences/s  %5.2fx  %s\n", level_names[level], BENCH_BOARDS / seconds,
+               c_seconds / seconds, exact ? "bit-exact" : "MISMATCH");
+    }
+    arm_nn_x86_set_level(-1);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,858 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: conformance and speed of the kernels of the 11 operators the
+// firmware registers (register_ops()). Every case draws random shapes,
+// quantization parameters and data, runs the registered kernel through
+// KernelRunner and compares its output with the reference: the integer
+// kernels of kernels/internal/reference for CONV_2D, FULLY_CONNECTED and
+// MAX_POOL_2D, the fixed-point formula of the reference for ADD and SUB, a
+// plain index loop for the layout operators. The CMSIS-NN kernels run on the
+// portable C loops, on every SSE4.1 / AVX2 level the CPU has and split over
+// two threads, each variant has to match the reference to the bit. Reports
+// the nanoseconds per output element of every variant and exits with 1 if any
+// case did not match.
+//
+//   kernelcheck [cases per operator] [timed invokes per case] [seed]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "tensorflow/lite/kernels/internal/quantization_util.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/conv.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/fully_connected.h"
+#include "tensorflow/lite/kernels/internal/reference/integer_ops/pooling.h"
+#include "tensorflow/lite/kernels/padding.h"
+#include "tensorflow/lite/micro/kernels/kernel_runner.h"
+#include "tensorflow/lite/micro/kernels/micro_ops.h"
+#include "tensorflow/lite/micro/test_helpers.h"
+#ifdef ARM_NN_X86_SIMD
+#include "third_party/cmsis_nn/Include/arm_nn_x86.h"
+#endif
+
+#include "host_worker_pool.h"
+
+#define KERNELCHECK_THREADS 2
+
+typedef std::vector<int> Dims;
+
+// One randomized operator: tensors (inputs, then the output) with the
+// storage behind them, and the output the reference computed.
+struct OpCase
+{
+    std::string description;
+    std::vector<TfLiteTensor> tensors;
+    // node input tensor indices, an index may repeat
+    std::vector<int> inputs;
+    std::deque<std::vector<int>> int_arrays;
+    std::deque<std::vector<float>> float_arrays;
+    std::deque<std::vector<uint8_t>> buffers;
+    std::deque<TfLiteAffineQuantization> quantizations;
+    std::vector<uint8_t> builtin_data;
+    std::vector<uint8_t> expected;
+};
+
+struct Operator
+{
+    const char *name;
+    TFLMRegistration registration;
+    void (*make_case)(OpCase &op_case);
+    // CMSIS-NN kernel: runs on every instruction set level and on the pool
+    bool optimized;
+};
+
+struct Variant
+{
+    const char *name;
+    int32_t x86_level;
+    bool pool;
+};
+
+static int random_int(int low, int high)
+{
+    return low + rand() % (high - low + 1);
+}
+
+static float random_scale(float low, float high)
+{
+    return low + (high - low) * (rand() / (float)RAND_MAX);
+}
+
+static int element_count(const Dims &dims)
+{
+    int count = 1;
+    for (int d : dims)
+    {
+        count *= d;
+    }
+    return count;
+}
+
+static std::string dims_string(const Dims &dims)
+{
+    std::string text = "[";
+    for (size_t i = 0; i < dims.size(); i++)
+    {
+        text += (i > 0 ? "," : "") + std::to_string(dims[i]);
+    }
+    return text + "]";
+}
+
+// TfLiteIntArray of values, kept alive by the case
+static TfLiteIntArray *int_array(OpCase &op_case, const Dims &values)
+{
+    std::vector<int> &array = op_case.int_arrays.emplace_back(1, (int)values.size());
+    array.insert(array.end(), values.begin(), values.end());
+    return tflite::testing::IntArrayFromInts(array.data());
+}
+
+// appends a tensor of type and dims with zeroed storage and returns the storage
+template <typename T>
+static T *add_tensor(OpCase &op_case, const Dims &dims, float scale = 0.0f, int zero_point = 0)
+{
+    std::vector<uint8_t> &buffer = op_case.buffers.emplace_back(element_count(dims) * sizeof(T), 0);
+    T *data = reinterpret_cast<T *>(buffer.data());
+    TfLiteIntArray *tensor_dims = int_array(op_case, dims);
+    if (scale > 0.0f)
+    {
+        op_case.tensors.push_back(tflite::testing::CreateQuantizedTensor(data, tensor_dims, scale, zero_point));
+    }
+    else
+    {
+        op_case.tensors.push_back(tflite::testing::CreateTensor(data, tensor_dims));
+    }
+    return data;
+}
+
+template <typename T>
+static T *add_input(OpCase &op_case, const Dims &dims, float scale = 0.0f, int zero_point = 0)
+{
+    op_case.inputs.push_back(op_case.tensors.size());
+    return add_tensor<T>(op_case, dims, scale, zero_point);
+}
+
+// the last tensor is a constant of the model, as filters or the paddings of PAD
+static void make_constant(OpCase &op_case)
+{
+    op_case.tensors.back().allocation_type = kTfLiteMmapRo;
+}
+
+static void fill_random(int8_t *data, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        data[i] = (int8_t)(rand() & 0xFF);
+    }
+}
+
+// per-channel scales along dimension 0 of the last tensor
+static void quantize_per_channel(OpCase &op_case, const std::vector<float> &scales)
+{
+    std::vector<float> &scale_array = op_case.float_arrays.emplace_back(1, (float)scales.size());
+    scale_array.insert(scale_array.end(), scales.begin(), scales.end());
+    TfLiteAffineQuantization &quantization = op_case.quantizations.emplace_back();
+    quantization.scale = tflite::testing::FloatArrayFromFloats(scale_array.data());
+    quantization.zero_point = int_array(op_case, Dims(scales.size(), 0));
+    quantization.quantized_dimension = 0;
+    TfLiteTensor &tensor = op_case.tensors.back();
+    tensor.params = {scales[0], 0};
+    tensor.quantization = {kTfLiteAffineQuantization, &quantization};
+}
+
+template <typename Params>
+static Params *set_builtin_data(OpCase &op_case, const Params &params)
+{
+    op_case.builtin_data.resize(sizeof(Params));
+    memcpy(op_case.builtin_data.data(), &params, sizeof(Params));
+    return reinterpret_cast<Params *>(op_case.builtin_data.data());
+}
+
+template <typename T>
+static T *expected_output(OpCase &op_case, int count)
+{
+    op_case.expected.assign(count * sizeof(T), 0);
+    return reinterpret_cast<T *>(op_case.expected.data());
+}
+
+static TfLiteFusedActivation random_activation()
+{
+    static const TfLiteFusedActivation activations[] = {kTfLiteActNone, kTfLiteActRelu, kTfLiteActRelu6};
+    return activations[rand() % 3];
+}
+
+// int8 clamp of a fused activation, as CalculateActivationRangeQuantized()
+static void activation_range(TfLiteFusedActivation activation, float scale, int zero_point, int32_t *min, int32_t *max)
+{
+    auto quantize = [=](float f) { return zero_point + (int32_t)tflite::TfLiteRound(f / scale); };
+    *min = -128;
+    *max = 127;
+    if (activation == kTfLiteActRelu || activation == kTfLiteActRelu6)
+    {
+        *min = std::max(*min, quantize(0.0f));
+    }
+    if (activation == kTfLiteActRelu6)
+    {
+        *max = std::min(*max, quantize(6.0f));
+    }
+}
+
+static const char *activation_name(TfLiteFusedActivation activation)
+{
+    return activation == kTfLiteActRelu ? " relu" : activation == kTfLiteActRelu6 ? " relu6" : "";
+}
+
+static void conv_case(OpCase &op_case)
+{
+    Dims input_dims = {1, random_int(3, 10), random_int(3, 10), random_int(1, 16)};
+    int out_channels = random_int(1, 24);
+    Dims filter_dims = {out_channels, random_int(1, 3), random_int(1, 3), input_dims[3]};
+    TfLiteConvParams params = {};
+    params.padding = rand() % 2 ? kTfLitePaddingSame : kTfLitePaddingValid;
+    params.stride_width = random_int(1, 2);
+    params.stride_height = random_int(1, 2);
+    params.dilation_width_factor = 1;
+    params.dilation_height_factor = 1;
+    params.activation = random_activation();
+    params.quantized_bias_type = kTfLiteInt32;
+    set_builtin_data(op_case, params);
+    int out_height;
+    int out_width;
+    TfLitePaddingValues padding = tflite::ComputePaddingHeightWidth(
+        params.stride_height, params.stride_width, 1, 1, input_dims[1], input_dims[2], filter_dims[1], filter_dims[2],
+        params.padding, &out_height, &out_width);
+    Dims output_dims = {1, out_height, out_width, out_channels};
+
+    float input_scale = random_scale(0.01f, 0.1f);
+    int input_zero_point = random_int(-128, 127);
+    float output_scale = random_scale(0.02f, 0.2f);
+    int output_zero_point = random_int(-128, 127);
+    std::vector<float> filter_scales(out_channels);
+    for (float &scale : filter_scales)
+    {
+        scale = random_scale(0.001f, 0.02f);
+    }
+    int8_t *input = add_input<int8_t>(op_case, input_dims, input_scale, input_zero_point);
+    int8_t *filter = add_input<int8_t>(op_case, filter_dims);
+    quantize_per_channel(op_case, filter_scales);
+    make_constant(op_case);
+    int32_t *bias = add_input<int32_t>(op_case, {out_channels});
+    make_constant(op_case);
+    add_tensor<int8_t>(op_case, output_dims, output_scale, output_zero_point);
+    fill_random(input, element_count(input_dims));
+    fill_random(filter, element_count(filter_dims));
+    for (int c = 0; c < out_channels; c++)
+    {
+        bias[c] = random_int(-4096, 4095);
+    }
+
+    // multipliers as PopulateConvolutionQuantizationParams()
+    std::vector<int32_t> multipliers(out_channels);
+    std::vector<int32_t> shifts(out_channels);
+    for (int c = 0; c < out_channels; c++)
+    {
+        double scale = (double)input_scale * (double)filter_scales[c] / (double)output_scale;
+        tflite::QuantizeMultiplier(scale, &multipliers[c], &shifts[c]);
+    }
+    tflite::ConvParams op_params = {};
+    op_params.padding_type = tflite::PaddingType::kSame;
+    op_params.padding_values.width = padding.width;
+    op_params.padding_values.height = padding.height;
+    op_params.stride_width = params.stride_width;
+    op_params.stride_height = params.stride_height;
+    op_params.dilation_width_factor = 1;
+    op_params.dilation_height_factor = 1;
+    op_params.input_offset = -input_zero_point;
+    op_params.output_offset = output_zero_point;
+    activation_range(params.activation, output_scale, output_zero_point, &op_params.quantized_activation_min,
+                     &op_params.quantized_activation_max);
+    tflite::reference_integer_ops::ConvPerChannel(
+        op_params, multipliers.data(), shifts.data(), tflite::RuntimeShape(4, input_dims.data()), input,
+        tflite::RuntimeShape(4, filter_dims.data()), filter, tflite::RuntimeShape(1, &out_channels), bias,
+        tflite::RuntimeShape(4, output_dims.data()),
+        expected_output<int8_t>(op_case, element_count(output_dims)));
+    op_case.description = dims_string(input_dims) + " * " + dims_string(filter_dims) + " stride " +
+                          std::to_string(params.stride_height) + "x" + std::to_string(params.stride_width) +
+                          (params.padding == kTfLitePaddingSame ? " same" : " valid") +
+                          activation_name(params.activation);
+}
+
+static void fully_connected_case(OpCase &op_case)
+{
+    int batches = random_int(1, 8);
+    int in_features = random_int(1, 160);
+    int out_features = random_int(1, 72);
+    TfLiteFullyConnectedParams params = {};
+    params.activation = random_activation();
+    params.weights_format = kTfLiteFullyConnectedWeightsFormatDefault;
+    params.quantized_bias_type = kTfLiteInt32;
+    // the 1x1 convolution path of 4D outputs needs a depth of a multiple of 4
+    bool four_d = (in_features % 4 == 0) && (rand() % 2 == 0);
+    params.keep_num_dims = four_d;
+    set_builtin_data(op_case, params);
+    Dims input_dims = four_d ? Dims{1, 1, batches, in_features} : Dims{batches, in_features};
+    Dims filter_dims = {out_features, in_features};
+    Dims output_dims = four_d ? Dims{1, 1, batches, out_features} : Dims{batches, out_features};
+
+    float input_scale = random_scale(0.01f, 0.1f);
+    int input_zero_point = random_int(-128, 127);
+    float filter_scale = random_scale(0.001f, 0.02f);
+    float output_scale = random_scale(0.02f, 0.2f);
+    int output_zero_point = random_int(-128, 127);
+    int8_t *input = add_input<int8_t>(op_case, input_dims, input_scale, input_zero_point);
+    int8_t *filter = add_input<int8_t>(op_case, filter_dims, filter_scale, 0);
+    make_constant(op_case);
+    int32_t *bias = add_input<int32_t>(op_case, {out_features}, input_scale * filter_scale, 0);
+    make_constant(op_case);
+    add_tensor<int8_t>(op_case, output_dims, output_scale, output_zero_point);
+    fill_random(input, element_count(input_dims));
+    fill_random(filter, element_count(filter_dims));
+    for (int c = 0; c < out_features; c++)
+    {
+        bias[c] = random_int(-4096, 4095);
+    }
+
+    // multiplier as GetQuantizedConvolutionMultipler(), the product in float
+    tflite::FullyConnectedParams op_params = {};
+    tflite::QuantizeMultiplier((double)(input_scale * filter_scale) / (double)output_scale,
+                               &op_params.output_multiplier, &op_params.output_shift);
+    op_params.input_offset = -input_zero_point;
+    op_params.weights_offset = 0;
+    op_params.output_offset = output_zero_point;
+    activation_range(params.activation, output_scale, output_zero_point, &op_params.quantized_activation_min,
+                     &op_params.quantized_activation_max);
+    tflite::reference_integer_ops::FullyConnected(
+        op_params, tflite::RuntimeShape(input_dims.size(), input_dims.data()), input,
+        tflite::RuntimeShape(2, filter_dims.data()), filter, tflite::RuntimeShape(1, &out_features), bias,
+        tflite::RuntimeShape(output_dims.size(), output_dims.data()),
+        expected_output<int8_t>(op_case, element_count(output_dims)));
+    op_case.description =
+        dims_string(input_dims) + " * " + dims_string(filter_dims) + activation_name(params.activation);
+}
+
+static void max_pool_case(OpCase &op_case)
+{
+    Dims input_dims = {1, random_int(2, 12), random_int(2, 12), random_int(1, 32)};
+    TfLitePoolParams params = {};
+    params.padding = rand() % 2 ? kTfLitePaddingSame : kTfLitePaddingValid;
+    params.filter_height = random_int(1, std::min(3, input_dims[1]));
+    params.filter_width = random_int(1, std::min(3, input_dims[2]));
+    params.stride_height = random_int(1, 2);
+    params.stride_width = random_int(1, 2);
+    params.activation = random_activation();
+    set_builtin_data(op_case, params);
+    int out_height;
+    int out_width;
+    TfLitePaddingValues padding = tflite::ComputePaddingHeightWidth(
+        params.stride_height, params.stride_width, 1, 1, input_dims[1], input_dims[2], params.filter_height,
+        params.filter_width, params.padding, &out_height, &out_width);
+    Dims output_dims = {1, out_height, out_width, input_dims[3]};
+
+    // pooling keeps the quantization of its input
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    int8_t *input = add_input<int8_t>(op_case, input_dims, scale, zero_point);
+    add_tensor<int8_t>(op_case, output_dims, scale, zero_point);
+    fill_random(input, element_count(input_dims));
+
+    tflite::PoolParams op_params = {};
+    op_params.padding_values.height = padding.height;
+    op_params.padding_values.width = padding.width;
+    op_params.stride_height = params.stride_height;
+    op_params.stride_width = params.stride_width;
+    op_params.filter_height = params.filter_height;
+    op_params.filter_width = params.filter_width;
+    activation_range(params.activation, scale, zero_point, &op_params.quantized_activation_min,
+                     &op_params.quantized_activation_max);
+    tflite::reference_integer_ops::MaxPool(op_params, tflite::RuntimeShape(4, input_dims.data()), input,
+                                           tflite::RuntimeShape(4, output_dims.data()),
+                                           expected_output<int8_t>(op_case, element_count(output_dims)));
+    op_case.description = dims_string(input_dims) + " window " + std::to_string(params.filter_height) + "x" +
+                          std::to_string(params.filter_width) + " stride " + std::to_string(params.stride_height) +
+                          "x" + std::to_string(params.stride_width) +
+                          (params.padding == kTfLitePaddingSame ? " same" : " valid") +
+                          activation_name(params.activation);
+}
+
+// ADD and SUB of int8 tensors; the second input is either of the same shape,
+// a row of channels broadcast over the first, or the first input itself as in
+// the model
+static void add_sub_case(OpCase &op_case, bool subtract)
+{
+    Dims dims = {1, random_int(1, 8), random_int(1, 8), random_int(1, 32)};
+    int shape = rand() % 3;
+    Dims other_dims = shape == 1 ? Dims{1, 1, 1, dims[3]} : dims;
+    TfLiteAddParams params = {};
+    params.activation = random_activation();
+    if (subtract == true)
+    {
+        TfLiteSubParams sub_params = {};
+        sub_params.activation = params.activation;
+        set_builtin_data(op_case, sub_params);
+    }
+    else
+    {
+        set_builtin_data(op_case, params);
+    }
+
+    float scale1 = random_scale(0.01f, 0.1f);
+    int zero_point1 = random_int(-128, 127);
+    float scale2 = shape == 2 ? scale1 : random_scale(0.01f, 0.1f);
+    int zero_point2 = shape == 2 ? zero_point1 : random_int(-128, 127);
+    float output_scale = random_scale(0.02f, 0.2f);
+    int output_zero_point = random_int(-128, 127);
+    int8_t *input1 = add_input<int8_t>(op_case, dims, scale1, zero_point1);
+    int8_t *input2 = input1;
+    if (shape == 2)
+    {
+        op_case.inputs.push_back(0);
+    }
+    else
+    {
+        input2 = add_input<int8_t>(op_case, other_dims, scale2, zero_point2);
+        fill_random(input2, element_count(other_dims));
+    }
+    add_tensor<int8_t>(op_case, dims, output_scale, output_zero_point);
+    fill_random(input1, element_count(dims));
+
+    // as CalculateOpDataAdd() and CalculateOpDataSub(); SUB takes the scale
+    // ratios in float
+    const int left_shift = 20;
+    double real_multiplier1;
+    double real_multiplier2;
+    double real_output_multiplier;
+    if (subtract == true)
+    {
+        const float twice_max_input_scale = 2 * std::max(scale1, scale2);
+        real_multiplier1 = (double)(scale1 / twice_max_input_scale);
+        real_multiplier2 = (double)(scale2 / twice_max_input_scale);
+        real_output_multiplier = (double)(twice_max_input_scale / ((1 << left_shift) * output_scale));
+    }
+    else
+    {
+        const double twice_max_input_scale = 2 * (double)std::max(scale1, scale2);
+        real_multiplier1 = (double)scale1 / twice_max_input_scale;
+        real_multiplier2 = (double)scale2 / twice_max_input_scale;
+        real_output_multiplier = twice_max_input_scale / ((1 << left_shift) * (double)output_scale);
+    }
+    int32_t multiplier1, multiplier2, output_multiplier;
+    int shift1, shift2, output_shift;
+    tflite::QuantizeMultiplierSmallerThanOneExp(real_multiplier1, &multiplier1, &shift1);
+    tflite::QuantizeMultiplierSmallerThanOneExp(real_multiplier2, &multiplier2, &shift2);
+    tflite::QuantizeMultiplierSmallerThanOneExp(real_output_multiplier, &output_multiplier, &output_shift);
+    int32_t activation_min;
+    int32_t activation_max;
+    activation_range(params.activation, output_scale, output_zero_point, &activation_min, &activation_max);
+
+    int count = element_count(dims);
+    int8_t *expected = expected_output<int8_t>(op_case, count);
+    for (int i = 0; i < count; i++)
+    {
+        int32_t a = (input1[i] - zero_point1) * (1 << left_shift);
+        int32_t b = (input2[shape == 1 ? i % dims[3] : i] - zero_point2) * (1 << left_shift);
+        int32_t scaled_a = tflite::MultiplyByQuantizedMultiplierSmallerThanOneExp(a, multiplier1, shift1);
+        int32_t scaled_b = tflite::MultiplyByQuantizedMultiplierSmallerThanOneExp(b, multiplier2, shift2);
+        int32_t raw = subtract ? scaled_a - scaled_b : scaled_a + scaled_b;
+        int32_t output =
+            tflite::MultiplyByQuantizedMultiplierSmallerThanOneExp(raw, output_multiplier, output_shift) +
+            output_zero_point;
+        expected[i] = (int8_t)std::min(activation_max, std::max(activation_min, output));
+    }
+    static const char *shape_names[] = {"", " broadcast", " same input"};
+    op_case.description = dims_string(dims) + shape_names[shape] + activation_name(params.activation);
+}
+
+static void add_case(OpCase &op_case)
+{
+    add_sub_case(op_case, false);
+}
+
+static void sub_case(OpCase &op_case)
+{
+    add_sub_case(op_case, true);
+}
+
+// random 4D shape, batch 1 or 2 and sides up to max_side
+static Dims random_dims(int max_side)
+{
+    return {random_int(1, 2), random_int(1, max_side), random_int(1, max_side), random_int(1, max_side)};
+}
+
+// row-major offset of index in dims
+static int offset(const Dims &dims, const Dims &index)
+{
+    int result = 0;
+    for (size_t d = 0; d < dims.size(); d++)
+    {
+        result = result * dims[d] + index[d];
+    }
+    return result;
+}
+
+// index of the row-major element i in dims
+static Dims unravel(const Dims &dims, int i)
+{
+    Dims index(dims.size());
+    for (int d = dims.size() - 1; d >= 0; d--)
+    {
+        index[d] = i % dims[d];
+        i /= dims[d];
+    }
+    return index;
+}
+
+static void reshape_case(OpCase &op_case)
+{
+    Dims input_dims = random_dims(6);
+    Dims output_dims = rand() % 2 ? Dims{1, element_count(input_dims)}
+                                  : Dims{input_dims[0] * input_dims[1], input_dims[2] * input_dims[3]};
+    // the model reshapes its int32 board as well as int8 activations
+    bool int32 = rand() % 2 == 0;
+    int count = element_count(input_dims);
+    if (int32 == true)
+    {
+        int32_t *input = add_input<int32_t>(op_case, input_dims);
+        for (int i = 0; i < count; i++)
+        {
+            input[i] = rand();
+        }
+    }
+    else
+    {
+        float scale = random_scale(0.01f, 0.1f);
+        int zero_point = random_int(-128, 127);
+        fill_random(add_input<int8_t>(op_case, input_dims, scale, zero_point), count);
+    }
+    int32_t *shape = add_input<int32_t>(op_case, {(int)output_dims.size()});
+    std::copy(output_dims.begin(), output_dims.end(), shape);
+    make_constant(op_case);
+    if (int32 == true)
+    {
+        add_tensor<int32_t>(op_case, output_dims);
+    }
+    else
+    {
+        add_tensor<int8_t>(op_case, output_dims, op_case.tensors[0].params.scale, op_case.tensors[0].params.zero_point);
+    }
+    op_case.expected = op_case.buffers.front();
+    op_case.description = dims_string(input_dims) + " -> " + dims_string(output_dims) + (int32 ? " int32" : " int8");
+}
+
+static void gather_nd_case(OpCase &op_case)
+{
+    // params [rows, channels] gathered by [batch, positions, 1] as in the model,
+    // or [rows, columns, channels] by pairs of indices
+    int depth = random_int(1, 2);
+    Dims params_dims = depth == 1 ? Dims{random_int(1, 12), random_int(1, 16)}
+                                  : Dims{random_int(1, 6), random_int(1, 6), random_int(1, 16)};
+    Dims indices_dims = {random_int(1, 2), random_int(1, 36), depth};
+    Dims output_dims = {indices_dims[0], indices_dims[1], params_dims.back()};
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    int8_t *params = add_input<int8_t>(op_case, params_dims, scale, zero_point);
+    int32_t *indices = add_input<int32_t>(op_case, indices_dims);
+    add_tensor<int8_t>(op_case, output_dims, scale, zero_point);
+    fill_random(params, element_count(params_dims));
+
+    int channels = params_dims.back();
+    int positions = indices_dims[0] * indices_dims[1];
+    int8_t *expected = expected_output<int8_t>(op_case, element_count(output_dims));
+    for (int p = 0; p < positions; p++)
+    {
+        Dims index(params_dims.size(), 0);
+        for (int d = 0; d < depth; d++)
+        {
+            index[d] = random_int(0, params_dims[d] - 1);
+            indices[p * depth + d] = index[d];
+        }
+        memcpy(&expected[p * channels], &params[offset(params_dims, index)], channels);
+    }
+    op_case.description = dims_string(params_dims) + " by " + dims_string(indices_dims);
+}
+
+static void pad_case(OpCase &op_case)
+{
+    Dims input_dims = random_dims(6);
+    Dims output_dims(4);
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    int8_t *input = add_input<int8_t>(op_case, input_dims, scale, zero_point);
+    int32_t *paddings = add_input<int32_t>(op_case, {4, 2});
+    make_constant(op_case);
+    for (int d = 0; d < 4; d++)
+    {
+        // the batch stays, the model pads height and width by one
+        paddings[2 * d] = d == 0 ? 0 : random_int(0, 2);
+        paddings[2 * d + 1] = d == 0 ? 0 : random_int(0, 2);
+        output_dims[d] = input_dims[d] + paddings[2 * d] + paddings[2 * d + 1];
+    }
+    add_tensor<int8_t>(op_case, output_dims, scale, zero_point);
+    fill_random(input, element_count(input_dims));
+
+    int count = element_count(output_dims);
+    int8_t *expected = expected_output<int8_t>(op_case, count);
+    for (int i = 0; i < count; i++)
+    {
+        Dims index = unravel(output_dims, i);
+        bool inside = true;
+        for (int d = 0; d < 4; d++)
+        {
+            index[d] -= paddings[2 * d];
+            inside &= (index[d] >= 0) && (index[d] < input_dims[d]);
+        }
+        // without a constant input PAD fills in the zero point
+        expected[i] = inside ? input[offset(input_dims, index)] : (int8_t)zero_point;
+    }
+    op_case.description = dims_string(input_dims) + " -> " + dims_string(output_dims);
+}
+
+static void slice_case(OpCase &op_case)
+{
+    Dims input_dims = random_dims(8);
+    Dims begin(4);
+    Dims size(4);
+    for (int d = 0; d < 4; d++)
+    {
+        begin[d] = random_int(0, input_dims[d] - 1);
+        size[d] = random_int(1, input_dims[d] - begin[d]);
+    }
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    int8_t *input = add_input<int8_t>(op_case, input_dims, scale, zero_point);
+    std::copy(begin.begin(), begin.end(), add_input<int32_t>(op_case, {4}));
+    make_constant(op_case);
+    std::copy(size.begin(), size.end(), add_input<int32_t>(op_case, {4}));
+    make_constant(op_case);
+    add_tensor<int8_t>(op_case, size, scale, zero_point);
+    fill_random(input, element_count(input_dims));
+
+    int count = element_count(size);
+    int8_t *expected = expected_output<int8_t>(op_case, count);
+    for (int i = 0; i < count; i++)
+    {
+        Dims index = unravel(size, i);
+        for (int d = 0; d < 4; d++)
+        {
+            index[d] += begin[d];
+        }
+        expected[i] = input[offset(input_dims, index)];
+    }
+    op_case.description = dims_string(input_dims) + " at " + dims_string(begin) + " size " + dims_string(size);
+}
+
+static void transpose_case(OpCase &op_case)
+{
+    Dims input_dims = random_dims(8);
+    Dims perm = {0, 1, 2, 3};
+    for (int d = 3; d > 0; d--)
+    {
+        std::swap(perm[d], perm[rand() % (d + 1)]);
+    }
+    Dims output_dims(4);
+    for (int d = 0; d < 4; d++)
+    {
+        output_dims[d] = input_dims[perm[d]];
+    }
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    int8_t *input = add_input<int8_t>(op_case, input_dims, scale, zero_point);
+    std::copy(perm.begin(), perm.end(), add_input<int32_t>(op_case, {4}));
+    make_constant(op_case);
+    add_tensor<int8_t>(op_case, output_dims, scale, zero_point);
+    fill_random(input, element_count(input_dims));
+
+    int count = element_count(output_dims);
+    int8_t *expected = expected_output<int8_t>(op_case, count);
+    for (int i = 0; i < count; i++)
+    {
+        Dims index = unravel(output_dims, i);
+        Dims input_index(4);
+        for (int d = 0; d < 4; d++)
+        {
+            input_index[perm[d]] = index[d];
+        }
+        expected[i] = input[offset(input_dims, input_index)];
+    }
+    op_case.description = dims_string(input_dims) + " perm " + dims_string(perm);
+}
+
+static void concatenation_case(OpCase &op_case)
+{
+    int num_inputs = random_int(2, 3);
+    int axis = random_int(0, 3);
+    Dims dims = random_dims(6);
+    TfLiteConcatenationParams params = {};
+    // negative axes count from the back
+    params.axis = rand() % 2 ? axis : axis - 4;
+    params.activation = kTfLiteActNone;
+    set_builtin_data(op_case, params);
+
+    // int8 CONCATENATION requires one quantization for all tensors
+    float scale = random_scale(0.01f, 0.1f);
+    int zero_point = random_int(-128, 127);
+    std::vector<Dims> input_dims(num_inputs, dims);
+    std::vector<int8_t *> inputs(num_inputs);
+    Dims output_dims = dims;
+    output_dims[axis] = 0;
+    for (int n = 0; n < num_inputs; n++)
+    {
+        input_dims[n][axis] = random_int(1, 6);
+        output_dims[axis] += input_dims[n][axis];
+        inputs[n] = add_input<int8_t>(op_case, input_dims[n], scale, zero_point);
+        fill_random(inputs[n], element_count(input_dims[n]));
+    }
+    add_tensor<int8_t>(op_case, output_dims, scale, zero_point);
+
+    int count = element_count(output_dims);
+    int8_t *expected = expected_output<int8_t>(op_case, count);
+    std::string description;
+    for (int i = 0; i < count; i++)
+    {
+        Dims index = unravel(output_dims, i);
+        int n = 0;
+        while (index[axis] >= input_dims[n][axis])
+        {
+            index[axis] -= input_dims[n][axis];
+            n++;
+        }
+        expected[i] = inputs[n][offset(input_dims[n], index)];
+    }
+    for (int n = 0; n < num_inputs; n++)
+    {
+        op_case.description += (n > 0 ? " + " : "") + dims_string(input_dims[n]);
+    }
+    op_case.description += " axis " + std::to_string(params.axis);
+}
+
+static const Operator operators[] = {
+        {"CONV_2D", tflite::Register_CONV_2D(), conv_case, true},
+        {"FULLY_CONNECTED", tflite::Register_FULLY_CONNECTED(), fully_connected_case, true},
+        {"MAX_POOL_2D", tflite::Register_MAX_POOL_2D(), max_pool_case, true},
+        {"ADD", tflite::Register_ADD(), add_case, true},
+        {"SUB", tflite::Register_SUB(), sub_case, false},
+        {"RESHAPE", tflite::Register_RESHAPE(), reshape_case, false},
+        {"GATHER_ND", tflite::Register_GATHER_ND(), gather_nd_case, false},
+        {"PAD", tflite::Register_PAD(), pad_case, false},
+        {"SLICE", tflite::Register_SLICE(), slice_case, false},
+        {"TRANSPOSE", tflite::Register_TRANSPOSE(), transpose_case, false},
+        {"CONCATENATION", tflite::Register_CONCATENATION(), concatenation_case, false},
+    };
+
+// Runs one case on a variant, compares the output with the expected one and
+// adds the time of timed_invokes more invocations. false if the kernel failed
+// or differs.
+static bool run_case(const Operator &op, OpCase &op_case, const Variant &variant, tflite::MicroWorkerPool *pool,
+                     uint32_t timed_invokes, double *seconds)
+{
+#ifdef ARM_NN_X86_SIMD
+    arm_nn_x86_set_level(variant.x86_level);
+#endif
+    TfLiteTensor &output = op_case.tensors.back();
+    memset(output.data.raw, 0x55, output.bytes);
+    Dims outputs = {(int)op_case.tensors.size() - 1};
+    tflite::micro::KernelRunner runner(op.registration, op_case.tensors.data(), op_case.tensors.size(),
+                                       int_array(op_case, op_case.inputs), int_array(op_case, outputs),
+                                       op_case.builtin_data.empty() ? nullptr : op_case.builtin_data.data());
+    if (variant.pool == true)
+    {
+        runner.SetWorkerPool(pool);
+    }
+    if ((runner.InitAndPrepare() != kTfLiteOk) || (runner.Invoke() != kTfLiteOk))
+    {
+        printf("  %s %s: kernel failed\n", variant.name, op_case.description.c_str());
+        return false;
+    }
+    if (memcmp(output.data.raw, op_case.expected.data(), output.bytes) != 0)
+    {
+        size_t first = 0;
+        while (output.data.raw[first] == (char)op_case.expected[first])
+        {
+            first++;
+        }
+        printf("  %s %s: MISMATCH at byte %zu\n", variant.name, op_case.description.c_str(), first);
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < timed_invokes; i++)
+    {
+        runner.Invoke();
+    }
+    *seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t cases = argc > 1 ? atoi(argv[1]) : 200;
+    uint32_t timed_invokes = argc > 2 ? atoi(argv[2]) : 100;
+    uint32_t seed = argc > 3 ? atoi(argv[3]) : 1;
+
+    std::vector<Variant> variants = {{"C", 0, false}};
+#ifdef ARM_NN_X86_SIMD
+    static const char *level_names[] = {"C", "SSE4.1", "AVX2"};
+    int32_t best_level = arm_nn_x86_level();
+    for (int32_t level = ARM_NN_X86_SSE41; level <= best_level; level++)
+    {
+        variants.push_back({level_names[level], level, false});
+    }
+#else
+    int32_t best_level = 0;
+#endif
+    variants.push_back({"2 threads", best_level, true});
+    // splits every operator the kernels can split, down to one element a thread
+    HostWorkerPool pool(KERNELCHECK_THREADS, 1);
+
+    int failures = 0;
+    for (const Operator &op : operators)
+    {
+        srand(seed);
+        size_t num_variants = op.optimized ? variants.size() : 1;
+        std::vector<double> seconds(num_variants, 0.0);
+        uint64_t elements = 0;
+        int op_failures = 0;
+        for (uint32_t c = 0; c < cases; c++)
+        {
+            OpCase op_case;
+            op.make_case(op_case);
+            elements += op_case.tensors.back().bytes / tflite::TfLiteTypeGetSize(op_case.tensors.back().type);
+            for (size_t v = 0; v < num_variants; v++)
+            {
+                op_failures += run_case(op, op_case, variants[v], &pool, timed_invokes, &seconds[v]) ? 0 : 1;
+            }
+        }
+        printf("%-16s %4u cases %s", op.name, cases, op_failures == 0 ? "bit-exact " : "FAILED    ");
+        for (size_t v = 0; v < num_variants; v++)
+        {
+            printf("  %s %.2f ns/element", variants[v].name, 1e9 * seconds[v] / ((double)elements * timed_invokes));
+        }
+        printf("\n");
+        failures += op_failures;
+    }
+#ifdef ARM_NN_X86_SIMD
+    arm_nn_x86_set_level(-1);
+#endif
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,287 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: builds and inspects the model store image that picotool writes
+// below the settings store (MODEL_STORE_FLASH_OFFSET in main.cpp). The image
+// file is memory mapped and the models run in place from it, as the firmware
+// runs them from the XIP flash.
+//
+//   add:    installs a .tflite file as the next version of a role (or the
+//           given one), after checking the flatbuffer and the operators
+//   list:   slot headers, blob CRCs and the model the firmware would select
+//   reject: marks a slot as the firmware does with a damaged model
+//   bench:  swaps every usable model into one arena and reports the load
+//           time, the time per hint and the hints that match the linked model
+//
+//   modelimage <image> add <model.tflite> [hint|small] [version]
+//   modelimage <image> list
+//   modelimage <image> reject <slot>
+//   modelimage <image> bench [boards]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "file_flash.h"
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+#include "model_store.h"
+#include "tensorflow/lite/schema/schema_generated.h"
+
+// PICO_FLASH_SIZE_BYTES of the board, the image address follows from it
+#define MODELIMAGE_FLASH_SIZE (16 * 1024 * 1024)
+#define MODELIMAGE_XIP_BASE 0x10000000u
+#define MODELIMAGE_ARENA_SIZE (32 * 1024)
+
+static const char *role_name(uint8_t role)
+{
+    return role == MODEL_ROLE_SMALL ? "small" : "hint";
+}
+
+static bool read_file(const char *path, std::vector<uint8_t> &bytes)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        perror(path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    bytes.resize(ftell(file));
+    fseek(file, 0, SEEK_SET);
+    bool read = fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    fclose(file);
+    if (read == false)
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+    }
+    return read;
+}
+
+// the device rejects a blob that fails these checks at boot, catch it before writing
+static bool check_model(const char *path, const std::vector<uint8_t> &bytes)
+{
+    flatbuffers::Verifier verifier(bytes.data(), bytes.size());
+    if (tflite::VerifyModelBuffer(verifier) == false)
+    {
+        fprintf(stderr, "%s: not a valid .tflite flatbuffer\n", path);
+        return false;
+    }
+    const tflite::Model *model = tflite::GetModel(bytes.data());
+    if (model->version() != TFLITE_SCHEMA_VERSION)
+    {
+        fprintf(stderr, "%s: schema version %u, expected %d\n", path, model->version(), TFLITE_SCHEMA_VERSION);
+        return false;
+    }
+    return true;
+}
+
+static int add(ModelStore &models, int argc, char **argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: modelimage <image> add <model.tflite> [hint|small] [version]\n");
+        return 1;
+    }
+    std::vector<uint8_t> bytes;
+    if ((read_file(argv[3], bytes) == false) || (check_model(argv[3], bytes) == false))
+    {
+        return 1;
+    }
+    uint8_t role = (argc > 4) && (strcmp(argv[4], "small") == 0) ? MODEL_ROLE_SMALL : MODEL_ROLE_HINT;
+    uint32_t version = argc > 5 ? strtoul(argv[5], nullptr, 0) : models.newest_version(role) + 1;
+
+    // loads with the firmware's operators, the arena size is checked on the device
+    alignas(16) static uint8_t arena[MODELIMAGE_ARENA_SIZE];
+    std::vector<uint8_t> aligned(bytes.size() + 16);
+    unsigned char *copy = (unsigned char *)(((uintptr_t)aligned.data() + 15) & ~(uintptr_t)15);
+    memcpy(copy, bytes.data(), bytes.size());
+    Inference inference = Inference(copy, arena, sizeof(arena));
+    if (inference.init() == false)
+    {
+        fprintf(stderr, "%s: does not load with the firmware's operators\n", argv[3]);
+        return 1;
+    }
+    inference.release();
+
+    // file name without directory and extension
+    const char *name = strrchr(argv[3], '/') != nullptr ? strrchr(argv[3], '/') + 1 : argv[3];
+    char stem[MODEL_NAME_LEN + 1] = {};
+    strncpy(stem, name, MODEL_NAME_LEN);
+    if (strchr(stem, '.') != nullptr)
+    {
+        *strchr(stem, '.') = 0;
+    }
+    int8_t slot = models.install(role, version, bytes.data(), bytes.size(), stem);
+    if (slot < 0)
+    {
+        fprintf(stderr, "%s: %zu bytes, no free slot or larger than %d bytes\n", argv[3], bytes.size(),
+                MODEL_MAX_BYTES);
+        return 1;
+    }
+    uint32_t address = MODELIMAGE_XIP_BASE + MODELIMAGE_FLASH_SIZE - STORE_SECTORS * STORE_SECTOR_SIZE -
+                       MODEL_STORE_BYTES;
+    printf("%s model %s version %u in slot %d, write the image with\n  picotool load %s -t bin -o 0x%08x\n",
+           role_name(role), stem, version, slot, argv[1], address);
+    return 0;
+}
+
+static int list(ModelStore &models)
+{
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        if (models.usable(slot) == false)
+        {
+            const ModelSlotHeader *header = models.header(slot);
+            bool rejected = (header->magic != 0xFFFFFFFFu) && (header->state != 0xFFFFFFFFu);
+            printf("slot %u: %s\n", slot, rejected ? "rejected" : "unused");
+            continue;
+        }
+        const ModelSlotHeader *header = models.header(slot);
+        printf("slot %u: %-5s %-16.*s version %-4u %6u bytes, CRC %08x %s%s\n", slot, role_name(header->role),
+               MODEL_NAME_LEN, header->name, header->version, header->length, header->crc,
+               models.verify(slot) ? "ok" : "DAMAGED", models.select(header->role) == slot ? ", active" : "");
+    }
+    return 0;
+}
+
+static int reject(ModelStore &models, int argc, char **argv)
+{
+    uint8_t slot = argc > 3 ? atoi(argv[3]) : MODEL_STORE_SLOTS;
+    if (models.usable(slot) == false)
+    {
+        fprintf(stderr, "slot %u holds no usable model\n", slot);
+        return 1;
+    }
+    models.reject(slot);
+    return 0;
+}
+
+// hint of every board with the model in the inference's arena, and the time per hint
+static double score(Inference &inference, const std::vector<Game> &boards, std::vector<uint8_t> &hints)
+{
+    int8_t scores[NUM_SWITCHES];
+    hints.clear();
+    auto start = std::chrono::steady_clock::now();
+    for (const Game &game : boards)
+    {
+        if (inference.score_board(game.maze, scores) == false)
+        {
+            return -1;
+        }
+        hints.push_back(select_hint(scores, -1));
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return 1e6 * seconds / boards.size();
+}
+
+static int bench(ModelStore &models, int argc, char **argv)
+{
+    uint32_t num_boards = argc > 3 ? atoi(argv[3]) : 5000;
+    std::vector<Game> boards(num_boards);
+    for (Game &game : boards)
+    {
+        game.init();
+        for (uint8_t m = 0; m < 20; m++)
+        {
+            game.toggle_switch(rand() % NUM_SWITCHES);
+        }
+    }
+
+    // one arena for all models, set_model() swaps them as in the firmware
+    alignas(16) static uint8_t arena[MODELIMAGE_ARENA_SIZE];
+    Inference inference = Inference(COLORDOT_MODEL, arena, sizeof(arena));
+    std::vector<uint8_t> linked_hints;
+    std::vector<uint8_t> hints;
+    if (inference.init() == false)
+    {
+        return 1;
+    }
+    double us = score(inference, boards, linked_hints);
+    printf("linked             %8.1f us/hint\n", us);
+
+    for (uint8_t slot = 0; slot < MODEL_STORE_SLOTS; slot++)
+    {
+        if (models.usable(slot) == false)
+        {
+            continue;
+        }
+        const ModelSlotHeader *header = models.header(slot);
+        auto start = std::chrono::steady_clock::now();
+        inference.set_model(models.model(slot));
+        bool loaded = inference.init();
+        double load_us = 1e6 * std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (loaded == false)
+        {
+            printf("slot %u: %-16.*s does not load\n", slot, MODEL_NAME_LEN, header->name);
+            continue;
+        }
+        us = score(inference, boards, hints);
+        uint32_t same = 0;
+        for (uint32_t b = 0; b < num_boards; b++)
+        {
+            same += hints[b] == linked_hints[b];
+        }
+        printf("slot %u: %-5s %-16.*s version %-4u %8.1f us/hint, loaded in %.1f us, arena %zu bytes, "
+               "%.2f%% hints as linked\n",
+               slot, role_name(header->role), MODEL_NAME_LEN, header->name, header->version, us, load_us,
+               inference.arena_used_bytes(), 100.0 * same / num_boards);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: modelimage <image> add <model.tflite> [hint|small] [version]\n"
+                        "       modelimage <image> list\n"
+                        "       modelimage <image> reject <slot>\n"
+                        "       modelimage <image> bench [boards]\n");
+        return 1;
+    }
+    FileFlash flash(argv[1], MODEL_STORE_BYTES);
+    if (flash.mapped() == false)
+    {
+        return 1;
+    }
+    ModelStore models(flash);
+    models.mount();
+    if (strcmp(argv[2], "add") == 0)
+    {
+        return add(models, argc, argv);
+    }
+    if (strcmp(argv[2], "list") == 0)
+    {
+        return list(models);
+    }
+    if (strcmp(argv[2], "reject") == 0)
+    {
+        return reject(models, argc, argv);
+    }
+    if (strcmp(argv[2], "bench") == 0)
+    {
+        return bench(models, argc, argv);
+    }
+    fprintf(stderr, "unknown command %s\n", argv[2]);
+    return 1;
+}
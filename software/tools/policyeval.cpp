@@ -0,0 +1,452 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+// Host tool: plays the model's greedy hints, picked by select_hint() with the
+// last hint excluded as in the firmware, from every board of a tools/datagen
+// dataset until the board is solved or max moves are played. Reports per
+// difficulty level the solve rate, the mean moves of the solved boards and
+// their gap to the optimum (boards with an exact label), the mean hint
+// latency and the inferences per second. Every thread runs its own
+// interpreter over the shared model.
+//
+// With a small model the hints come from a ModelCascade as it would run on
+// the device: the small model takes boards up to max distance moves from the
+// solution (lower bound) and keeps its hint when it leads by min margin,
+// the full model answers the rest, both in one arena. The time per hint
+// stands in for the energy per hint, the device runs at a fixed clock.
+//
+// Before the model is judged, the rollout is checked against the exact
+// search: the Solver and the hint cache have to undo every single move of the
+// solved board, and their optimal moves, played by the same rollout, have to
+// solve the first exactly labelled boards of every level in their labelled
+// number of moves. The model's first hint on every board within the hint cache
+// depth is compared with its optimal moves. Exits with 1 if the rollout check fails.
+//
+//   policyeval <dataset> [threads] [max moves] [boards] [small model] [max distance] [min margin]
+
+#include <sys/mman.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "board.h"
+#include "dataset.h"
+#include "game.h"
+#include "hint_cache.h"
+#include "inference.h"
+#include "model_data.h"
+#include "solver.h"
+
+#define NUM_LEVELS 8
+#define EVAL_ARENA_SIZE (32 * 1024)
+#define EVAL_BATCH 64 // boards taken from the work queue at once
+#define CHECK_BOARDS 8 // exactly labelled boards per level played with the optimal moves
+#define CHECK_SOLVER_SLICE 100000
+
+struct Sample
+{
+    PackedBoard board;
+    uint8_t level;
+    uint8_t depth;
+    bool exact;
+};
+
+struct LevelStats
+{
+    uint64_t boards = 0;
+    uint64_t solved = 0;
+    uint64_t moves = 0; // of the solved boards
+    uint64_t exact_solved = 0;
+    uint64_t gap = 0; // moves above the optimum of the exactly labelled solved boards
+    uint64_t inferences = 0;
+    uint64_t hint_ns = 0;
+    uint64_t small_hints = 0; // answered by the first stage of a two stage cascade
+};
+
+// all samples of the dataset, level by level in file order
+static bool load_samples(const char *path, std::vector<Sample> &samples)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        perror(path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    const uint8_t *data = (const uint8_t *)mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    fclose(file);
+    if (data == MAP_FAILED)
+    {
+        perror("mmap");
+        return false;
+    }
+    const DatasetHeader *header = (const DatasetHeader *)data;
+    if ((header->magic != DATASET_MAGIC) || (header->version != DATASET_VERSION))
+    {
+        fprintf(stderr, "%s: not a dataset of version %d\n", path, DATASET_VERSION);
+        munmap((void *)data, size);
+        return false;
+    }
+    const DatasetChunk *index = (const DatasetChunk *)(data + header->index_offset);
+    for (uint8_t level = 0; level < NUM_LEVELS; level++)
+    {
+        for (uint32_t c = 0; c < header->chunks; c++)
+        {
+            const DatasetChunk &chunk = index[c];
+            if (chunk.level != level)
+            {
+                continue;
+            }
+            const PackedBoard *boards = (const PackedBoard *)(data + chunk.offset);
+            const uint8_t *depths = data + chunk.offset + dataset_depths_offset(chunk.count);
+            const uint8_t *flags = data + chunk.offset + dataset_flags_offset(chunk.count);
+            for (uint32_t i = 0; i < chunk.count; i++)
+            {
+                samples.push_back({boards[i], level, depths[i], (flags[i] & DATASET_EXACT) != 0});
+            }
+        }
+    }
+    munmap((void *)data, size);
+    return true;
+}
+
+// a .tflite file, 16 byte aligned like the model arrays
+static const unsigned char *load_model(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr)
+    {
+        perror(path);
+        return nullptr;
+    }
+    fseek(file, 0, SEEK_END);
+    size_t size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char *data = (unsigned char *)aligned_alloc(16, (size + 15) & ~(size_t)15);
+    if ((data == nullptr) || (fread(data, 1, size, file) != size))
+    {
+        fprintf(stderr, "%s: read failed\n", path);
+        fclose(file);
+        return nullptr;
+    }
+    fclose(file);
+    return data;
+}
+
+// follows the hints like a player would, next_hint(game, last_hint_switch)
+// gives the switch to move or -1, returns the moves or -1 if unsolved
+template <typename NextHint>
+static int32_t play(Game &game, const PackedBoard &start, uint32_t max_moves, NextHint next_hint)
+{
+    Board maze;
+    unpack_board(start, maze);
+    game.load(maze);
+    int8_t last_hint_switch = -1;
+    for (uint32_t moves = 0; moves < max_moves; moves++)
+    {
+        if (game.check_finish() == true)
+        {
+            return moves;
+        }
+        last_hint_switch = next_hint(game, last_hint_switch);
+        if (last_hint_switch < 0)
+        {
+            return -1;
+        }
+        game.toggle_switch(last_hint_switch);
+    }
+    return game.check_finish() == true ? (int32_t)max_moves : -1;
+}
+
+// hint of the model, timed into the stats of the board's level
+static int8_t model_hint(ModelCascade &cascade, Game &game, int8_t last_hint_switch, LevelStats &level)
+{
+    int8_t scores[NUM_SWITCHES];
+    auto hint_start = std::chrono::steady_clock::now();
+    if (cascade.score_board(game.maze, scores, last_hint_switch) == false)
+    {
+        return -1;
+    }
+    std::chrono::duration<double, std::nano> hint_time = std::chrono::steady_clock::now() - hint_start;
+    level.hint_ns += hint_time.count();
+    level.inferences++;
+    level.small_hints += cascade.last_stage() == 0;
+    return select_hint(scores, last_hint_switch);
+}
+
+// optimal move of the exact search, -1 if it gives up
+static int8_t solver_hint(Solver &solver, const Board maze)
+{
+    solver.start(maze);
+    while (solver.search(CHECK_SOLVER_SLICE) == SOLVER_SEARCHING)
+    {
+    }
+    return solver.status() == SOLVER_SOLVED ? solver.best_switch() : -1;
+}
+
+// Plays the optimal moves through play() and compares the model's first hint
+// on every board within the hint cache depth with them, see the top of the
+// file. Returns false if the rollout, the
+// switch mapping or a label disagrees with the exact search.
+static bool check_rollout(const std::vector<Sample> &samples, ModelCascade &cascade)
+{
+    HintCache cache(hint_cache_table);
+    Solver solver(cache);
+    bool ok = true;
+
+    // every switch undoes its own move on the solved board
+    for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
+    {
+        Game moved = Game();
+        moved.toggle_switch(sw);
+        int8_t cached = cache.lookup(moved.maze);
+        int8_t searched = solver_hint(solver, moved.maze);
+        if ((cached != sw) || (searched != sw))
+        {
+            fprintf(stderr, "switch %u moved on the solved board: hint cache %d, solver %d\n", sw, cached, searched);
+            ok = false;
+        }
+    }
+
+    Game game = Game();
+    uint32_t checked[NUM_LEVELS] = {};
+    uint32_t solved = 0;
+    uint32_t near = 0;          // boards within the hint cache depth
+    uint32_t optimal_hints = 0; // of those, first hints of the model that are optimal
+    uint32_t optimal_moves = 0; // of those, optimal first moves over all switches
+    for (const Sample &sample : samples)
+    {
+        if ((sample.exact == true) && (checked[sample.level] < CHECK_BOARDS))
+        {
+            checked[sample.level]++;
+            int32_t moves = play(game, sample.board, sample.depth + 1,
+                                 [&](Game &current, int8_t) { return solver_hint(solver, current.maze); });
+            if (moves != sample.depth)
+            {
+                fprintf(stderr, "level %u board labelled %u moves: the optimal moves solve it in %d\n", sample.level,
+                        sample.depth, moves);
+                ok = false;
+            }
+            solved += moves == sample.depth;
+        }
+
+        Board maze;
+        unpack_board(sample.board, maze);
+        int8_t distance = cache.distance(maze);
+        int8_t scores[NUM_SWITCHES];
+        if ((distance <= 0) || (cascade.score_board(maze, scores) == false))
+        {
+            continue;
+        }
+        uint8_t hint = select_hint(scores, -1);
+        near++;
+        for (uint8_t sw = 0; sw < NUM_SWITCHES; sw++)
+        {
+            Game child = Game();
+            child.load(maze);
+            child.toggle_switch(sw);
+            if (cache.distance(child.maze) == distance - 1)
+            {
+                optimal_moves++;
+                optimal_hints += sw == hint;
+            }
+        }
+    }
+    printf("rollout check: the optimal moves solve %u labelled boards in their depth, the model's first hint is "
+           "optimal on %u of %u boards within %u moves (%.1f%% for a random switch)\n",
+           solved, optimal_hints, near, cache.depth(), near > 0 ? 100.0 * optimal_moves / (near * NUM_SWITCHES) : 0.0);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <dataset> [threads] [max moves] [boards] [small model] [max distance] [min margin]\n",
+                argv[0]);
+        return 1;
+    }
+    uint32_t threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+    uint32_t max_moves = argc > 3 ? atoi(argv[3]) : 100;
+    threads = threads > 0 ? threads : 1;
+    const unsigned char *small_model = nullptr;
+    if (argc > 5)
+    {
+        small_model = load_model(argv[5]);
+        if (small_model == nullptr)
+        {
+            return 1;
+        }
+    }
+    uint8_t max_distance = argc > 6 ? atoi(argv[6]) : 4;
+    int16_t min_margin = argc > 7 ? atoi(argv[7]) : 0;
+
+    std::vector<Sample> samples;
+    if (load_samples(argv[1], samples) == false)
+    {
+        return 1;
+    }
+    if ((argc > 4) && (atoi(argv[4]) > 0) && ((size_t)atoi(argv[4]) < samples.size()))
+    {
+        // every level keeps its share
+        std::vector<Sample> subset;
+        size_t boards = atoi(argv[4]);
+        for (size_t i = 0; i < boards; i++)
+        {
+            subset.push_back(samples[i * samples.size() / boards]);
+        }
+        samples.swap(subset);
+    }
+
+    // the resolver is shared, so the interpreters are set up one after the other
+    std::vector<std::unique_ptr<uint8_t[]>> arenas;
+    std::vector<std::unique_ptr<ModelCascade>> cascades;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        arenas.emplace_back(new uint8_t[EVAL_ARENA_SIZE]);
+        cascades.emplace_back(new ModelCascade(arenas[t].get(), EVAL_ARENA_SIZE));
+        if (small_model != nullptr)
+        {
+            cascades[t]->add_stage(small_model, max_distance, min_margin);
+        }
+        cascades[t]->add_stage(COLORDOT_MODEL);
+        Game solved = Game();
+        int8_t scores[NUM_SWITCHES];
+        if (cascades[t]->score_board(solved.maze, scores) == false)
+        {
+            return 1;
+        }
+    }
+    if (check_rollout(samples, *cascades[0]) == false)
+    {
+        return 1;
+    }
+
+    std::vector<LevelStats> thread_stats(threads * NUM_LEVELS);
+    std::atomic<size_t> next_sample{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&, t]()
+                             {
+            Game game = Game();
+            LevelStats *stats = &thread_stats[t * NUM_LEVELS];
+            size_t first;
+            while ((first = next_sample.fetch_add(EVAL_BATCH)) < samples.size())
+            {
+                for (size_t i = first; (i < first + EVAL_BATCH) && (i < samples.size()); i++)
+                {
+                    const Sample &sample = samples[i];
+                    LevelStats &level = stats[sample.level];
+                    int32_t moves = play(game, sample.board, max_moves, [&](Game &current, int8_t last_hint_switch)
+                                         { return model_hint(*cascades[t], current, last_hint_switch, level); });
+                    level.boards++;
+                    if (moves < 0)
+                    {
+                        continue;
+                    }
+                    level.solved++;
+                    level.moves += moves;
+                    if (sample.exact == true)
+                    {
+                        level.exact_solved++;
+                        level.gap += moves - sample.depth;
+                    }
+                }
+            } });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    LevelStats total;
+    printf("level  boards  solved  mean moves  optimality gap  hint us%s\n", small_model != nullptr ? "  small model" : "");
+    for (uint8_t level = 0; level < NUM_LEVELS; level++)
+    {
+        LevelStats sum;
+        for (uint32_t t = 0; t < threads; t++)
+        {
+            const LevelStats &stats = thread_stats[t * NUM_LEVELS + level];
+            sum.boards += stats.boards;
+            sum.solved += stats.solved;
+            sum.moves += stats.moves;
+            sum.exact_solved += stats.exact_solved;
+            sum.gap += stats.gap;
+            sum.inferences += stats.inferences;
+            sum.hint_ns += stats.hint_ns;
+            sum.small_hints += stats.small_hints;
+        }
+        if (sum.boards == 0)
+        {
+            continue;
+        }
+        printf("%5u  %6lu  %5.1f%%  %10.2f  %14.2f  %7.2f", level, (unsigned long)sum.boards,
+               100.0 * sum.solved / sum.boards, sum.solved > 0 ? (double)sum.moves / sum.solved : 0.0,
+               sum.exact_solved > 0 ? (double)sum.gap / sum.exact_solved : 0.0,
+               sum.inferences > 0 ? sum.hint_ns / 1e3 / sum.inferences : 0.0);
+        if (small_model != nullptr)
+        {
+            printf("  %10.1f%%", sum.inferences > 0 ? 100.0 * sum.small_hints / sum.inferences : 0.0);
+        }
+        printf("\n");
+        total.boards += sum.boards;
+        total.solved += sum.solved;
+        total.moves += sum.moves;
+        total.exact_solved += sum.exact_solved;
+        total.gap += sum.gap;
+        total.inferences += sum.inferences;
+        total.hint_ns += sum.hint_ns;
+        total.small_hints += sum.small_hints;
+    }
+    if (total.boards == 0)
+    {
+        fprintf(stderr, "%s: no samples\n", argv[1]);
+        return 1;
+    }
+    printf("%lu boards, %.1f%% solved within %u moves, mean %.2f moves, mean gap %.2f moves (%lu exact labels)\n",
+           (unsigned long)total.boards, 100.0 * total.solved / total.boards, max_moves,
+           total.solved > 0 ? (double)total.moves / total.solved : 0.0,
+           total.exact_solved > 0 ? (double)total.gap / total.exact_solved : 0.0, (unsigned long)total.exact_solved);
+    printf("%lu inferences in %.2f s on %u threads: %.0f inferences/s, %.0f inferences/s per thread\n",
+           (unsigned long)total.inferences, seconds, threads, total.inferences / seconds,
+           total.inferences / seconds / threads);
+    uint64_t loads = 0;
+    for (uint32_t t = 0; t < threads; t++)
+    {
+        loads += cascades[t]->loads();
+    }
+    printf("mean hint latency %.2f us", total.hint_ns / 1e3 / total.inferences);
+    if (small_model != nullptr)
+    {
+        printf(", %.1f%% of the hints from the small model, %lu model loads", 100.0 * total.small_hints / total.inferences,
+               (unsigned long)loads);
+    }
+    printf("\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: runs the model with its operators split over a HostWorkerPool
+// of 1 to max threads and checks the logits against the single-threaded
+// interpreter. Every pool splits down to one multiply-accumulate per worker,
+// so every split the kernels support is exercised, and reports the
+// inferences per second next to those of the default split threshold.
+//
+//   poolbench [max threads] [boards]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "game.h"
+#include "host_worker_pool.h"
+#include "inference.h"
+#include "model_data.h"
+
+#define POOLBENCH_ARENA_SIZE (32 * 1024)
+
+typedef int8_t Scores[NUM_SWITCHES];
+
+// inferences per second over all boards, the logits go to scores
+static double run(tflite::MicroWorkerPool *pool, const std::vector<Board> &boards, std::vector<Scores> &scores)
+{
+    alignas(16) static uint8_t arena[POOLBENCH_ARENA_SIZE];
+    Inference inference = Inference(COLORDOT_MODEL, arena, sizeof(arena));
+    inference.set_worker_pool(pool);
+    if (inference.init() == false)
+    {
+        exit(1);
+    }
+    auto start = std::chrono::steady_clock::now();
+    if (inference.score_boards(boards.data(), boards.size(), scores.data()) == false)
+    {
+        exit(1);
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return boards.size() / seconds;
+}
+
+int main(int argc, char **argv)
+{
+    int max_threads = argc > 1 ? atoi(argv[1]) : std::thread::hardware_concurrency();
+    uint32_t num_boards = argc > 2 ? atoi(argv[2]) : 20000;
+    max_threads = max_threads > INFERENCE_WORKERS ? max_threads : INFERENCE_WORKERS;
+
+    std::vector<Board> boards(num_boards);
+    Game game = Game();
+    for (uint32_t b = 0; b < num_boards; b++)
+    {
+        game.init();
+        for (uint8_t i = 0; i < 1 + b % 20; i++)
+        {
+            game.toggle_switch(rand() % NUM_SWITCHES);
+        }
+        memcpy(boards[b], game.maze, sizeof(Board));
+    }
+
+    std::vector<Scores> expected(num_boards);
+    std::vector<Scores> scores(num_boards);
+    double serial = run(nullptr, boards, expected);
+    printf("%u boards on %u hardware threads, no pool: %.0f inferences/s\n", num_boards,
+           std::thread::hardware_concurrency(), serial);
+
+    int failures = 0;
+    for (int threads = 1; threads <= max_threads; threads++)
+    {
+        std::unique_ptr<HostWorkerPool> split(new HostWorkerPool(threads, 1));
+        double split_rate = run(split.get(), boards, scores);
+        bool exact = memcmp(scores.data(), expected.data(), num_boards * sizeof(Scores)) == 0;
+        failures += exact ? 0 : 1;
+
+        std::unique_ptr<HostWorkerPool> pool(new HostWorkerPool(threads));
+        double rate = run(pool.get(), boards, scores);
+        bool pool_exact = memcmp(scores.data(), expected.data(), num_boards * sizeof(Scores)) == 0;
+        failures += pool_exact ? 0 : 1;
+
+        printf("%2d threads: every op split %8.0f inferences/s %5.2fx %s, default threshold %8.0f inferences/s "
+               "%5.2fx %s\n",
+               threads, split_rate, split_rate / serial, exact ? "bit-exact" : "MISMATCH", rate, rate / serial,
+               pool_exact ? "bit-exact" : "MISMATCH");
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef RAM_FLASH_H
+#define RAM_FLASH_H
+
+#include <cstring>
+#include <vector>
+
+#include "store.h"
+
+// Host stand-in for the flash of the settings and model stores: programming
+// only clears bits, erases are counted per sector, and a power loss can be
+// simulated after a number of programmed bytes.
+class RamFlash : public FlashDriver
+{
+public:
+  std::vector<uint8_t> memory;
+  std::vector<uint32_t> erases;
+  uint32_t programmed_bytes = 0;
+  // bytes programmed before the power fails, negative: never
+  int64_t power_fails_after = -1;
+
+  RamFlash(uint32_t sectors = STORE_SECTORS) : memory(sectors * STORE_SECTOR_SIZE, 0xFF), erases(sectors, 0)
+  {
+  }
+
+  bool powered()
+  {
+    return this->power_fails_after != 0;
+  }
+
+  const uint8_t *data(uint32_t offset) override
+  {
+    return this->memory.data() + offset;
+  }
+
+  void program(uint32_t offset, const uint8_t *bytes, size_t len) override
+  {
+    for (size_t i = 0; (i < len) && (this->powered() == true); i++)
+    {
+      this->memory[offset + i] &= bytes[i];
+      this->programmed_bytes++;
+      if (this->power_fails_after > 0)
+      {
+        this->power_fails_after--;
+      }
+    }
+  }
+
+  void erase(uint32_t offset) override
+  {
+    if (this->powered() == true)
+    {
+      memset(this->memory.data() + offset, 0xFF, STORE_SECTOR_SIZE);
+      this->erases[offset / STORE_SECTOR_SIZE]++;
+    }
+  }
+};
+
+#endif // RAM_FLASH_H
@@ -0,0 +1,117 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: measures the renderer. Reports the encode time of a changed
+// and an unchanged frame, and replays the main loop on a virtual clock (10 ms
+// ticks, finish sweep running, a hint every 2 s and a move every 3 s) to
+// count how many of the redraws actually send the chain.
+//
+//   renderbench [seconds]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "animation.h"
+#include "game.h"
+#include "renderer.h"
+
+#define RENDERBENCH_ENCODES 1000000
+
+static double encode_us(Renderer &renderer, const Board a, const Board b)
+{
+    uint32_t changed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < RENDERBENCH_ENCODES; i++)
+    {
+        changed += renderer.render((i & 1) ? a : b) != 0;
+        renderer.take_words();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // keeps the loop from being optimized away
+    if (changed == RENDERBENCH_ENCODES + 1)
+    {
+        printf("\n");
+    }
+    return 1e6 * seconds / RENDERBENCH_ENCODES;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = argc > 1 ? atoi(argv[1]) : 60;
+
+    Game game = Game();
+    Renderer renderer = Renderer();
+    for (uint8_t i = 0; i < NUM_COLOURS; i++)
+    {
+        renderer.set_palette(i, 0x010101 * i);
+    }
+    Board solved;
+    Board moved;
+    Board dark = {};
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        solved[i / 6][i % 6] = game.maze[i / 6][i % 6];
+    }
+    game.toggle_switch(0);
+    for (uint8_t i = 0; i < 36; i++)
+    {
+        moved[i / 6][i % 6] = game.maze[i / 6][i % 6];
+    }
+    printf("encode: %.3f us all pixels changed, %.3f us one row changed, %.3f us unchanged\n",
+           encode_us(renderer, solved, dark), encode_us(renderer, solved, moved), encode_us(renderer, solved, solved));
+
+    // main loop replay, update_display() redraws and pushes
+    Animator animator = Animator();
+    Keyframe hint[] = {{250, ROW_MASK(1), palette_off}};
+    uint32_t redraws = 0;
+    uint32_t pushes = 0;
+    game.init();
+    animator.start(LAYER_FINISH, finish_sweep, finish_sweep_len, true, 0);
+    for (uint32_t now = 0; now < seconds * 1000; now += 10)
+    {
+        bool redraw = animator.tick(now);
+        if (now % 2000 == 0)
+        {
+            animator.start(LAYER_HINT, hint, 1, false, now);
+            redraw = true;
+        }
+        if (now % 3000 == 0)
+        {
+            // toggles the switch back and forth, every other move restores the board
+            game.toggle_switch(1);
+            redraw = true;
+        }
+        if (redraw == true)
+        {
+            Board frame;
+            animator.compose(game.maze, frame);
+            renderer.render(frame);
+            redraws++;
+            if (renderer.dirty() == true)
+            {
+                renderer.take_words();
+                pushes++;
+            }
+        }
+    }
+    printf("%u s: %.2f redraws/s, %.2f pushes/s (%u of %u redraws sent)\n", seconds, (double)redraws / seconds,
+           (double)pushes / seconds, pushes, redraws);
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: checks that the 32-bit-only requantization multiplies
+// (TFLITE_REQUANTIZE_32BIT, CMSIS_NN_USE_REQUANTIZE_32BIT) are bit-exact with
+// the 64-bit ones. Every accumulator in [-2^24, 2^24) is tried against the
+// edge multipliers and a sample of normalized multipliers in [2^30, 2^31),
+// followed by random and edge operands over the full int32 range. Exits with
+// 1 on the first mismatch.
+//
+//   requantcheck [multipliers] [random pairs]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "tensorflow/lite/kernels/internal/common.h"
+#include "arm_nnsupportfunctions.h"
+
+// accumulators of our int8 layers stay well inside +-2^24
+#define REQUANTCHECK_ACC_BITS 24
+
+static bool check(int32_t a, int32_t b)
+{
+    int32_t expected = gemmlowp::SaturatingRoundingDoublingHighMul(a, b);
+    int32_t actual = tflite::SaturatingRoundingDoublingHighMul32(a, b);
+    if (actual != expected)
+    {
+        fprintf(stderr, "tflite mismatch: %d * %d -> %d, expected %d\n", a, b, actual, expected);
+        return false;
+    }
+    // overflows for INT32_MIN * INT32_MIN only, which requantization never sees
+    if (a == b && a == std::numeric_limits<int32_t>::min())
+    {
+        return true;
+    }
+    expected = arm_nn_doubling_high_mult_no_sat(a, b);
+    actual = arm_nn_doubling_high_mult_no_sat_32x32(a, b);
+    if (actual != expected)
+    {
+        fprintf(stderr, "cmsis-nn mismatch: %d * %d -> %d, expected %d\n", a, b, actual, expected);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int num_multipliers = argc > 1 ? atoi(argv[1]) : 16;
+    long num_pairs = argc > 2 ? atol(argv[2]) : 100000000;
+
+    std::mt19937 rng(0x5EED);
+    std::uniform_int_distribution<int32_t> any;
+    std::uniform_int_distribution<int32_t> normalized(1 << 30, std::numeric_limits<int32_t>::max());
+
+    std::vector<int32_t> multipliers = {0, 1, 1 << 30, (1 << 30) + 1, std::numeric_limits<int32_t>::max()};
+    for (int i = 0; i < num_multipliers; i++)
+    {
+        multipliers.push_back(normalized(rng));
+    }
+
+    const int32_t acc_limit = 1 << REQUANTCHECK_ACC_BITS;
+    for (int32_t multiplier : multipliers)
+    {
+        for (int32_t x = -acc_limit; x < acc_limit; x++)
+        {
+            if (!check(x, multiplier))
+            {
+                return 1;
+            }
+        }
+    }
+    printf("%zu multipliers x 2^%d accumulators: ok\n", multipliers.size(), REQUANTCHECK_ACC_BITS + 1);
+
+    std::vector<int32_t> edges = {std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max(), 0, 1, -1};
+    for (int bit = 1; bit < 31; bit++)
+    {
+        edges.push_back(1 << bit);
+        edges.push_back((1 << bit) - 1);
+        edges.push_back(-(1 << bit));
+        edges.push_back(-(1 << bit) + 1);
+    }
+    for (int32_t a : edges)
+    {
+        for (int32_t b : edges)
+        {
+            if (!check(a, b))
+            {
+                return 1;
+            }
+        }
+    }
+    for (long i = 0; i < num_pairs; i++)
+    {
+        if (!check(any(rng), any(rng)))
+        {
+            return 1;
+        }
+    }
+    printf("%zu edge operands, %ld random pairs: ok\n", edges.size(), num_pairs);
+    return 0;
+}
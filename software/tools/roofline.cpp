@@ -0,0 +1,95 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: scores random boards with the per-operator cost table on and
+// writes the roofline table as CSV: MACs and bytes each operator moves,
+// derived from the tensor shapes, against the cycles its kernel took per
+// Invoke(). Host ticks are microseconds, so the cycles are those of a core at
+// the given clock; the ratios are the shape of the profile, the absolute
+// numbers of the device come from a ROOFLINE_REPORT firmware build.
+//
+//   roofline <output.csv> [boards] [clock MHz]
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "game.h"
+#include "inference.h"
+#include "model_data.h"
+#include "tensorflow/lite/micro/micro_op_cost.h"
+
+#define ROOFLINE_ARENA_SIZE (32 * 1024)
+#define ROOFLINE_MAX_OPS 64
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: roofline <output.csv> [boards] [clock MHz]\n");
+        return 1;
+    }
+    uint32_t num_boards = argc > 2 ? atoi(argv[2]) : 20000;
+    uint32_t clock_mhz = argc > 3 ? atoi(argv[3]) : 133;
+
+    alignas(16) static uint8_t arena[ROOFLINE_ARENA_SIZE];
+    static tflite::MicroOpCost costs[ROOFLINE_MAX_OPS];
+    Inference inference = Inference(COLORDOT_MODEL, arena, sizeof(arena));
+    inference.set_op_costs(costs, ROOFLINE_MAX_OPS);
+    if (inference.init() == false)
+    {
+        return 1;
+    }
+
+    Game game = Game();
+    int8_t scores[NUM_SWITCHES];
+    for (uint32_t b = 0; b < num_boards; b++)
+    {
+        game.init();
+        for (uint8_t m = 0; m < 20; m++)
+        {
+            game.toggle_switch(rand() % NUM_SWITCHES);
+        }
+        if (inference.score_board(game.maze, scores) == false)
+        {
+            return 1;
+        }
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (out == nullptr)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+    fprintf(out, "%s\n", tflite::MicroOpCostCsvHeader());
+    uint64_t total_cycles = 0;
+    uint32_t total_macs = 0;
+    for (uint32_t i = 0; i < ROOFLINE_MAX_OPS && costs[i].name != nullptr; i++)
+    {
+        char row[160];
+        tflite::FormatMicroOpCostCsv(costs[i], i, clock_mhz, row, sizeof(row));
+        fprintf(out, "%s\n", row);
+        total_cycles += (uint64_t)costs[i].ticks * clock_mhz / costs[i].invokes;
+        total_macs += costs[i].macs;
+    }
+    fclose(out);
+    printf("%u boards: %u MACs and %llu cycles at %u MHz per inference\n", num_boards, total_macs,
+           (unsigned long long)total_cycles, clock_mhz);
+    return 0;
+}
@@ -0,0 +1,503 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: plays a scripted game session on a virtual clock through two
+// run loops and reports their event latencies and an energy estimate.
+//
+//   polling  the previous loop: fixed 125 MHz, switches handled in the
+//            scanner interrupt, everything else on a 10 ms poll
+//   events   EventQueue and Governor as in main.cpp: WFE while idle, the
+//            inference runs one operator per event at the boost clock
+//
+// The handler costs and the power model are rough RP2040 figures, only the
+// comparison between the loops is meaningful.
+//
+//   schedsim [seconds] [inference Mcycles]
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "animation.h"
+#include "scheduler.h"
+
+#define POLL_CLOCK_KHZ 125000
+#define IDLE_CLOCK_KHZ 48000
+#define BOOST_CLOCK_KHZ 133000
+#define POLL_PERIOD_US 10000
+#define SCAN_PERIOD_US 1000
+
+// cycles of the run loop parts, the LED push waits on the PIO FIFO
+#define SCAN_CYCLES 150
+#define POST_CYCLES 60
+#define LOOP_CYCLES 400
+#define HANDLER_CYCLES 6000
+#define INFERENCE_OPS 12
+#define LED_PUSH_US 720
+#define CLOCK_SWITCH_US 150
+
+// supply current in mA, linear in the clock
+static double active_ma(uint32_t khz)
+{
+    return 1.0 + 0.16 * khz / 1000.0;
+}
+
+static double sleep_ma(uint32_t khz)
+{
+    return 0.8 + 0.04 * khz / 1000.0;
+}
+
+struct Stimulus
+{
+    uint64_t at_us;
+    uint8_t type;
+    uint8_t arg;
+};
+
+struct Latency
+{
+    std::vector<double> ms;
+
+    void add(uint64_t from_us, uint64_t to_us)
+    {
+        ms.push_back((to_us - from_us) / 1000.0);
+    }
+
+    void print(const char *name)
+    {
+        if (ms.empty())
+        {
+            printf("  %-10s -\n", name);
+            return;
+        }
+        std::sort(ms.begin(), ms.end());
+        double sum = 0;
+        for (double v : ms)
+        {
+            sum += v;
+        }
+        printf("  %-10s mean %7.2f ms  p95 %7.2f ms  max %7.2f ms  (%zu)\n", name, sum / ms.size(),
+               ms[ms.size() * 95 / 100], ms.back(), ms.size());
+    }
+};
+
+// a player who moves every few seconds and asks for a hint now and then
+static std::vector<Stimulus> script(uint32_t seconds)
+{
+    std::mt19937 rng(1);
+    std::exponential_distribution<double> move_gap(1.0 / 3.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<Stimulus> stimuli;
+    uint64_t end_us = (uint64_t)seconds * 1000000;
+
+    // new game, the button is held for 300 ms
+    stimuli.push_back({1000000, EVENT_BUTTON_DOWN, 0});
+    stimuli.push_back({1300000, EVENT_BUTTON_UP, 0});
+    double t = 2.0;
+    while (true)
+    {
+        t += 0.2 + move_gap(rng);
+        if (t * 1e6 >= end_us)
+        {
+            break;
+        }
+        stimuli.push_back({(uint64_t)(t * 1e6), EVENT_SWITCH, (uint8_t)(rng() % 8)});
+        if (unit(rng) < 0.25)
+        {
+            // hint shortly after the move, sometimes while it is still scored
+            uint64_t release = (uint64_t)(t * 1e6) + (uint64_t)(unit(rng) * 60000);
+            stimuli.push_back({release - 150000, EVENT_BUTTON_DOWN, 0});
+            stimuli.push_back({release, EVENT_BUTTON_UP, 0});
+        }
+    }
+    std::sort(stimuli.begin(), stimuli.end(), [](const Stimulus &a, const Stimulus &b)
+              { return a.at_us < b.at_us; });
+    return stimuli;
+}
+
+static uint32_t sim_khz = POLL_CLOCK_KHZ;
+
+static void sim_set_clock(uint32_t khz)
+{
+    sim_khz = khz;
+}
+
+// virtual core: time, energy and the interrupts that arrive while it runs
+class Sim
+{
+public:
+    Sim(const std::vector<Stimulus> &stimuli, uint64_t end_us) : stimuli(stimuli), end_us(end_us) {}
+    virtual ~Sim() {}
+
+    uint64_t now_us = 0;
+    double energy_uj = 0;
+    uint32_t wakeups = 0;
+    Latency move, hint, inference;
+
+    // the core executes for duration_us, interrupts in between run first
+    void busy_us(double duration_us)
+    {
+        double end = this->now_us + duration_us;
+        while ((this->next < this->stimuli.size()) && (this->stimuli[this->next].at_us < end))
+        {
+            const Stimulus &stimulus = this->stimuli[this->next++];
+            double part = std::max<double>(0, (double)stimulus.at_us - this->now_us);
+            this->account(part, true);
+            this->now_us = std::max(this->now_us, stimulus.at_us);
+            uint64_t before = this->now_us;
+            this->interrupt(stimulus);
+            end += this->now_us - before;
+        }
+        this->account(end - this->now_us, true);
+        this->now_us = (uint64_t)end;
+    }
+
+    void run(uint64_t cycles)
+    {
+        this->busy_us(cycles * 1000.0 / sim_khz);
+    }
+
+    // WFE until wake_us, interrupts in between run and end the sleep if
+    // wake_on_interrupt, the scanner ticks cost a few cycles each
+    void sleep_until(uint64_t wake_us, bool wake_on_interrupt)
+    {
+        wake_us = std::min(wake_us, this->end_us);
+        while (true)
+        {
+            bool pending = (this->next < this->stimuli.size()) && (this->stimuli[this->next].at_us < wake_us);
+            uint64_t until = pending ? std::max(this->now_us, this->stimuli[this->next].at_us) : wake_us;
+            if (until > this->now_us)
+            {
+                uint64_t scans = until / SCAN_PERIOD_US - this->now_us / SCAN_PERIOD_US;
+                double scan_us = SCAN_CYCLES * 1000.0 / sim_khz;
+                this->account(until - this->now_us, false);
+                this->energy_uj += scans * scan_us * 3.3 * (active_ma(sim_khz) - sleep_ma(sim_khz)) / 1000.0;
+                this->now_us = until;
+            }
+            if (pending == false)
+            {
+                break;
+            }
+            this->interrupt(this->stimuli[this->next++]);
+            if (wake_on_interrupt == true)
+            {
+                break;
+            }
+        }
+        this->wakeups++;
+    }
+
+    bool done()
+    {
+        return this->now_us >= this->end_us;
+    }
+
+    virtual void interrupt(const Stimulus &stimulus) = 0;
+
+private:
+    const std::vector<Stimulus> &stimuli;
+    uint64_t end_us;
+    size_t next = 0;
+
+    void account(double duration_us, bool active)
+    {
+        double ma = active ? active_ma(sim_khz) : sleep_ma(sim_khz);
+        this->energy_uj += duration_us * 3.3 * ma / 1000.0;
+    }
+};
+
+// previous main loop, inference in one piece per poll
+class PollingLoop : public Sim
+{
+public:
+    PollingLoop(const std::vector<Stimulus> &stimuli, uint64_t end_us, uint64_t inference_cycles)
+        : Sim(stimuli, end_us), inference_cycles(inference_cycles) {}
+
+    void interrupt(const Stimulus &stimulus) override
+    {
+        this->run(SCAN_CYCLES);
+        if (stimulus.type == EVENT_SWITCH)
+        {
+            // board and LEDs are updated in the interrupt
+            this->run(HANDLER_CYCLES);
+            this->busy_us(LED_PUSH_US);
+            this->move.add(stimulus.at_us, this->now_us);
+            this->state_changed = true;
+            this->moved_us = stimulus.at_us;
+        }
+        else if (stimulus.type == EVENT_BUTTON_UP)
+        {
+            if (this->started == false)
+            {
+                this->need_to_initialize = true;
+            }
+            else
+            {
+                this->display_hint = true;
+                this->hint_us = stimulus.at_us;
+            }
+        }
+    }
+
+    void play()
+    {
+        sim_khz = POLL_CLOCK_KHZ;
+        this->state_changed = true;
+        while (this->done() == false)
+        {
+            this->run(LOOP_CYCLES);
+            if (this->need_to_initialize == true)
+            {
+                this->run(HANDLER_CYCLES);
+                this->busy_us(LED_PUSH_US);
+                this->need_to_initialize = false;
+                this->started = true;
+                this->state_changed = true;
+                this->moved_us = this->now_us;
+            }
+            if (this->state_changed == true)
+            {
+                this->state_changed = false;
+                uint64_t moved_us = this->moved_us;
+                this->run(this->inference_cycles);
+                this->inference.add(moved_us, this->now_us);
+            }
+            if (this->display_hint == true)
+            {
+                this->display_hint = false;
+                this->animator.start(LAYER_HINT, finish_sweep, 1, false, this->now_us / 1000);
+                this->run(HANDLER_CYCLES);
+                this->busy_us(LED_PUSH_US);
+                this->hint.add(this->hint_us, this->now_us);
+            }
+            if (this->animator.tick(this->now_us / 1000) == true)
+            {
+                this->run(HANDLER_CYCLES);
+                this->busy_us(LED_PUSH_US);
+            }
+            this->sleep_until(this->now_us + POLL_PERIOD_US, false);
+        }
+    }
+
+private:
+    uint64_t inference_cycles;
+    Animator animator;
+    bool started = false;
+    bool need_to_initialize = false;
+    bool state_changed = false;
+    bool display_hint = false;
+    uint64_t moved_us = 0;
+    uint64_t hint_us = 0;
+};
+
+// event driven loop of main.cpp
+class EventLoop : public Sim
+{
+public:
+    EventLoop(const std::vector<Stimulus> &stimuli, uint64_t end_us, uint64_t inference_cycles)
+        : Sim(stimuli, end_us), inference_cycles(inference_cycles),
+          governor(IDLE_CLOCK_KHZ, BOOST_CLOCK_KHZ, &sim_set_clock) {}
+
+    void interrupt(const Stimulus &stimulus) override
+    {
+        this->run(SCAN_CYCLES + POST_CYCLES);
+        this->events.post({stimulus.type, stimulus.arg, (uint32_t)stimulus.at_us});
+    }
+
+    void play()
+    {
+        this->governor.start();
+        this->request_inference(0);
+        Event event;
+        while (this->done() == false)
+        {
+            if (this->events.pop(event) == false)
+            {
+                this->run(LOOP_CYCLES);
+                uint32_t now = this->now_us / 1000;
+                if (this->animator.tick(now) == true)
+                {
+                    this->redraw();
+                }
+                uint32_t change_ms;
+                uint64_t wake_us = UINT64_MAX;
+                if (this->animator.next_change(now, change_ms) == true)
+                {
+                    wake_us = std::min(wake_us, this->now_us + (uint64_t)(change_ms - now) * 1000);
+                }
+                this->sleep_until(wake_us, true);
+                continue;
+            }
+
+            this->run(HANDLER_CYCLES / 4);
+            switch (event.type)
+            {
+            case EVENT_SWITCH:
+                this->redraw();
+                this->move.add(event.data, this->now_us);
+                this->request_inference(event.data);
+                break;
+
+            case EVENT_BUTTON_UP:
+                if (this->started == false)
+                {
+                    this->started = true;
+                    this->redraw();
+                    this->request_inference(this->now_us);
+                }
+                else if (this->hint_ready == true)
+                {
+                    this->show_hint(event.data);
+                }
+                else
+                {
+                    this->hint_pending = true;
+                    this->hint_us = event.data;
+                }
+                break;
+
+            case EVENT_INFERENCE:
+                this->inference_queued = false;
+                if (this->inference_stale == true)
+                {
+                    this->inference_stale = false;
+                    this->boost();
+                    this->ops_left = INFERENCE_OPS;
+                }
+                this->run(this->inference_cycles / INFERENCE_OPS);
+                this->ops_left--;
+                if (this->ops_left == 0)
+                {
+                    this->hint_ready = true;
+                    this->inference.add(this->moved_us, this->now_us);
+                    if (this->hint_pending == true)
+                    {
+                        this->hint_pending = false;
+                        this->show_hint(this->hint_us);
+                    }
+                    this->relax();
+                }
+                else
+                {
+                    this->events.post({EVENT_INFERENCE, 0, (uint32_t)this->now_us});
+                    this->inference_queued = true;
+                }
+                break;
+            }
+        }
+    }
+
+    uint64_t boosted_us()
+    {
+        return this->governor.boosted_us(this->now_us);
+    }
+
+    uint32_t clock_switches()
+    {
+        return this->governor.switches();
+    }
+
+private:
+    uint64_t inference_cycles;
+    EventQueue events;
+    Governor governor;
+    Animator animator;
+    bool started = false;
+    bool inference_queued = false;
+    bool inference_stale = false;
+    bool hint_ready = false;
+    bool hint_pending = false;
+    uint32_t ops_left = 0;
+    uint64_t moved_us = 0;
+    uint64_t hint_us = 0;
+
+    void redraw()
+    {
+        this->run(HANDLER_CYCLES);
+        this->busy_us(LED_PUSH_US);
+    }
+
+    void show_hint(uint64_t pressed_us)
+    {
+        this->animator.start(LAYER_HINT, finish_sweep, 1, false, this->now_us / 1000);
+        this->redraw();
+        this->hint.add(pressed_us, this->now_us);
+    }
+
+    void request_inference(uint64_t moved_us)
+    {
+        // a stale run restarts, its latency counts from the latest move
+        this->moved_us = moved_us;
+        this->inference_stale = true;
+        this->hint_ready = false;
+        if (this->inference_queued == false)
+        {
+            this->events.post({EVENT_INFERENCE, 0, (uint32_t)this->now_us});
+            this->inference_queued = true;
+        }
+    }
+
+    void boost()
+    {
+        if (this->governor.boosted() == false)
+        {
+            this->governor.boost(this->now_us);
+            this->busy_us(CLOCK_SWITCH_US);
+        }
+    }
+
+    void relax()
+    {
+        this->governor.relax(this->now_us);
+        this->busy_us(CLOCK_SWITCH_US);
+    }
+};
+
+static void report(const char *name, Sim &sim, uint32_t seconds)
+{
+    printf("%s: %.3f mA average, %.1f mJ, %.1f loop wakeups/s\n", name, sim.energy_uj / 3.3 / (seconds * 1000.0),
+           sim.energy_uj / 1000.0, (double)sim.wakeups / seconds);
+    sim.move.print("move");
+    sim.hint.print("hint");
+    sim.inference.print("inference");
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t seconds = argc > 1 ? atoi(argv[1]) : 600;
+    double inference_mcycles = argc > 2 ? atof(argv[2]) : 4.0;
+    uint64_t inference_cycles = (uint64_t)(inference_mcycles * 1e6);
+    uint64_t end_us = (uint64_t)seconds * 1000000;
+
+    std::vector<Stimulus> stimuli = script(seconds);
+    printf("%u s, %zu input edges, %.1f Mcycles per inference\n", seconds, stimuli.size(), inference_mcycles);
+
+    PollingLoop polling(stimuli, end_us, inference_cycles);
+    polling.play();
+    report("polling", polling, seconds);
+
+    EventLoop events(stimuli, end_us, inference_cycles);
+    events.play();
+    report("events", events, seconds);
+    printf("  boost %.2f %% of the time, %u clock switches\n", 100.0 * events.boosted_us() / end_us,
+           events.clock_switches());
+    return 0;
+}
@@ -0,0 +1,99 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: shuffles boards of every difficulty level like the firmware and
+// runs the exact search on each until it is solved or the deadline passed,
+// in slices of nodes as in the run loop. Reports per level the deadline hit
+// rate, the mean optimal moves of the solved boards, the nodes per board and
+// the nodes per second. The search time up to the network hint (the solver's
+// slices ahead of the inference slices) splits the solved boards into those
+// answered before the network and those whose network hint the exact move
+// replaces. Both times are host time, scale them by the nodes per second of
+// the device.
+//
+//   solvebench [boards per level] [deadline ms] [hint ms]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "game.h"
+#include "hint_cache.h"
+#include "solver.h"
+
+#define NUM_LEVELS 8
+#define SOLVEBENCH_SLICE_NODES 32
+
+int main(int argc, char **argv)
+{
+    uint32_t num_boards = argc > 1 ? atoi(argv[1]) : 200;
+    double deadline_ms = argc > 2 ? atof(argv[2]) : 250.0;
+    double hint_ms = argc > 3 ? atof(argv[3]) : 25.0;
+
+    HintCache cache = HintCache(hint_cache_table);
+    Solver solver = Solver(cache);
+    Game game = Game();
+    printf("level  boards  in time  before hint  replaced  gave up  mean moves  nodes/board  median ms  nodes/s\n");
+    for (uint8_t level = 0; level < NUM_LEVELS; level++)
+    {
+        uint32_t solved = 0;
+        uint32_t before_hint = 0;
+        uint32_t gave_up = 0;
+        uint64_t moves = 0;
+        uint64_t nodes = 0;
+        double seconds = 0;
+        std::vector<double> times;
+        for (uint32_t b = 0; b < num_boards; b++)
+        {
+            uint8_t switch_state[8];
+            for (uint8_t sw = 0; sw < 8; sw++)
+            {
+                switch_state[sw] = (b >> sw) & 1;
+            }
+            game.shuffle_dots(level, 1 + b * NUM_LEVELS + level, switch_state);
+
+            auto start = std::chrono::steady_clock::now();
+            double elapsed_ms = 0;
+            solver.start(game.maze);
+            while ((solver.status() == SOLVER_SEARCHING) && (elapsed_ms < deadline_ms))
+            {
+                solver.search(SOLVEBENCH_SLICE_NODES);
+                elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+            seconds += elapsed_ms / 1e3;
+            nodes += solver.nodes();
+            times.push_back(elapsed_ms);
+            if (solver.status() == SOLVER_SOLVED)
+            {
+                solved++;
+                before_hint += elapsed_ms < hint_ms;
+                moves += solver.distance();
+            }
+            gave_up += solver.status() == SOLVER_GAVE_UP;
+        }
+        std::sort(times.begin(), times.end());
+        printf("%5u  %6u  %6.1f%%  %10.1f%%  %7.1f%%  %7u  %10.2f  %11.0f  %9.3f  %7.0f\n", level, num_boards,
+               100.0 * solved / num_boards, 100.0 * before_hint / num_boards,
+               100.0 * (solved - before_hint) / num_boards, gave_up, solved > 0 ? (double)moves / solved : 0.0, (double)nodes / num_boards, times[num_boards / 2],
+               seconds > 0 ? nodes / seconds : 0.0);
+    }
+    return 0;
+}
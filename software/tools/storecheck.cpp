@@ -0,0 +1,329 @@
+/* NEURODOTS
+ * Copyright (C) 2024 ki-manufaktur.de
+ *
+ * This file is part of <your project name>.
+ *
+ * <Your project name> is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Host tool: runs the settings and statistics store on a RAM flash. Checks
+// that values survive a remount, replays many games to count the sector
+// erases against the single-page format, and cuts the power after every
+// programmed byte of a rollover to check that a remount finds either the
+// old or the new value of every key. Then installs models into the model
+// store: A/B selection per role, fallback after a rejected model, slot reuse,
+// and a power cut after every programmed byte of an install, which has to
+// leave either the previous or the new model active. Exits with 1 if any
+// check fails.
+//
+//   storecheck [games]
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "model_store.h"
+#include "ram_flash.h"
+#include "store.h"
+
+// pages of the single-page format per erase
+#define LEGACY_PAGES_PER_ERASE 16
+
+static int failures = 0;
+
+static void expect(const char *what, uint32_t actual, uint32_t expected)
+{
+    if (actual != expected)
+    {
+        fprintf(stderr, "%s: %u, expected %u\n", what, actual, expected);
+        failures++;
+    }
+}
+
+// value written for key in step i, 20 bytes for the statistics
+struct Value
+{
+    uint32_t words[5];
+};
+
+static Value value_of(uint8_t key, uint32_t i)
+{
+    Value value = {{i, key, i * 3, i * 5, i * 7}};
+    return value;
+}
+
+static uint32_t read_step(KvStore &store, uint8_t key)
+{
+    Value value;
+    if (store.get(key, &value, sizeof(value)) == false)
+    {
+        return UINT32_MAX;
+    }
+    return value.words[0];
+}
+
+static uint32_t most_erases(RamFlash &flash)
+{
+    uint32_t most = 0;
+    for (uint8_t sector = 0; sector < STORE_SECTORS; sector++)
+    {
+        most = flash.erases[sector] > most ? flash.erases[sector] : most;
+    }
+    return most;
+}
+
+// stand-in blob, version v differs in every byte
+static std::vector<uint8_t> blob_of(uint32_t version, size_t len)
+{
+    std::vector<uint8_t> blob(len);
+    for (size_t i = 0; i < len; i++)
+    {
+        blob[i] = (uint8_t)(i * 31 + version * 7 + (i >> 8));
+    }
+    return blob;
+}
+
+static int32_t active_version(ModelStore &models, uint8_t role)
+{
+    int8_t slot = models.select(role);
+    return slot < 0 ? -1 : (int32_t)models.header(slot)->version;
+}
+
+static void check_model_store()
+{
+    const size_t len = 15000;
+    RamFlash flash(MODEL_STORE_BYTES / STORE_SECTOR_SIZE);
+    ModelStore models(flash);
+    expect("usable slots of erased flash", models.mount(), 0);
+    expect("active model of erased flash", active_version(models, MODEL_ROLE_HINT), (uint32_t)-1);
+
+    // A/B: the newest is active, the model read in place
+    std::vector<uint8_t> v1 = blob_of(1, len);
+    std::vector<uint8_t> v2 = blob_of(2, len);
+    models.install(MODEL_ROLE_HINT, 1, v1.data(), len, "colordot");
+    int8_t slot = models.install(MODEL_ROLE_HINT, 2, v2.data(), len, "colordot");
+    expect("active after two installs", active_version(models, MODEL_ROLE_HINT), 2);
+    expect("model in place", models.model(slot) == flash.data(slot * MODEL_SLOT_SIZE + MODEL_HEADER_BYTES), 1);
+    expect("model bytes", memcmp(models.model(slot), v2.data(), len), 0);
+    expect("blob CRC", models.verify(slot), 1);
+    ModelStore again(flash);
+    expect("usable slots after remount", again.mount(), 2);
+    expect("active after remount", active_version(again, MODEL_ROLE_HINT), 2);
+
+    // a skipped model only falls back for that select()
+    expect("active with the newest skipped", again.header(again.select(MODEL_ROLE_HINT, 1u << slot))->version, 1);
+    expect("active after skipping", active_version(again, MODEL_ROLE_HINT), 2);
+
+    // a rejected model falls back to the one before, also after a remount
+    again.reject(slot);
+    expect("active after reject", active_version(again, MODEL_ROLE_HINT), 1);
+    ModelStore third(flash);
+    third.mount();
+    expect("active after reject and remount", active_version(third, MODEL_ROLE_HINT), 1);
+    expect("newest version counts the rejected one", third.newest_version(MODEL_ROLE_HINT), 2);
+
+    // installs of two roles never overwrite an active model
+    std::vector<uint8_t> small = blob_of(100, len / 4);
+    third.install(MODEL_ROLE_SMALL, 1, small.data(), small.size(), "colordot_small");
+    for (uint32_t version = 3; version < 12; version++)
+    {
+        std::vector<uint8_t> blob = blob_of(version, len);
+        if (third.install(MODEL_ROLE_HINT, version, blob.data(), len) < 0)
+        {
+            fprintf(stderr, "install of version %u: no slot\n", version);
+            failures++;
+        }
+        expect("active hint model", active_version(third, MODEL_ROLE_HINT), version);
+        expect("active small model", active_version(third, MODEL_ROLE_SMALL), 1);
+    }
+    expect("too large a model", third.install(MODEL_ROLE_HINT, 20, v1.data(), MODEL_MAX_BYTES + 1), (uint32_t)-1);
+
+    // mount checks the headers only, a damaged blob shows in verify()
+    slot = third.select(MODEL_ROLE_HINT);
+    flash.memory[slot * MODEL_SLOT_SIZE + MODEL_HEADER_BYTES + 100] ^= 0x10;
+    ModelStore fourth(flash);
+    fourth.mount();
+    expect("damaged blob mounted", active_version(fourth, MODEL_ROLE_HINT), 11);
+    expect("damaged blob verified", fourth.verify(slot), 0);
+
+    // power loss at every byte of an install
+    uint32_t cuts = 0;
+    const size_t cut_len = 2000;
+    std::vector<uint8_t> old_blob = blob_of(1, cut_len);
+    std::vector<uint8_t> new_blob = blob_of(2, cut_len);
+    for (uint32_t cut = 1;; cut++)
+    {
+        RamFlash cut_flash(MODEL_STORE_BYTES / STORE_SECTOR_SIZE);
+        ModelStore store(cut_flash);
+        store.mount();
+        store.install(MODEL_ROLE_HINT, 1, old_blob.data(), cut_len);
+        cut_flash.power_fails_after = cut;
+        store.install(MODEL_ROLE_HINT, 2, new_blob.data(), cut_len);
+        if (cut_flash.powered() == true)
+        {
+            break;
+        }
+        cuts++;
+        cut_flash.power_fails_after = -1;
+
+        ModelStore after(cut_flash);
+        after.mount();
+        int8_t active = after.select(MODEL_ROLE_HINT);
+        int32_t version = active_version(after, MODEL_ROLE_HINT);
+        if (((version != 1) && (version != 2)) || (after.verify(active) == false))
+        {
+            fprintf(stderr, "install cut after %u bytes: version %d active\n", cut, version);
+            failures++;
+        }
+    }
+    printf("model store: %u power cuts during an install recovered\n", cuts);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t games = argc > 1 ? atoi(argv[1]) : 10000;
+
+    // settings survive a remount
+    {
+        RamFlash flash;
+        KvStore store(flash);
+        expect("mount of erased flash", store.mount(), false);
+        store.format();
+        uint8_t brightness = 32;
+        uint8_t difficulty = 3;
+        store.put(KEY_BRIGHTNESS, &brightness, 1);
+        store.put(KEY_DIFFICULTY, &difficulty, 1);
+        uint32_t programmed = flash.programmed_bytes;
+        store.put(KEY_DIFFICULTY, &difficulty, 1);
+        expect("bytes for an unchanged value", flash.programmed_bytes - programmed, 0);
+
+        KvStore again(flash);
+        brightness = difficulty = 0;
+        expect("remount", again.mount(), true);
+        again.get(KEY_BRIGHTNESS, &brightness, 1);
+        again.get(KEY_DIFFICULTY, &difficulty, 1);
+        expect("brightness", brightness, 32);
+        expect("difficulty", difficulty, 3);
+    }
+
+    // wear: two records per game, a setting changes every 200 games
+    {
+        RamFlash flash;
+        KvStore store(flash);
+        store.format();
+        uint32_t settings_writes = 0;
+        for (uint32_t game = 0; game < games; game++)
+        {
+            uint8_t last_game[8] = {(uint8_t)game, (uint8_t)(game >> 8), 0, 0, 12, 0, 10, 0};
+            Value stats = value_of(KEY_STATS, game);
+            store.put(KEY_LAST_GAME, last_game, sizeof(last_game));
+            store.put(KEY_STATS, &stats, sizeof(stats));
+            if (game % 200 == 0)
+            {
+                uint8_t brightness = 1 << (game / 200 % 8);
+                store.put(KEY_BRIGHTNESS, &brightness, 1);
+                settings_writes++;
+            }
+            store.maintain();
+        }
+        KvStore again(flash);
+        expect("remount after games", again.mount(), true);
+        expect("statistics after games", read_step(again, KEY_STATS), games - 1);
+
+        // the single-page format writes a page per change and erases its one sector every 16
+        uint32_t legacy = (games + settings_writes + LEGACY_PAGES_PER_ERASE - 1) / LEGACY_PAGES_PER_ERASE;
+        printf("%u games, %u setting changes: at most %u erases per sector, single-page format %u\n", games,
+               settings_writes, most_erases(flash), legacy);
+    }
+
+    // settings only, one change per step
+    {
+        RamFlash flash;
+        KvStore store(flash);
+        store.format();
+        for (uint32_t change = 0; change < games; change++)
+        {
+            uint8_t brightness = 1 << (change % 8);
+            store.put(KEY_BRIGHTNESS, &brightness, 1);
+            store.maintain();
+        }
+        uint32_t legacy = (games + LEGACY_PAGES_PER_ERASE - 1) / LEGACY_PAGES_PER_ERASE;
+        printf("%u setting changes: at most %u erases per sector, single-page format %u\n", games,
+               most_erases(flash), legacy);
+    }
+
+    // power loss at every byte of a sequence of puts that rolls over twice
+    uint32_t cuts = 0;
+    for (uint32_t cut = 1;; cut++)
+    {
+        RamFlash flash;
+        KvStore store(flash);
+        store.format();
+        uint32_t step = 0;
+        while (store.free_bytes() > 64)
+        {
+            Value value = value_of(KEY_STATS, step++);
+            store.put(KEY_STATS, &value, sizeof(value));
+        }
+        uint32_t completed = step - 1;
+        flash.power_fails_after = cut;
+        uint32_t target = step + 400;
+        for (; (step < target) && (flash.powered() == true); step++)
+        {
+            Value value = value_of(KEY_STATS, step);
+            store.put(KEY_STATS, &value, sizeof(value));
+            if (flash.powered() == true)
+            {
+                completed = step;
+            }
+        }
+        if (flash.powered() == true)
+        {
+            break;
+        }
+        cuts++;
+        flash.power_fails_after = -1;
+
+        KvStore again(flash);
+        if (again.mount() == false)
+        {
+            fprintf(stderr, "cut after %u bytes: no committed sector\n", cut);
+            failures++;
+            continue;
+        }
+        uint32_t found = read_step(again, KEY_STATS);
+        if ((found != completed) && (found != completed + 1))
+        {
+            fprintf(stderr, "cut after %u bytes: step %u, expected %u or %u\n", cut, found, completed, completed + 1);
+            failures++;
+        }
+        // the store keeps working after the recovery
+        Value value = value_of(KEY_STATS, 1000000);
+        again.put(KEY_STATS, &value, sizeof(value));
+        KvStore third(flash);
+        third.mount();
+        expect("put after recovery", read_step(third, KEY_STATS), 1000000);
+    }
+    printf("%u power cuts recovered\n", cuts);
+
+    check_model_store();
+
+    if (failures > 0)
+    {
+        return 1;
+    }
+    printf("store ok\n");
+    return 0;
+}